@@ -110,7 +110,7 @@ DtlsTransport::DtlsTransport(MediaType med, const std::string &transport_name, c
     if (iceConfig_.use_nicer) {
       ice_ = NicerConnection::create(io_worker_, iceConfig_);
     } else {
-      ice_.reset(LibNiceConnection::create(iceConfig_));
+      ice_.reset(LibNiceConnection::create(io_worker_, iceConfig_));
     }
     rtp_timeout_checker_.reset(new TimeoutChecker(this, dtlsRtp.get()));
     if (!rtcp_mux) {
@@ -174,8 +174,10 @@ void DtlsTransport::onIceData(packetPtr packet) {
     }
     return;
   } else if (this->getTransportState() == TRANSPORT_READY) {
-    std::shared_ptr<DataPacket> unprotect_packet = std::make_shared<DataPacket>(component_id,
-      data, len, VIDEO_PACKET, packet->received_time_ms);
+    // Packets coming from ICE are not referenced anywhere else, so we unprotect them in place
+    std::shared_ptr<DataPacket> unprotect_packet = std::move(packet);
+    unprotect_packet->type = VIDEO_PACKET;
+    unprotect_packet->makeWritable();
 
     if (dtlsRtcp != NULL && component_id == 2) {
       srtp = srtcp_.get();
@@ -210,17 +212,23 @@ void DtlsTransport::onCandidate(const CandidateInfo &candidate, IceConnection *c
   }
 }
 
-void DtlsTransport::write(char* data, int len) {
+void DtlsTransport::write(std::shared_ptr<DataPacket> packet) {
   if (ice_ == nullptr || !running_) {
     return;
   }
-  int length = len;
   SrtpChannel *srtp = srtp_.get();
 
   if (this->getTransportState() == TRANSPORT_READY) {
-    memcpy(protectBuf_, data, len);
+    // Packets nobody else references (i.e. most RTCP) are protected in place. RTP packets are still kept
+    // unprotected by the retransmission buffer, so media is copied once per packet into a pooled buffer.
+    std::shared_ptr<DataPacket> protect_packet = packet.use_count() == 1 ? std::move(packet) : packet->share();
+    protect_packet->makeWritable();
+    if (protect_packet->tailroom() < SrtpChannel::kMaxTrailerLength) {
+      ELOG_DEBUG("%s message: No room to protect packet, length: %d", toLog(), protect_packet->length);
+      return;
+    }
     int comp = 1;
-    RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(protectBuf_);
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(protect_packet->data);
     if (chead->isRtcp()) {
       if (!rtcp_mux_) {
         comp = 2;
@@ -229,7 +237,7 @@ void DtlsTransport::write(char* data, int len) {
         srtp = srtcp_.get();
       }
       if (srtp && ice_->checkIceState() == IceState::READY) {
-        if (srtp->protectRtcp(protectBuf_, &length) < 0) {
+        if (srtp->protectRtcp(protect_packet->data, &protect_packet->length) < 0) {
           return;
         }
       }
@@ -237,16 +245,16 @@ void DtlsTransport::write(char* data, int len) {
       comp = 1;
 
       if (srtp && ice_->checkIceState() == IceState::READY) {
-        if (srtp->protectRtp(protectBuf_, &length) < 0) {
+        if (srtp->protectRtp(protect_packet->data, &protect_packet->length) < 0) {
           return;
         }
       }
     }
-    if (length <= 10) {
+    if (protect_packet->length <= 10) {
       return;
     }
     if (ice_->checkIceState() == IceState::READY) {
-      writeOnIce(comp, protectBuf_, length);
+      writeOnIce(comp, protect_packet->data, protect_packet->length);
     }
   }
 }
@@ -292,7 +300,7 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   }
   if (ctx == dtlsRtp.get()) {
     srtp_.reset(new SrtpChannel());
-    if (srtp_->setRtpParams(clientKey, serverKey)) {
+    if (srtp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
@@ -303,14 +311,15 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   }
   if (ctx == dtlsRtcp.get()) {
     srtcp_.reset(new SrtpChannel());
-    if (srtcp_->setRtpParams(clientKey, serverKey)) {
+    if (srtcp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtcp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
     }
   }
-  ELOG_DEBUG("%s message:HandShakeCompleted, transportName:%s, readyRtp:%d, readyRtcp:%d",
-             toLog(), transport_name.c_str(), readyRtp, readyRtcp);
+  ELOG_DEBUG("%s message:HandShakeCompleted, transportName:%s, readyRtp:%d, readyRtcp:%d, srtpProfile: %s, "
+             "handshakeTimeMs: %ld", toLog(), transport_name.c_str(), readyRtp, readyRtcp, srtp_profile.c_str(),
+             static_cast<long>(ctx->getHandshakeDuration().count()));  // NOLINT
   if (readyRtp && readyRtcp) {
     updateTransportState(TRANSPORT_READY);
   }
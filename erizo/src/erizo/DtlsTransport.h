@@ -32,7 +32,7 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   void close() override;
   void onIceData(packetPtr packet) override;
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override;
-  void write(char* data, int len) override;
+  void write(std::shared_ptr<DataPacket> packet) override;
   void onDtlsPacket(dtls::DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override;
   void writeDtlsPacket(dtls::DtlsSocketContext *ctx, packetPtr packet);
   void onHandshakeCompleted(dtls::DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
@@ -44,7 +44,6 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   void updateIceStateSync(IceState state, IceConnection *conn);
 
  private:
-  char protectBuf_[5000];
   boost::scoped_ptr<dtls::DtlsSocketContext> dtlsRtp, dtlsRtcp;
   boost::mutex writeMutex_, sessionMutex_;
   boost::scoped_ptr<SrtpChannel> srtp_, srtcp_;
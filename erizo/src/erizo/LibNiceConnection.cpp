@@ -60,9 +60,10 @@ void cb_new_selected_pair(NiceAgent *agent, guint stream_id, guint component_id,
   conn->updateComponentState(component_id, IceState::READY);
 }
 
-LibNiceConnection::LibNiceConnection(boost::shared_ptr<LibNiceInterface> libnice, const IceConfig& ice_config)
-  : IceConnection{ice_config},
-    lib_nice_{libnice}, agent_{NULL}, loop_{NULL}, candsDelivered_{0}, receivedLastCandidate_{false} {
+LibNiceConnection::LibNiceConnection(std::shared_ptr<IOWorker> io_worker,
+                                     boost::shared_ptr<LibNiceInterface> libnice, const IceConfig& ice_config)
+  : IceConnection{ice_config}, io_worker_{io_worker},
+    lib_nice_{libnice}, agent_{NULL}, context_{NULL}, candsDelivered_{0}, receivedLastCandidate_{false} {
   #if !GLIB_CHECK_VERSION(2, 35, 0)
   g_type_init();
   #endif
@@ -73,38 +74,30 @@ LibNiceConnection::~LibNiceConnection() {
 }
 
 void LibNiceConnection::close() {
-  boost::mutex::scoped_lock lock(close_mutex_);
-  if (this->checkIceState() == IceState::FINISHED) {
-    return;
-  }
-  ELOG_DEBUG("%s message:closing", toLog());
-  this->updateIceState(IceState::FINISHED);
-  if (loop_ != NULL) {
-    ELOG_DEBUG("%s message:main loop quit", toLog());
-    g_main_loop_quit(loop_);
-  }
-  cond_.notify_one();
-  listener_.reset();
-  boost::system_time const timeout = boost::get_system_time() + boost::posix_time::milliseconds(5);
-  ELOG_DEBUG("%s message: m_thread join, this: %p", toLog(), this);
-  if (!m_Thread_.timed_join(timeout)) {
-    ELOG_DEBUG("%s message: interrupt thread to close, this: %p", toLog(), this);
-    m_Thread_.interrupt();
-  }
-  if (loop_ != NULL) {
-    ELOG_DEBUG("%s message:Unrefing loop", toLog());
-    g_main_loop_unref(loop_);
-    loop_ = NULL;
+  NiceAgent* agent;
+  GMainContext* context;
+  {
+    boost::mutex::scoped_lock lock(close_mutex_);
+    if (this->checkIceState() == IceState::FINISHED) {
+      return;
+    }
+    ELOG_DEBUG("%s message:closing", toLog());
+    this->updateIceState(IceState::FINISHED);
+    listener_.reset();
+    agent = agent_;
+    context = context_;
+    agent_ = NULL;
+    context_ = NULL;
   }
-  if (agent_ != NULL) {
+  // The agent has to go away in the IO thread so none of its callbacks is running, onData takes close_mutex_
+  if (agent != NULL) {
     ELOG_DEBUG("%s message: unrefing agent", toLog());
-    g_object_unref(agent_);
-    agent_ = NULL;
+    io_worker_->taskSync([agent] {
+      g_object_unref(agent);
+    });
   }
-  if (context_ != NULL) {
-    ELOG_DEBUG("%s message: Unrefing context", toLog());
-    g_main_context_unref(context_);
-    context_ = NULL;
+  if (context != NULL) {
+    io_worker_->releaseGlibContext();
   }
   ELOG_DEBUG("%s message: closed, this: %p", toLog(), this);
 }
@@ -116,11 +109,8 @@ void LibNiceConnection::onData(unsigned int component_id, char* buf, int len) {
     state = this->checkIceState();
   }
   if (state == IceState::READY) {
-    packetPtr packet (new DataPacket());
-    memcpy(packet->data, buf, len);
-    packet->comp = component_id;
-    packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    packetPtr packet = std::make_shared<DataPacket>(component_id, buf, len, VIDEO_PACKET,
+                                                    ClockUtils::timePointToMs(clock::now()));
     if (auto listener = getIceListener().lock()) {
       listener->onPacketReceived(packet);
     }
@@ -143,13 +133,11 @@ void LibNiceConnection::start() {
     if (this->checkIceState() != INITIAL) {
       return;
     }
-    context_ = g_main_context_new();
+    context_ = io_worker_->acquireGlibContext();
     ELOG_DEBUG("%s message: creating Nice Agent", toLog());
     nice_debug_enable(FALSE);
     // Create a nice agent
     agent_ = lib_nice_->NiceAgentNew(context_);
-    loop_ = g_main_loop_new(context_, FALSE);
-    m_Thread_ = boost::thread(&LibNiceConnection::mainLoop, this);
     GValue controllingMode = { 0 };
     g_value_init(&controllingMode, G_TYPE_BOOLEAN);
     g_value_set_boolean(&controllingMode, false);
@@ -239,16 +227,6 @@ void LibNiceConnection::start() {
     lib_nice_->NiceAgentGatherCandidates(agent_, 1);
 }
 
-void LibNiceConnection::mainLoop() {
-  // Start gathering candidates and fire event loop
-  ELOG_DEBUG("%s message: starting g_main_loop, this: %p", toLog(), this);
-  if (agent_ == NULL || loop_ == NULL) {
-    return;
-  }
-  g_main_loop_run(loop_);
-  ELOG_DEBUG("%s message: finished g_main_loop, this: %p", toLog(), this);
-}
-
 bool LibNiceConnection::setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) {
   if (agent_ == NULL) {
     this->close();
@@ -462,7 +440,8 @@ void LibNiceConnection::setReceivedLastCandidate(bool hasReceived) {
   this->receivedLastCandidate_ = hasReceived;
 }
 
-LibNiceConnection* LibNiceConnection::create(const IceConfig& ice_config) {
-  return new LibNiceConnection(boost::shared_ptr<LibNiceInterface>(new LibNiceInterfaceImpl()), ice_config);
+LibNiceConnection* LibNiceConnection::create(std::shared_ptr<IOWorker> io_worker, const IceConfig& ice_config) {
+  return new LibNiceConnection(io_worker, boost::shared_ptr<LibNiceInterface>(new LibNiceInterfaceImpl()),
+                               ice_config);
 }
 } /* namespace erizo */
@@ -7,6 +7,7 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/thread.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 #include <queue>
@@ -17,10 +18,10 @@
 #include "./SdpInfo.h"
 #include "./logger.h"
 #include "lib/LibNiceInterface.h"
+#include "thread/IOWorker.h"
 
 typedef struct _NiceAgent NiceAgent;
 typedef struct _GMainContext GMainContext;
-typedef struct _GMainLoop GMainLoop;
 
 typedef unsigned int uint;
 
@@ -41,11 +42,12 @@ class LibNiceConnection : public IceConnection {
   DECLARE_LOGGER();
 
  public:
-  LibNiceConnection(boost::shared_ptr<LibNiceInterface> libnice, const IceConfig& ice_config);
+  LibNiceConnection(std::shared_ptr<IOWorker> io_worker, boost::shared_ptr<LibNiceInterface> libnice,
+                    const IceConfig& ice_config);
 
   virtual ~LibNiceConnection();
   /**
-   * Starts Gathering candidates in a new thread.
+   * Starts Gathering candidates, the agent runs in the GLib context of the IOWorker.
    */
   void start() override;
   bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) override;
@@ -60,22 +62,17 @@ class LibNiceConnection : public IceConnection {
   void setReceivedLastCandidate(bool hasReceived) override;
   void close() override;
 
-  static LibNiceConnection* create(const IceConfig& ice_config);
-
- private:
-  void mainLoop();
+  static LibNiceConnection* create(std::shared_ptr<IOWorker> io_worker, const IceConfig& ice_config);
 
  private:
+  std::shared_ptr<IOWorker> io_worker_;
   boost::shared_ptr<LibNiceInterface> lib_nice_;
   NiceAgent* agent_;
   GMainContext* context_;
-  GMainLoop* loop_;
 
   unsigned int candsDelivered_;
 
-  boost::thread m_Thread_;
   boost::mutex close_mutex_;
-  boost::condition_variable cond_;
 
   bool receivedLastCandidate_;
   boost::shared_ptr<std::vector<CandidateInfo> > local_candidates;
@@ -5,70 +5,252 @@
 #define ERIZO_SRC_ERIZO_MEDIADEFINITIONS_H_
 
 #include <boost/thread/mutex.hpp>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 #include <algorithm>
 
 #include "lib/Clock.h"
 #include "lib/ClockUtils.h"
+#include "lib/PacketBufferPool.h"
 
 namespace erizo {
 
+static constexpr int kRtpFixedHeaderSize = 12;
+
 enum packetType {
     VIDEO_PACKET,
     AUDIO_PACKET,
     OTHER_PACKET
 };
 
+// Codec of an RTP packet, set by PacketCodecParser from the payload type
+enum class RtpCodec : uint8_t {
+  UNKNOWN, VP8, VP9, H264, RED, ULPFEC, RTX, OPUS, PCMU, PCMA
+};
+
+// Layers a packet belongs to, kept as a bitmask so packets carry them without allocating
+class LayerSet {
+ public:
+  static constexpr int kMaxLayers = 32;
+
+  class const_iterator {
+   public:
+    explicit const_iterator(uint32_t remaining) : remaining_{remaining} {}
+    int operator*() const { return __builtin_ctz(remaining_); }
+    const_iterator& operator++() {
+      remaining_ &= remaining_ - 1;
+      return *this;
+    }
+    bool operator!=(const const_iterator& other) const { return remaining_ != other.remaining_; }
+
+   private:
+    uint32_t remaining_;
+  };
+
+  LayerSet() = default;
+  LayerSet(std::initializer_list<int> layers) {
+    for (int layer : layers) {
+      add(layer);
+    }
+  }
+
+  // Negative ids (i.e. packets from an unknown SSRC) belong to no layer
+  void add(int layer) {
+    if (layer >= 0 && layer < kMaxLayers) {
+      mask_ |= 1u << layer;
+    }
+  }
+
+  // Adds every layer in [first, last]
+  void addRange(int first, int last) {
+    for (int layer = std::max(first, 0); layer <= last && layer < kMaxLayers; layer++) {
+      mask_ |= 1u << layer;
+    }
+  }
+
+  bool contains(int layer) const {
+    return layer >= 0 && layer < kMaxLayers && (mask_ & (1u << layer));
+  }
+
+  // Lowest layer in the set, or -1 if it is empty
+  int lowest() const {
+    return mask_ ? __builtin_ctz(mask_) : -1;
+  }
+
+  void clear() { mask_ = 0; }
+  bool empty() const { return mask_ == 0; }
+  uint32_t mask() const { return mask_; }
+
+  const_iterator begin() const { return const_iterator{mask_}; }
+  const_iterator end() const { return const_iterator{0}; }
+
+ private:
+  uint32_t mask_ = 0;
+};
+
 struct DataPacket {
-  DataPacket() = default;
+  DataPacket() : buffer{PacketBufferPool::allocateFromCurrent()}, data{buffer->data()} {}
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_, uint64_t received_time_ms_) :
-    comp{comp_}, length{length_}, type{type_}, received_time_ms{received_time_ms_}, is_keyframe{false},
-    ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    comp{comp_}, buffer{PacketBufferPool::allocateFromCurrent()}, data{buffer->data()}, length{length_},
+    type{type_}, received_time_ms{received_time_ms_} {
       memcpy(data, data_, length_);
   }
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_) :
-    comp{comp_}, length{length_}, type{type_}, received_time_ms{ClockUtils::timePointToMs(clock::now())},
-    is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    comp{comp_}, buffer{PacketBufferPool::allocateFromCurrent()}, data{buffer->data()}, length{length_},
+    type{type_}, received_time_ms{ClockUtils::timePointToMs(clock::now())} {
       memcpy(data, data_, length_);
   }
 
   DataPacket(int comp_, const unsigned char *data_, int length_) :
-    comp{comp_}, length{length_}, type{VIDEO_PACKET}, received_time_ms{ClockUtils::timePointToMs(clock::now())},
-    is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    comp{comp_}, buffer{PacketBufferPool::allocateFromCurrent()}, data{buffer->data()}, length{length_},
+    type{VIDEO_PACKET}, received_time_ms{ClockUtils::timePointToMs(clock::now())} {
       memcpy(data, data_, length_);
   }
 
-  bool belongsToSpatialLayer(int spatial_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_spatial_layers.begin(),
-                                              compatible_spatial_layers.end(),
-                                              spatial_layer_);
+  // Copies only the used bytes into a new pooled buffer, so the copy can be modified freely
+  DataPacket(const DataPacket& other) :
+    DataPacket{other, PacketBufferPool::allocateFromCurrent()} {
+      memcpy(data, other.data, other.usedLength());
+      mergePrivateHeader();
+  }
+
+  // Shares the buffer of other (copy-on-write), call makeWritable() before modifying data.
+  // A shared packet keeps the offset of other in the buffer, i.e. when other is a slice.
+  DataPacket(const DataPacket& other, PacketBufferPtr shared_buffer) :
+    comp{other.comp}, buffer{std::move(shared_buffer)},
+    data{buffer == other.buffer ? other.data : buffer->data()}, length{other.length},
+    type{other.type}, received_time_ms{other.received_time_ms},
+    compatible_spatial_layers{other.compatible_spatial_layers},
+    compatible_temporal_layers{other.compatible_temporal_layers},
+    is_keyframe{other.is_keyframe}, ending_of_layer_frame{other.ending_of_layer_frame},
+    is_retransmission{other.is_retransmission}, is_padding{other.is_padding},
+    picture_id{other.picture_id}, tl0_pic_idx{other.tl0_pic_idx},
+    codec{other.codec}, clock_rate{other.clock_rate}, has_private_header_{other.has_private_header_} {
+      if (has_private_header_) {
+        memcpy(private_header_, other.private_header_, kRtpFixedHeaderSize);
+      }
+  }
 
-    return item != compatible_spatial_layers.end();
+  DataPacket& operator=(const DataPacket& other) {
+    if (this != &other) {
+      buffer = PacketBufferPool::allocateFromCurrent();
+      data = buffer->data();
+      memcpy(data, other.data, other.usedLength());
+      has_private_header_ = other.has_private_header_;
+      if (has_private_header_) {
+        memcpy(private_header_, other.private_header_, kRtpFixedHeaderSize);
+      }
+      mergePrivateHeader();
+      comp = other.comp;
+      length = other.length;
+      type = other.type;
+      received_time_ms = other.received_time_ms;
+      compatible_spatial_layers = other.compatible_spatial_layers;
+      compatible_temporal_layers = other.compatible_temporal_layers;
+      is_keyframe = other.is_keyframe;
+      ending_of_layer_frame = other.ending_of_layer_frame;
+      is_retransmission = other.is_retransmission;
+      is_padding = other.is_padding;
+      picture_id = other.picture_id;
+      tl0_pic_idx = other.tl0_pic_idx;
+      codec = other.codec;
+      clock_rate = other.clock_rate;
+    }
+    return *this;
   }
 
-  bool belongsToTemporalLayer(int temporal_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_temporal_layers.begin(),
-                                              compatible_temporal_layers.end(),
-                                              temporal_layer_);
+  std::shared_ptr<DataPacket> share() const {
+    return std::make_shared<DataPacket>(*this, buffer);
+  }
 
-    return item != compatible_temporal_layers.end();
+  // View of slice_length bytes at offset (i.e. some blocks of a compound RTCP packet received from the transport)
+  // that shares the buffer like share(). Views over disjoint ranges can be modified without makeWritable().
+  std::shared_ptr<DataPacket> slice(int offset, int slice_length) const {
+    std::shared_ptr<DataPacket> packet = share();
+    packet->data += offset;
+    packet->length = slice_length;
+    return packet;
   }
 
-  int comp;
-  char data[1500];
-  int length;
-  packetType type;
-  uint64_t received_time_ms;
-  std::vector<int> compatible_spatial_layers;
-  std::vector<int> compatible_temporal_layers;
-  bool is_keyframe;  // Note: It can be just a keyframe first packet in VP8
-  bool ending_of_layer_frame;
-  int picture_id;
-  int tl0_pic_idx;
-  std::string codec;
+  // Fan-out packet: shares the payload with this one and keeps a private copy of the fixed RTP header
+  // (or of the first RTCP header words), which can be rewritten through header() without touching the payload.
+  std::shared_ptr<DataPacket> shareWithPrivateHeader() const {
+    std::shared_ptr<DataPacket> packet = share();
+    if (!packet->has_private_header_ && length >= kRtpFixedHeaderSize) {
+      memcpy(packet->private_header_, data, kRtpFixedHeaderSize);
+      packet->has_private_header_ = true;
+    }
+    return packet;
+  }
+
+  char* header() {
+    return has_private_header_ ? private_header_ : data;
+  }
+
+  bool isShared() const {
+    return buffer->isShared();
+  }
+
+  // Bytes available after the data, i.e. for a trailer written in place
+  int tailroom() const {
+    return kPacketBufferSize - static_cast<int>(data - buffer->data()) - length;
+  }
+
+  void makeWritable() {
+    if (buffer->isShared()) {
+      PacketBufferPtr own_buffer = PacketBufferPool::allocateFromCurrent();
+      memcpy(own_buffer->data(), data, usedLength());
+      buffer = std::move(own_buffer);
+      data = buffer->data();
+    }
+    mergePrivateHeader();
+  }
+
+  bool belongsToSpatialLayer(int spatial_layer_) const {
+    return compatible_spatial_layers.contains(spatial_layer_);
+  }
+
+  bool belongsToTemporalLayer(int temporal_layer_) const {
+    return compatible_temporal_layers.contains(temporal_layer_);
+  }
+
+  int comp = 0;
+  PacketBufferPtr buffer;
+  char* data;
+  int length = 0;
+  packetType type = VIDEO_PACKET;
+  uint64_t received_time_ms = 0;
+  LayerSet compatible_spatial_layers;
+  LayerSet compatible_temporal_layers;
+  bool is_keyframe = false;  // Note: It can be just a keyframe first packet in VP8
+  bool ending_of_layer_frame = false;
+  bool is_retransmission = false;  // Both are used to prioritize packets in the Pacer
+  bool is_padding = false;
+  int picture_id = -1;
+  int tl0_pic_idx = -1;
+  RtpCodec codec = RtpCodec::UNKNOWN;
   unsigned int clock_rate = 0;
+
+ private:
+  int usedLength() const {
+    return std::max(0, std::min(length, kPacketBufferSize));
+  }
+
+  void mergePrivateHeader() {
+    if (has_private_header_) {
+      memcpy(data, private_header_, kRtpFixedHeaderSize);
+      has_private_header_ = false;
+    }
+  }
+
+  bool has_private_header_ = false;
+  char private_header_[kRtpFixedHeaderSize];
 };
 
 class Monitor {
@@ -116,6 +298,7 @@ class MediaSink: public virtual Monitor {
     // SSRCs received by the SINK
     uint32_t audio_sink_ssrc_;
     uint32_t video_sink_ssrc_;
+    uint32_t video_sink_rtx_ssrc_;
     // Is it able to provide Feedback
     FeedbackSource* sink_fb_source_;
 
@@ -134,6 +317,14 @@ class MediaSink: public virtual Monitor {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         video_sink_ssrc_ = ssrc;
     }
+    uint32_t getVideoSinkRtxSSRC() {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        return video_sink_rtx_ssrc_;
+    }
+    void setVideoSinkRtxSSRC(uint32_t ssrc) {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        video_sink_rtx_ssrc_ = ssrc;
+    }
     uint32_t getAudioSinkSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_sink_ssrc_;
@@ -155,7 +346,7 @@ class MediaSink: public virtual Monitor {
     int deliverEvent(MediaEventPtr event) {
       return this->deliverEvent_(event);
     }
-    MediaSink() : audio_sink_ssrc_{0}, video_sink_ssrc_{0}, sink_fb_source_{nullptr} {}
+    MediaSink() : audio_sink_ssrc_{0}, video_sink_ssrc_{0}, video_sink_rtx_ssrc_{0}, sink_fb_source_{nullptr} {}
     virtual ~MediaSink() {}
 
     virtual void close() = 0;
@@ -174,6 +365,8 @@ class MediaSource: public virtual Monitor {
     // SSRCs coming from the source
     uint32_t audio_source_ssrc_;
     std::vector<uint32_t> video_source_ssrc_list_;
+    // RTX SSRC -> media SSRC
+    std::map<uint32_t, uint32_t> video_source_rtx_ssrc_map_;
     MediaSink* video_sink_;
     MediaSink* audio_sink_;
     MediaSink* event_sink_;
@@ -222,6 +415,14 @@ class MediaSource: public virtual Monitor {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         video_source_ssrc_list_ = new_ssrc_list;
     }
+    std::map<uint32_t, uint32_t> getVideoSourceRtxSSRCMap() {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        return video_source_rtx_ssrc_map_;
+    }
+    void setVideoSourceRtxSSRCMap(const std::map<uint32_t, uint32_t>& new_rtx_ssrc_map) {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        video_source_rtx_ssrc_map_ = new_rtx_ssrc_map;
+    }
     uint32_t getAudioSourceSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_source_ssrc_;
@@ -243,6 +444,11 @@ class MediaSource: public virtual Monitor {
       return audio_source_ssrc_ == ssrc;
     }
 
+    bool isVideoSourceRtxSSRC(uint32_t ssrc) {
+      boost::mutex::scoped_lock lock(monitor_mutex_);
+      return video_source_rtx_ssrc_map_.find(ssrc) != video_source_rtx_ssrc_map_.end();
+    }
+
     MediaSource() : audio_source_ssrc_{0}, video_source_ssrc_list_{std::vector<uint32_t>(1, 0)},
       video_sink_{nullptr}, audio_sink_{nullptr}, event_sink_{nullptr}, source_fb_sink_{nullptr} {}
     virtual ~MediaSource() {}
@@ -23,6 +23,7 @@
 #include "rtp/RtpTrackMuteHandler.h"
 #include "rtp/BandwidthEstimationHandler.h"
 #include "rtp/FecReceiverHandler.h"
+#include "rtp/RtxReceiverHandler.h"
 #include "rtp/RtcpProcessorHandler.h"
 #include "rtp/RtpRetransmissionHandler.h"
 #include "rtp/RtcpFeedbackGenerationHandler.h"
@@ -58,13 +59,14 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
     mslabel_ {media_stream_label},
     bundle_{false},
     pipeline_{Pipeline::create()},
-    worker_{std::move(worker)},
+    worker_{std::make_shared<WorkerReference>(std::move(worker))},
     audio_muted_{false}, video_muted_{false},
     pipeline_initialized_{false},
     is_publisher_{is_publisher},
     simulcast_{false},
     bitrate_from_max_quality_layer_{0},
     video_bitrate_{0},
+    sender_bandwidth_estimate_{0},
     random_generator_{random_device_()} {
   if (is_publisher) {
     setVideoSinkSSRC(kDefaultVideoSinkSSRC);
@@ -72,6 +74,7 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
   } else {
     setAudioSinkSSRC(1000000000 + getRandomValue(0, 999999999));
     setVideoSinkSSRC(1000000000 + getRandomValue(0, 999999999));
+    setVideoSinkRtxSSRC(1000000000 + getRandomValue(0, 999999999));
   }
   ELOG_INFO("%s message: constructor, id: %s",
       toLog(), media_stream_id.c_str());
@@ -192,6 +195,8 @@ bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp) {
 
   ready_ = true;
 
+  updateRtx();
+
   if (pipeline_initialized_ && pipeline_) {
     pipeline_->notifyUpdate();
     return true;
@@ -232,6 +237,27 @@ bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp) {
   return true;
 }
 
+void MediaStream::updateRtx() {
+  if (isPublisher()) {
+    std::map<uint32_t, uint32_t> rtx_ssrc_map;
+    auto video_rtx_ssrc_map_it = remote_sdp_->video_rtx_ssrc_map.find(getLabel());
+    if (video_rtx_ssrc_map_it != remote_sdp_->video_rtx_ssrc_map.end()) {
+      for (const auto &ssrcs : video_rtx_ssrc_map_it->second) {
+        rtx_ssrc_map[ssrcs.second] = ssrcs.first;
+      }
+    }
+    setVideoSourceRtxSSRCMap(rtx_ssrc_map);
+    return;
+  }
+  std::map<uint8_t, uint8_t> rtx_payload_types;
+  for (const auto &rtx_pt : remote_sdp_->getRtxAssociatedPTs(VIDEO_TYPE)) {
+    rtx_payload_types[rtx_pt.second] = rtx_pt.first;
+  }
+  if (!rtx_payload_types.empty()) {
+    packet_buffer_->setVideoRtx(getVideoSinkRtxSSRC(), rtx_payload_types, getRandomValue(0, 0xffff));
+  }
+}
+
 void MediaStream::initializeStats() {
   log_stats_->getNode().insertStat("streamId", StringStat{getId()});
   log_stats_->getNode().insertStat("audioBitrate", CumulativeStat{0});
@@ -280,6 +306,9 @@ void MediaStream::initializeStats() {
 
   log_stats_->getNode().insertStat("totalBitrate", CumulativeStat{0});
   log_stats_->getNode().insertStat("rtxBitrate", CumulativeStat{0});
+  log_stats_->getNode().insertStat("rtxBufferHits", CumulativeStat{0});
+  log_stats_->getNode().insertStat("rtxBufferMisses", CumulativeStat{0});
+  log_stats_->getNode().insertStat("rtxBufferAvgAgeMs", CumulativeStat{0});
   log_stats_->getNode().insertStat("paddingBitrate", CumulativeStat{0});
   log_stats_->getNode().insertStat("bwe", CumulativeStat{0});
 
@@ -287,7 +316,7 @@ void MediaStream::initializeStats() {
   log_stats_->getNode().insertStat("qualityCappedByConstraints", CumulativeStat{0});
 
   std::weak_ptr<MediaStream> weak_this = shared_from_this();
-  worker_->scheduleEvery([weak_this] () {
+  scheduleEvery([weak_this] () {
     if (auto stream = weak_this.lock()) {
       if (stream->sending_) {
         stream->printStats();
@@ -366,6 +395,9 @@ void MediaStream::printStats() {
   transferMediaStats("totalBitrate", "total", "bitrateCalculated");
   transferMediaStats("paddingBitrate", "total", "paddingBitrate");
   transferMediaStats("rtxBitrate", "total", "rtxBitrate");
+  transferMediaStats("rtxBufferHits", "total", "rtxBufferHits");
+  transferMediaStats("rtxBufferMisses", "total", "rtxBufferMisses");
+  transferMediaStats("rtxBufferAvgAgeMs", "total", "rtxBufferAvgAgeMs");
   transferMediaStats("bwe", "total", "senderBitrateEstimation");
 
   ELOG_INFOT(statsLogger, "%s", log_stats_->getStats());
@@ -404,6 +436,7 @@ void MediaStream::initializePipeline() {
   pipeline_->addFront(std::make_shared<LayerDetectorHandler>());
   pipeline_->addFront(std::make_shared<OutgoingStatsHandler>());
   pipeline_->addFront(std::make_shared<PacketCodecParser>());
+  pipeline_->addFront(std::make_shared<RtxReceiverHandler>());
 
   pipeline_->addFront(std::make_shared<PacketWriter>(this));
   pipeline_->finalize();
@@ -412,14 +445,14 @@ void MediaStream::initializePipeline() {
 
 int MediaStream::deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) {
   if (audio_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*audio_packet));
+    sendPacketAsync(audio_packet->share());
   }
   return audio_packet->length;
 }
 
 int MediaStream::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
   if (video_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*video_packet));
+    sendPacketAsync(video_packet->share());
   }
   return video_packet->length;
 }
@@ -463,13 +496,11 @@ int MediaStream::deliverEvent_(MediaEventPtr event) {
   return 1;
 }
 
-void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet, Transport *transport) {
+void MediaStream::onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) {
   if ((audio_sink_ == nullptr && video_sink_ == nullptr && fb_sink_ == nullptr)) {
     return;
   }
 
-  std::shared_ptr<DataPacket> packet = std::make_shared<DataPacket>(*incoming_packet);
-
   if (transport->mediaType == AUDIO_TYPE) {
     packet->type = AUDIO_PACKET;
   } else if (transport->mediaType == VIDEO_TYPE) {
@@ -488,7 +519,7 @@ void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet, T
     RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (buf);
     if (!chead->isRtcp()) {
       uint32_t recvSSRC = head->getSSRC();
-      if (stream_ptr->isVideoSourceSSRC(recvSSRC)) {
+      if (stream_ptr->isVideoSourceSSRC(recvSSRC) || stream_ptr->isVideoSourceRtxSSRC(recvSSRC)) {
         packet->type = VIDEO_PACKET;
       } else if (stream_ptr->isAudioSourceSSRC(recvSSRC)) {
         packet->type = AUDIO_PACKET;
@@ -596,23 +627,41 @@ void MediaStream::sendPacketAsync(std::shared_ptr<DataPacket> packet) {
   if (!sending_) {
     return;
   }
-  auto stream_ptr = shared_from_this();
   if (packet->comp == -1) {
     sending_ = false;
-    auto p = std::make_shared<DataPacket>();
-    p->comp = -1;
-    worker_->task([stream_ptr, p]{
-      stream_ptr->sendPacket(p);
-    });
-    return;
+    packet = std::make_shared<DataPacket>();
+    packet->comp = -1;
+  } else {
+    changeDeliverPayloadType(packet.get(), packet->type);
   }
-
-  changeDeliverPayloadType(packet.get(), packet->type);
-  worker_->task([stream_ptr, packet]{
-    stream_ptr->sendPacket(packet);
+  {
+    // Packets arriving in a burst are sent by a single task in the worker
+    boost::mutex::scoped_lock lock(pending_send_packets_mutex_);
+    pending_send_packets_.push_back(packet);
+    if (pending_send_packets_.size() > 1) {
+      return;
+    }
+  }
+  auto stream_ptr = shared_from_this();
+  worker_->task([stream_ptr]{
+    stream_ptr->sendPendingPackets();
   });
 }
 
+void MediaStream::sendPendingPackets() {
+  {
+    boost::mutex::scoped_lock lock(pending_send_packets_mutex_);
+    pending_send_packets_.swap(sending_packets_);
+  }
+  for (const std::shared_ptr<DataPacket> &packet : sending_packets_) {
+    // Packets may still share their payload with other streams, we take our own copy in this worker
+    packet->makeWritable();
+    sendPacket(packet);
+  }
+  getWorker()->addPackets(sending_packets_.size());
+  sending_packets_.clear();
+}
+
 void MediaStream::setSlideShowMode(bool state) {
   ELOG_DEBUG("%s slideShowMode: %u", toLog(), state);
   if (slide_show_mode_ == state) {
@@ -686,6 +735,15 @@ void MediaStream::setFeedbackReports(bool will_send_fb, uint32_t target_bitrate)
   this->rate_control_ = target_bitrate;
 }
 
+void MediaStream::setSenderBandwidthEstimate(uint64_t bitrate) {
+  sender_bandwidth_estimate_ = bitrate;
+  connection_->setStreamBandwidthEstimate(stream_id_, bitrate);
+}
+
+void MediaStream::setTargetPaddingBitrate(uint64_t bitrate) {
+  connection_->setStreamPaddingBitrate(stream_id_, bitrate);
+}
+
 void MediaStream::setMetadata(std::map<std::string, std::string> metadata) {
   for (const auto &item : metadata) {
     log_stats_->getNode().insertStat("metadata-" + item.first, StringStat{item.second});
@@ -705,9 +763,17 @@ void MediaStream::getJSONStats(std::function<void(std::string)> callback) {
   });
 }
 
+void MediaStream::getStatValues(std::function<void(std::vector<StatValue>)> callback) {
+  asyncTask([callback] (std::shared_ptr<MediaStream> stream) {
+    std::vector<StatValue> values;
+    stream->stats_->collectValues(&values);
+    callback(std::move(values));
+  });
+}
+
 void MediaStream::changeDeliverPayloadType(DataPacket *dp, packetType type) {
-  RtpHeader* h = reinterpret_cast<RtpHeader*>(dp->data);
-  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(dp->data);
+  RtpHeader* h = reinterpret_cast<RtpHeader*>(dp->header());
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(dp->header());
   if (!chead->isRtcp()) {
       int internalPT = h->getPayloadType();
       int externalPT = internalPT;
@@ -772,6 +838,59 @@ void MediaStream::notifyUpdateToHandlers() {
   });
 }
 
+boost::future<void> MediaStream::migrateTo(std::shared_ptr<Worker> new_worker) {
+  return asyncTask([new_worker] (std::shared_ptr<MediaStream> stream) {
+    std::shared_ptr<Worker> old_worker = stream->getWorker();
+    if (old_worker == new_worker) {
+      return;
+    }
+    ELOG_DEBUG("%s message: Migrating stream to another worker", stream->toLog());
+    stream->worker_->moveTo(new_worker);
+    // Handlers that keep a reference to the worker pick up the new one
+    stream->asyncTask([] (std::shared_ptr<MediaStream> stream) {
+      if (stream->pipeline_) {
+        stream->pipeline_->notifyUpdate();
+      }
+    });
+  });
+}
+
+std::shared_ptr<ScheduledTaskReference> MediaStream::scheduleFromNow(std::function<void()> f, duration delta) {
+  std::weak_ptr<MediaStream> weak_this = shared_from_this();
+  std::shared_ptr<Worker> worker = getWorker();
+  Worker *scheduling_worker = worker.get();
+  auto id = std::make_shared<ScheduledTaskReference>();
+  worker->scheduleFromNow([weak_this, scheduling_worker, id, f] {
+    auto this_ptr = weak_this.lock();
+    if (!this_ptr || id->isCancelled()) {
+      return;
+    }
+    this_ptr->worker_->runOrTask(scheduling_worker, [id, f] {
+      if (!id->isCancelled()) {
+        f();
+      }
+    });
+  }, delta, id);
+  return id;
+}
+
+void MediaStream::scheduleEvery(std::function<bool()> f, duration period) {
+  std::weak_ptr<MediaStream> weak_this = shared_from_this();
+  scheduleFromNow([weak_this, f, period] {
+    if (auto this_ptr = weak_this.lock()) {
+      if (f()) {
+        this_ptr->scheduleEvery(f, period);
+      }
+    }
+  }, period);
+}
+
+void MediaStream::unschedule(std::shared_ptr<ScheduledTaskReference> id) {
+  if (id) {
+    getWorker()->unschedule(id);
+  }
+}
+
 boost::future<void> MediaStream::asyncTask(std::function<void(std::shared_ptr<MediaStream>)> f) {
   auto task_promise = std::make_shared<boost::promise<void>>();
   std::weak_ptr<MediaStream> weak_this = shared_from_this();
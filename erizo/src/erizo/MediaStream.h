@@ -19,6 +19,7 @@
 #include "./WebRtcConnection.h"
 #include "pipeline/Pipeline.h"
 #include "thread/Worker.h"
+#include "thread/WorkerReference.h"
 #include "rtp/RtcpProcessor.h"
 #include "rtp/RtpExtensionProcessor.h"
 #include "lib/Clock.h"
@@ -106,7 +107,11 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   }
 
   void getJSONStats(std::function<void(std::string)> callback);
+  void getStatValues(std::function<void(std::vector<StatValue>)> callback);
 
+  /**
+   * The stream takes ownership of the packet, callers must not keep using it.
+   */
   virtual void onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport);
 
   void sendPacketAsync(std::shared_ptr<DataPacket> packet);
@@ -146,7 +151,13 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   void setSimulcast(bool simulcast) { simulcast_ = simulcast; }
 
   RtpExtensionProcessor& getRtpExtensionProcessor() { return connection_->getRtpExtensionProcessor(); }
-  std::shared_ptr<Worker> getWorker() { return worker_; }
+  std::shared_ptr<Worker> getWorker() { return worker_->get(); }
+  boost::future<void> migrateTo(std::shared_ptr<Worker> new_worker);
+
+  // Scheduled tasks follow the stream when it is migrated to another worker
+  std::shared_ptr<ScheduledTaskReference> scheduleFromNow(std::function<void()> f, duration delta);
+  void scheduleEvery(std::function<bool()> f, duration period);
+  void unschedule(std::shared_ptr<ScheduledTaskReference> id);
 
   std::string getId() { return stream_id_; }
   std::string getLabel() { return mslabel_; }
@@ -161,6 +172,9 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   Pipeline::Ptr getPipeline() { return pipeline_; }
   bool isPublisher() { return is_publisher_; }
   void setBitrateFromMaxQualityLayer(uint64_t bitrate) { bitrate_from_max_quality_layer_ = bitrate; }
+  void setSenderBandwidthEstimate(uint64_t bitrate);
+  uint64_t getSenderBandwidthEstimate() { return sender_bandwidth_estimate_; }
+  void setTargetPaddingBitrate(uint64_t bitrate);
 
   inline std::string toLog() {
     return "id: " + stream_id_ + ", role:" + (is_publisher_ ? "publisher" : "subscriber") + ", " + printLogContext();
@@ -168,11 +182,13 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
  private:
   void sendPacket(std::shared_ptr<DataPacket> packet);
+  void sendPendingPackets();
   int deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<DataPacket> video_packet) override;
   int deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void initializePipeline();
+  void updateRtx();
   void transferLayerStats(std::string spatial, std::string temporal);
   void transferMediaStats(std::string target_node, std::string source_parent, std::string source_node);
 
@@ -182,6 +198,9 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
  private:
   boost::mutex event_listener_mutex_;
+  boost::mutex pending_send_packets_mutex_;
+  std::vector<std::shared_ptr<DataPacket>> pending_send_packets_;
+  std::vector<std::shared_ptr<DataPacket>> sending_packets_;
   MediaStreamEventListener* media_stream_event_listener_;
   std::shared_ptr<WebRtcConnection> connection_;
   std::string stream_id_;
@@ -207,7 +226,7 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
   Pipeline::Ptr pipeline_;
 
-  std::shared_ptr<Worker> worker_;
+  std::shared_ptr<WorkerReference> worker_;
 
   bool audio_muted_;
   bool video_muted_;
@@ -219,6 +238,7 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   std::atomic_bool simulcast_;
   std::atomic<uint64_t> bitrate_from_max_quality_layer_;
   std::atomic<uint32_t> video_bitrate_;
+  std::atomic<uint64_t> sender_bandwidth_estimate_;
   std::random_device random_device_;
   std::mt19937 random_generator_;
  protected:
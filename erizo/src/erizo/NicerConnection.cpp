@@ -572,11 +572,9 @@ void NicerConnection::onData(unsigned int component_id, char* buf, int len) {
     state = this->checkIceState();
   }
   if (state == IceState::READY) {
-    packetPtr packet (new DataPacket());
-    memcpy(packet->data, buf, len);
-    packet->comp = component_id;
-    packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    io_worker_->addPackets(1);
+    packetPtr packet = std::make_shared<DataPacket>(component_id, buf, len, VIDEO_PACKET,
+                                                    ClockUtils::timePointToMs(clock::now()));
     if (auto listener = getIceListener().lock()) {
       listener->onPacketReceived(packet);
     }
@@ -5,6 +5,7 @@
 #include "OneToManyProcessor.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "./MediaStream.h"
@@ -13,7 +14,8 @@
 
 namespace erizo {
   DEFINE_LOGGER(OneToManyProcessor, "OneToManyProcessor");
-  OneToManyProcessor::OneToManyProcessor() : feedbackSink_{nullptr} {
+  OneToManyProcessor::OneToManyProcessor() : feedbackSink_{nullptr},
+      subscriber_snapshot_{std::make_shared<SubscriberSnapshot>()} {
     ELOG_DEBUG("OneToManyProcessor constructor");
   }
 
@@ -24,31 +26,39 @@ namespace erizo {
     if (audio_packet->length <= 0)
       return 0;
 
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers.empty())
+    std::shared_ptr<const SubscriberSnapshot> snapshot = getSubscriberSnapshot();
+    if (snapshot->sinks.empty())
       return 0;
 
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    RtpHeader* head = reinterpret_cast<RtpHeader*>(audio_packet->data);
-    for (it = subscribers.begin(); it != subscribers.end(); ++it) {
-      if ((*it).second != nullptr) {
-        head->setSSRC((*it).second->getAudioSinkSSRC());
-        // Note: deliverAudioData must copy the packet inmediately
-        (*it).second->deliverAudioData(audio_packet);
-      }
+    for (const std::shared_ptr<MediaSink> &sink : snapshot->sinks) {
+      // Subscribers share the payload, only the RTP header is rewritten for each of them
+      std::shared_ptr<DataPacket> subscriber_packet = audio_packet->shareWithPrivateHeader();
+      RtpHeader* head = reinterpret_cast<RtpHeader*>(subscriber_packet->header());
+      head->setSSRC(sink->getAudioSinkSSRC());
+      sink->deliverAudioData(subscriber_packet);
     }
 
     return 0;
   }
 
-  bool OneToManyProcessor::isSSRCFromAudio(uint32_t ssrc) {
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    for (it = subscribers.begin(); it != subscribers.end(); ++it) {
-      if ((*it).second->getAudioSinkSSRC() == ssrc) {
-        return true;
+  bool OneToManyProcessor::isSSRCFromAudio(const SubscriberSnapshot& snapshot, uint32_t ssrc) {
+    return snapshot.audio_sink_ssrcs.find(ssrc) != snapshot.audio_sink_ssrcs.end();
+  }
+
+  std::shared_ptr<const SubscriberSnapshot> OneToManyProcessor::getSubscriberSnapshot() const {
+    return std::atomic_load(&subscriber_snapshot_);
+  }
+
+  void OneToManyProcessor::publishSubscriberSnapshot() {
+    std::shared_ptr<SubscriberSnapshot> snapshot = std::make_shared<SubscriberSnapshot>();
+    snapshot->sinks.reserve(subscribers.size());
+    for (const auto &subscriber : subscribers) {
+      if (subscriber.second != nullptr) {
+        snapshot->sinks.push_back(subscriber.second);
+        snapshot->audio_sink_ssrcs.insert(subscriber.second->getAudioSinkSSRC());
       }
     }
-    return false;
+    std::atomic_store(&subscriber_snapshot_, std::shared_ptr<const SubscriberSnapshot>(std::move(snapshot)));
   }
 
   int OneToManyProcessor::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
@@ -60,24 +70,23 @@ namespace erizo {
       deliverFeedback_(video_packet);
       return 0;
     }
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers.empty())
+    std::shared_ptr<const SubscriberSnapshot> snapshot = getSubscriberSnapshot();
+    if (snapshot->sinks.empty())
       return 0;
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
     RtpHeader* rhead = reinterpret_cast<RtpHeader*>(video_packet->data);
-    uint32_t ssrc = head->isRtcp() ? head->getSSRC() : rhead->getSSRC();
+    bool is_rtcp = head->isRtcp();
+    uint32_t ssrc = is_rtcp ? head->getSSRC() : rhead->getSSRC();
     uint32_t ssrc_offset = translateAndMaybeAdaptForSimulcast(ssrc);
-    for (it = subscribers.begin(); it != subscribers.end(); ++it) {
-      if ((*it).second != nullptr) {
-        uint32_t base_ssrc = (*it).second->getVideoSinkSSRC();
-        if (head->isRtcp()) {
-          head->setSSRC(base_ssrc + ssrc_offset);
-        } else {
-          rhead->setSSRC(base_ssrc + ssrc_offset);
-        }
-        // Note: deliverVideoData must copy the packet inmediately
-        (*it).second->deliverVideoData(video_packet);
+    for (const std::shared_ptr<MediaSink> &sink : snapshot->sinks) {
+      // Subscribers share the payload, only the RTP header is rewritten for each of them
+      std::shared_ptr<DataPacket> subscriber_packet = video_packet->shareWithPrivateHeader();
+      uint32_t base_ssrc = sink->getVideoSinkSSRC();
+      if (is_rtcp) {
+        reinterpret_cast<RtcpHeader*>(subscriber_packet->header())->setSSRC(base_ssrc + ssrc_offset);
+      } else {
+        reinterpret_cast<RtpHeader*>(subscriber_packet->header())->setSSRC(base_ssrc + ssrc_offset);
       }
+      sink->deliverVideoData(subscriber_packet);
     }
     return 0;
   }
@@ -94,17 +103,18 @@ namespace erizo {
 
   int OneToManyProcessor::deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) {
     if (feedbackSink_ != nullptr) {
-      RtpUtils::forEachRtcpBlock(fb_packet, [this](RtcpHeader *chead) {
+      std::shared_ptr<const SubscriberSnapshot> snapshot = getSubscriberSnapshot();
+      RtpUtils::forEachRtcpBlock(fb_packet, [this, &snapshot](RtcpHeader *chead) {
         if (chead->isREMB()) {
           for (uint8_t index = 0; index < chead->getREMBNumSSRC(); index++) {
-            if (isSSRCFromAudio(chead->getREMBFeedSSRC(index))) {
+            if (isSSRCFromAudio(*snapshot, chead->getREMBFeedSSRC(index))) {
               chead->setREMBFeedSSRC(index, publisher->getAudioSourceSSRC());
             } else {
               chead->setREMBFeedSSRC(index, publisher->getVideoSourceSSRC());
             }
           }
         }
-        if (isSSRCFromAudio(chead->getSourceSSRC())) {
+        if (isSSRCFromAudio(*snapshot, chead->getSourceSSRC())) {
           chead->setSourceSSRC(publisher->getAudioSourceSSRC());
         } else {
           chead->setSourceSSRC(publisher->getVideoSourceSSRC());
@@ -116,14 +126,9 @@ namespace erizo {
   }
 
   int OneToManyProcessor::deliverEvent_(MediaEventPtr event) {
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers.empty())
-      return 0;
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    for (it = subscribers.begin(); it != subscribers.end(); ++it) {
-      if ((*it).second != nullptr) {
-        (*it).second->deliverEvent(event);
-      }
+    std::shared_ptr<const SubscriberSnapshot> snapshot = getSubscriberSnapshot();
+    for (const std::shared_ptr<MediaSink> &sink : snapshot->sinks) {
+      sink->deliverEvent(event);
     }
     return 0;
   }
@@ -147,6 +152,7 @@ namespace erizo {
         this->subscribers.erase(peer_id);
     }
     this->subscribers[peer_id] = subscriber_stream;
+    publishSubscriberSnapshot();
   }
 
   void OneToManyProcessor::removeSubscriber(const std::string& peer_id) {
@@ -154,6 +160,7 @@ namespace erizo {
     boost::mutex::scoped_lock lock(monitor_mutex_);
     if (this->subscribers.find(peer_id) != subscribers.end()) {
       this->subscribers.erase(peer_id);
+      publishSubscriberSnapshot();
     }
   }
 
@@ -177,6 +184,7 @@ namespace erizo {
       subscribers.erase(it++);
     }
     subscribers.clear();
+    publishSubscriberSnapshot();
     ELOG_DEBUG("ClosedAll media in this OneToMany");
   }
 
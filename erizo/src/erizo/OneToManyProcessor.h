@@ -6,7 +6,10 @@
 #define ERIZO_SRC_ERIZO_ONETOMANYPROCESSOR_H_
 
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include <future>  // NOLINT
 
 #include "./MediaDefinitions.h"
@@ -17,6 +20,14 @@ namespace erizo {
 
 class MediaStream;
 
+/**
+* Immutable view of the subscribers, rebuilt every time they change.
+*/
+struct SubscriberSnapshot {
+  std::vector<std::shared_ptr<MediaSink>> sinks;
+  std::unordered_set<uint32_t> audio_sink_ssrcs;
+};
+
 /**
 * Represents a One to Many connection.
 * Receives media from one publisher and retransmits it to every subscriber.
@@ -52,13 +63,17 @@ class OneToManyProcessor : public MediaSink, public FeedbackSink {
  private:
   typedef std::shared_ptr<MediaSink> sink_ptr;
   FeedbackSink* feedbackSink_;
+  // Media threads only load the current snapshot, monitor_mutex_ just serializes changes to subscribers
+  std::shared_ptr<const SubscriberSnapshot> subscriber_snapshot_;
 
   int deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<DataPacket> video_packet) override;
   int deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void closeAll();
-  bool isSSRCFromAudio(uint32_t ssrc);
+  std::shared_ptr<const SubscriberSnapshot> getSubscriberSnapshot() const;
+  void publishSubscriberSnapshot();
+  bool isSSRCFromAudio(const SubscriberSnapshot& snapshot, uint32_t ssrc);
   uint32_t translateAndMaybeAdaptForSimulcast(uint32_t orig_ssrc);
 };
 
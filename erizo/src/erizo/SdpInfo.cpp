@@ -441,6 +441,20 @@ namespace erizo {
     return nullptr;
   }
 
+  std::map<unsigned int, unsigned int> SdpInfo::getRtxAssociatedPTs(MediaType media) {
+    std::map<unsigned int, unsigned int> rtx_pts;
+    for (const RtpMap& rtp : payloadVector) {
+      if (rtp.encoding_name != "rtx" || rtp.media_type != media) {
+        continue;
+      }
+      auto apt = rtp.format_parameters.find(kAssociatedPt);
+      if (apt != rtp.format_parameters.end()) {
+        rtx_pts[rtp.payload_type] = std::stoul(apt->second);
+      }
+    }
+    return rtx_pts;
+  }
+
   RtpMap *SdpInfo::getCodecByName(const std::string codecName, const unsigned int clockRate) {
     for (unsigned int it = 0; it < internalPayloadVector_.size(); it++) {
       RtpMap& rtp = internalPayloadVector_[it];
@@ -979,7 +993,7 @@ namespace erizo {
         if (internal_map.encoding_name == "rtx") {
             auto parsed_apt = rtx_map.format_parameters.find(kAssociatedPt);
             auto internal_apt = internal_map.format_parameters.find(kAssociatedPt);
-            if (parsed_apt == rtx_map.format_parameters.end() &&
+            if (parsed_apt == rtx_map.format_parameters.end() ||
                 internal_apt == internal_map.format_parameters.end()) {
               continue;
             }
@@ -224,6 +224,12 @@ class SdpInfo {
   unsigned int getVideoExternalPT(unsigned int internalPT);
 
   RtpMap* getCodecByExternalPayloadType(const unsigned int payload_type);
+  /**
+   * @brief gets the negotiated RTX payload types
+   * @param media The media type of the RTX payloads
+   * @return A map from each external RTX payload type to the external payload type it protects (apt)
+   */
+  std::map<unsigned int, unsigned int> getRtxAssociatedPTs(MediaType media);
 
   void setCredentials(const std::string& username, const std::string& password, MediaType media);
 
@@ -11,8 +11,9 @@
 
 namespace erizo {
 DEFINE_LOGGER(SrtpChannel, "SrtpChannel");
-bool SrtpChannel::initialized = false;
-boost::mutex SrtpChannel::sessionMutex_;
+std::once_flag SrtpChannel::initialized_;
+constexpr int SrtpChannel::kMaxTrailerLength;
+const char* SrtpChannel::kDefaultProfile = "SRTP_AES128_CM_SHA1_80";
 
 constexpr int kKeyStringLength = 32;
 
@@ -23,6 +24,30 @@ uint8_t nibble_to_hex_char(uint8_t nibble) {
   return buf[nibble & 0xF];
 }
 
+// Master key and salt lengths are 16/14 for AES-CM, 16/12 for AES-128-GCM and 32/12 for AES-256-GCM
+static bool setCryptoPolicy(srtp_policy_t *policy, const std::string &profile, gsize *key_and_salt_length) {
+  if (profile == "SRTP_AES128_CM_SHA1_80") {
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy->rtp);
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy->rtcp);
+    *key_and_salt_length = 30;
+  } else if (profile == "SRTP_AES128_CM_SHA1_32") {
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy->rtp);
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy->rtcp);
+    *key_and_salt_length = 30;
+  } else if (profile == "SRTP_AEAD_AES_128_GCM") {
+    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy->rtp);
+    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy->rtcp);
+    *key_and_salt_length = 28;
+  } else if (profile == "SRTP_AEAD_AES_256_GCM") {
+    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy->rtp);
+    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy->rtcp);
+    *key_and_salt_length = 44;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 std::string octet_string_hex_string(const void *s, int length) {
   if (length != 16) {
     return "";
@@ -41,12 +66,11 @@ std::string octet_string_hex_string(const void *s, int length) {
 }
 
 SrtpChannel::SrtpChannel() {
-  boost::mutex::scoped_lock lock(SrtpChannel::sessionMutex_);
-  if (SrtpChannel::initialized != true) {
+  // Only the library initialization is global, sessions are set up concurrently
+  std::call_once(initialized_, [] {
     int res = srtp_init();
     ELOG_DEBUG("Initialized SRTP library %d", res);
-    SrtpChannel::initialized = true;
-  }
+  });
 
   active_ = false;
   send_session_ = NULL;
@@ -65,10 +89,12 @@ SrtpChannel::~SrtpChannel() {
   }
 }
 
-bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey) {
-  ELOG_DEBUG("Configuring srtp local key %s remote key %s", sendingKey.c_str(), receivingKey.c_str());
-  if (configureSrtpSession(&send_session_,    sendingKey,   SENDING) &&
-      configureSrtpSession(&receive_session_, receivingKey, RECEIVING)) {
+bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                               const std::string &profile) {
+  ELOG_DEBUG("Configuring srtp local key %s remote key %s profile %s", sendingKey.c_str(), receivingKey.c_str(),
+             profile.c_str());
+  if (configureSrtpSession(&send_session_,    sendingKey,   SENDING,   profile) &&
+      configureSrtpSession(&receive_session_, receivingKey, RECEIVING, profile)) {
     active_ = true;
     return active_;
   }
@@ -147,11 +173,15 @@ int SrtpChannel::unprotectRtcp(char* buffer, int *len) {
   }
 }
 
-bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type) {
+bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type,
+                                       const std::string &profile) {
   srtp_policy_t policy;
   memset(&policy, 0, sizeof(policy));
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+  gsize expected_len = 0;
+  if (!setCryptoPolicy(&policy, profile, &expected_len)) {
+    ELOG_ERROR("Unsupported SRTP profile %s", profile.c_str());
+    return false;
+  }
   if (type == SENDING) {
     policy.ssrc.type = ssrc_any_outbound;
   } else {
@@ -166,6 +196,11 @@ bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key,
 
   gsize len = 0;
   uint8_t *akey = reinterpret_cast<uint8_t*>(g_base64_decode(reinterpret_cast<const gchar*>(key.c_str()), &len));
+  if (len != expected_len) {
+    ELOG_ERROR("Wrong master key length %lu for profile %s", len, profile.c_str());
+    g_free(akey);
+    return false;
+  }
   ELOG_DEBUG("set master key/salt to %s/", octet_string_hex_string(akey, 16).c_str());
   // allocate and initialize the SRTP session
   policy.key = akey;
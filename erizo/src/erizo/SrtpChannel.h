@@ -7,8 +7,8 @@
 
 #include <netinet/in.h>
 #include <srtp2/srtp.h>
-#include <boost/thread/mutex.hpp>
 
+#include <mutex>  // NOLINT
 #include <string>
 
 #include "rtp/RtpHeaders.h"
@@ -22,10 +22,13 @@ namespace erizo {
  */
 class SrtpChannel {
   DECLARE_LOGGER();
-  static bool initialized;
-  static boost::mutex sessionMutex_;
+  static std::once_flag initialized_;
 
  public:
+  // Longest trailer added when protecting, RTCP index (4) plus the GCM tag (16)
+  static constexpr int kMaxTrailerLength = 20;
+  static const char* kDefaultProfile;
+
   /**
    * The constructor. At this point the class is only initialized but it still needs the Key pair.
    */
@@ -33,7 +36,8 @@ class SrtpChannel {
   virtual ~SrtpChannel();
   /**
    * Protects RTP Data
-   * @param buffer Pointer to the buffer with the data. The protected data is returned here
+   * @param buffer Pointer to the buffer with the data, it needs kMaxTrailerLength bytes of room after the data.
+   * The protected data is returned here
    * @param len Pointer to the length of the data. The length is returned here
    * @return 0 or an error code
    */
@@ -47,7 +51,8 @@ class SrtpChannel {
   int unprotectRtp(char* buffer, int *len);
   /**
    * Protects RTCP Data
-   * @param buffer Pointer to the buffer with the data. The protected data is returned here
+   * @param buffer Pointer to the buffer with the data, it needs kMaxTrailerLength bytes of room after the data.
+   * The protected data is returned here
    * @param len Pointer to the length of the data. The length is returned here
    * @return 0 or an error code
    */
@@ -63,9 +68,11 @@ class SrtpChannel {
    * Sets a key pair for the RTP channel
    * @param sendingKey The key for protecting data
    * @param receivingKey The key for unprotecting data
+   * @param profile The SRTP protection profile negotiated with DTLS (i.e. SRTP_AEAD_AES_128_GCM)
    * @return true if everything is ok
    */
-  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey);
+  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                    const std::string &profile = kDefaultProfile);
   /**
    * Sets a key pair for the RTCP channel
    * @param sendingKey The key for protecting data
@@ -79,7 +86,8 @@ class SrtpChannel {
     SENDING, RECEIVING
   };
 
-  bool configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type);
+  bool configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type,
+                            const std::string &profile);
 
   bool active_;
   srtp_t send_session_;
@@ -28,6 +28,11 @@ namespace erizo {
     return root_.toString();
   }
 
+  void Stats::collectValues(std::vector<StatValue> *values) {
+    std::string path;
+    root_.collectValues(&path, values);
+  }
+
   void Stats::setStatsListener(MediaStreamStatsListener* listener) {
     boost::mutex::scoped_lock lock(listener_mutex_);
     listener_ = listener;
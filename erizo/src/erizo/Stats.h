@@ -6,6 +6,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "./logger.h"
 #include "pipeline/Service.h"
@@ -29,6 +30,9 @@ class Stats : public Service {
 
   std::string getStats();
 
+  // Current numeric stats with their paths, it must run in the stream's worker
+  void collectValues(std::vector<StatValue> *values);
+
   void setStatsListener(MediaStreamStatsListener* listener);
   void sendStats();
 
@@ -1,11 +1,15 @@
 #ifndef ERIZO_SRC_ERIZO_TRANSPORT_H_
 #define ERIZO_SRC_ERIZO_TRANSPORT_H_
 
+#include <boost/thread/mutex.hpp>
+
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdio>
 #include "IceConnection.h"
 #include "thread/Worker.h"
+#include "thread/WorkerReference.h"
 #include "thread/IOWorker.h"
 #include "./logger.h"
 
@@ -36,12 +40,13 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
       std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker) :
     mediaType(med), transport_name(transport_name), rtcp_mux_(rtcp_mux), transport_listener_(transport_listener),
     connection_id_(connection_id), state_(TRANSPORT_INITIAL), iceConfig_(iceConfig), bundle_(bundle),
-    running_{true}, worker_{worker},  io_worker_{io_worker} {}
+    running_{true}, worker_{std::make_shared<WorkerReference>(worker)},  io_worker_{io_worker} {}
   virtual ~Transport() {}
   virtual void updateIceState(IceState state, IceConnection *conn) = 0;
   virtual void onIceData(packetPtr packet) = 0;
   virtual void onCandidate(const CandidateInfo &candidate, IceConnection *conn) = 0;
-  virtual void write(char* data, int len) = 0;
+  // Transports may modify the packet (i.e. protect it in place), callers must not use it afterwards
+  virtual void write(std::shared_ptr<DataPacket> packet) = 0;
   virtual void processLocalSdp(SdpInfo *localSdp_) = 0;
   virtual void start() = 0;
   virtual void close() = 0;
@@ -75,16 +80,18 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   }
 
   void onPacketReceived(packetPtr packet) {
+    {
+      // Packets arriving in a burst are handled by a single task in the worker
+      boost::mutex::scoped_lock lock(pending_packets_mutex_);
+      pending_packets_.push_back(packet);
+      if (pending_packets_.size() > 1) {
+        return;
+      }
+    }
     std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
-    worker_->task([weak_transport, packet]() {
+    worker_->task([weak_transport]() {
       if (auto this_ptr = weak_transport.lock()) {
-        if (packet->length > 0) {
-          this_ptr->onIceData(packet);
-        }
-        if (packet->length == -1) {
-          this_ptr->running_ = false;
-          return;
-        }
+        this_ptr->processPendingPackets();
       }
     });
   }
@@ -96,11 +103,38 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   }
 
   std::shared_ptr<Worker> getWorker() {
-    return worker_;
+    return worker_->get();
+  }
+
+  // Pending tasks keep their order, see WebRtcConnection::migrateTo
+  void migrateTo(std::shared_ptr<Worker> worker) {
+    worker_->moveTo(worker);
   }
 
  private:
+  void processPendingPackets() {
+    {
+      boost::mutex::scoped_lock lock(pending_packets_mutex_);
+      pending_packets_.swap(processing_packets_);
+    }
+    getWorker()->addPackets(processing_packets_.size());
+    for (const packetPtr &packet : processing_packets_) {
+      if (packet->length > 0) {
+        onIceData(packet);
+      }
+      if (packet->length == -1) {
+        // The transport failed, the rest of the batch is not processed
+        running_ = false;
+        break;
+      }
+    }
+    processing_packets_.clear();
+  }
+
   std::weak_ptr<TransportListener> transport_listener_;
+  boost::mutex pending_packets_mutex_;
+  std::vector<packetPtr> pending_packets_;
+  std::vector<packetPtr> processing_packets_;
 
  protected:
   std::string connection_id_;
@@ -108,7 +142,7 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   IceConfig iceConfig_;
   bool bundle_;
   bool running_;
-  std::shared_ptr<Worker> worker_;
+  std::shared_ptr<WorkerReference> worker_;
   std::shared_ptr<IOWorker> io_worker_;
 };
 }  // namespace erizo
@@ -37,6 +37,7 @@
 #include "rtp/PliPacerHandler.h"
 #include "rtp/RtpPaddingGeneratorHandler.h"
 #include "rtp/RtpUtils.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
 namespace erizo {
 DEFINE_LOGGER(WebRtcConnection, "WebRtcConnection");
@@ -47,9 +48,13 @@ WebRtcConnection::WebRtcConnection(std::shared_ptr<Worker> worker, std::shared_p
     connection_id_{connection_id},
     audio_enabled_{false}, video_enabled_{false}, bundle_{false}, conn_event_listener_{listener},
     ice_config_{ice_config}, rtp_mappings_{rtp_mappings}, extension_processor_{ext_mappings},
-    worker_{worker}, io_worker_{io_worker},
+    worker_{std::make_shared<WorkerReference>(worker)}, io_worker_{io_worker},
     remote_sdp_{std::make_shared<SdpInfo>(rtp_mappings)}, local_sdp_{std::make_shared<SdpInfo>(rtp_mappings)},
-    audio_muted_{false}, video_muted_{false}, first_remote_sdp_processed_{false}
+    audio_muted_{false}, video_muted_{false}, first_remote_sdp_processed_{false},
+    feedback_scheduled_{false}, feedback_packet_type_{VIDEO_PACKET},
+    pacer_{[this] (std::shared_ptr<DataPacket> packet) { sendPacket(std::move(packet)); },
+           [this] (uint32_t bytes) { requestPadding(bytes); }},
+    pacer_scheduled_{false}
     {
   ELOG_INFO("%s message: constructor, stunserver: %s, stunPort: %d, minPort: %d, maxPort: %d",
       toLog(), ice_config.stun_server.c_str(), ice_config.stun_port, ice_config.min_port, ice_config.max_port);
@@ -75,6 +80,7 @@ void WebRtcConnection::syncClose() {
   }
   sending_ = false;
   media_streams_.clear();
+  syncUpdateSsrcRoutes();
   if (video_transport_.get()) {
     video_transport_->close();
   }
@@ -137,6 +143,7 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
                  toLog(), media_stream->getId(), media_stream->getAudioSinkSSRC());
       if (!video_ssrc_list.empty()) {
         local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+        updateLocalRtxSsrcs(media_stream);
       }
     }
     if (audio_enabled_) {
@@ -151,7 +158,7 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
   if (bundle_) {
     if (video_transport_.get() == nullptr && (video_enabled_ || audio_enabled_)) {
       video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                              listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                              listener, ice_config_ , "", "", true, getWorker(), io_worker_));
       video_transport_->copyLogContextFrom(*this);
       video_transport_->start();
     }
@@ -159,13 +166,13 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
     if (video_transport_.get() == nullptr && video_enabled_) {
       // For now we don't re/check transports, if they are already created we leave them there
       video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                              listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                              listener, ice_config_ , "", "", true, getWorker(), io_worker_));
       video_transport_->copyLogContextFrom(*this);
       video_transport_->start();
     }
     if (audio_transport_.get() == nullptr && audio_enabled_) {
       audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, true,
-                                              listener, ice_config_, "", "", true, worker_, io_worker_));
+                                              listener, ice_config_, "", "", true, getWorker(), io_worker_));
       audio_transport_->copyLogContextFrom(*this);
       audio_transport_->start();
     }
@@ -181,6 +188,8 @@ std::shared_ptr<std::promise<void>> WebRtcConnection::addMediaStream(std::shared
   return asyncTask([media_stream] (std::shared_ptr<WebRtcConnection> connection) {
     ELOG_DEBUG("%s message: Adding mediaStream, id: %s", connection->toLog(), media_stream->getId().c_str());
     connection->media_streams_.push_back(media_stream);
+    connection->syncUpdateSsrcRoutes();
+    connection->updatePacerBitrates();
   });
 }
 
@@ -197,6 +206,7 @@ std::shared_ptr<std::promise<void>> WebRtcConnection::removeMediaStream(const st
           if (video_it != connection->local_sdp_->video_ssrc_map.end()) {
             connection->local_sdp_->video_ssrc_map.erase(video_it);
           }
+          connection->local_sdp_->video_rtx_ssrc_map.erase(stream->getLabel());
           auto audio_it = connection->local_sdp_->audio_ssrc_map.find(stream->getLabel());
           if (audio_it != connection->local_sdp_->audio_ssrc_map.end()) {
             connection->local_sdp_->audio_ssrc_map.erase(audio_it);
@@ -204,13 +214,66 @@ std::shared_ptr<std::promise<void>> WebRtcConnection::removeMediaStream(const st
         }
         return isStream;
       }));
+    connection->syncUpdateSsrcRoutes();
+    connection->stream_bandwidth_estimates_.erase(stream_id);
+    connection->stream_padding_bitrates_.erase(stream_id);
+    connection->updatePacerBitrates();
     });
 }
 
+std::shared_ptr<std::promise<void>> WebRtcConnection::migrateTo(std::shared_ptr<Worker> new_worker) {
+  return asyncTask([new_worker] (std::shared_ptr<WebRtcConnection> connection) {
+    std::shared_ptr<Worker> old_worker = connection->getWorker();
+    if (old_worker == new_worker) {
+      return;
+    }
+    ELOG_DEBUG("%s message: Migrating connection to another worker", connection->toLog());
+    connection->worker_->moveTo(new_worker);
+    if (connection->video_transport_) {
+      connection->video_transport_->migrateTo(new_worker);
+    }
+    if (connection->audio_transport_) {
+      connection->audio_transport_->migrateTo(new_worker);
+    }
+    connection->forEachMediaStream([new_worker] (const std::shared_ptr<MediaStream> &media_stream) {
+      media_stream->migrateTo(new_worker);
+    });
+  });
+}
+
 void WebRtcConnection::forEachMediaStream(std::function<void(const std::shared_ptr<MediaStream>&)> func) {
   std::for_each(media_streams_.begin(), media_streams_.end(), func);
 }
 
+void WebRtcConnection::updateSsrcRoutes() {
+  asyncTask([] (std::shared_ptr<WebRtcConnection> connection) {
+    connection->syncUpdateSsrcRoutes();
+  });
+}
+
+void WebRtcConnection::syncUpdateSsrcRoutes() {
+  rtp_ssrc_routes_.clear();
+  rtcp_ssrc_routes_.clear();
+  forEachMediaStream([this] (const std::shared_ptr<MediaStream> &media_stream) {
+    std::vector<uint32_t> ssrcs = media_stream->getVideoSourceSSRCList();
+    ssrcs.push_back(media_stream->getAudioSourceSSRC());
+    ssrcs.push_back(media_stream->getVideoSinkSSRC());
+    ssrcs.push_back(media_stream->getAudioSinkSSRC());
+    std::sort(ssrcs.begin(), ssrcs.end());
+    ssrcs.erase(std::unique(ssrcs.begin(), ssrcs.end()), ssrcs.end());
+    for (uint32_t ssrc : ssrcs) {
+      rtp_ssrc_routes_[ssrc].push_back(media_stream);
+      rtcp_ssrc_routes_[ssrc].push_back(media_stream);
+    }
+    // RTX packets are restored by the stream, but RTCP about the RTX stream is not forwarded
+    for (const auto &rtx_ssrc : media_stream->getVideoSourceRtxSSRCMap()) {
+      if (std::find(ssrcs.begin(), ssrcs.end(), rtx_ssrc.first) == ssrcs.end()) {
+        rtp_ssrc_routes_[rtx_ssrc.first].push_back(media_stream);
+      }
+    }
+  });
+}
+
 boost::future<void> WebRtcConnection::forEachMediaStreamAsync(
     std::function<void(const std::shared_ptr<MediaStream>&)> func) {
   std::vector<boost::future<void>> futures;
@@ -257,6 +320,16 @@ void WebRtcConnection::copyDataToLocalSdpIndo(std::shared_ptr<SdpInfo> sdp_info)
   });
 }
 
+void WebRtcConnection::updateLocalRtxSsrcs(const std::shared_ptr<MediaStream> &media_stream) {
+  uint32_t rtx_ssrc = media_stream->getVideoSinkRtxSSRC();
+  if (rtx_ssrc == 0) {
+    return;
+  }
+  std::map<uint32_t, uint32_t> rtx_ssrc_map;
+  rtx_ssrc_map[media_stream->getVideoSinkSSRC()] = rtx_ssrc;
+  local_sdp_->video_rtx_ssrc_map[media_stream->getLabel()] = rtx_ssrc_map;
+}
+
 std::shared_ptr<SdpInfo> WebRtcConnection::getLocalSdpInfo() {
   boost::mutex::scoped_lock lock(update_state_mutex_);
   ELOG_DEBUG("%s message: getting local SDPInfo", toLog());
@@ -273,6 +346,7 @@ std::shared_ptr<SdpInfo> WebRtcConnection::getLocalSdpInfo() {
                toLog(), media_stream->getId(), media_stream->getAudioSinkSSRC());
     if (!video_ssrc_list.empty()) {
       local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+      updateLocalRtxSsrcs(media_stream);
     }
     if (media_stream->getAudioSinkSSRC() != kDefaultAudioSinkSSRC && media_stream->getAudioSinkSSRC() != 0) {
       local_sdp_->audio_ssrc_map[media_stream->getLabel()] = media_stream->getAudioSinkSSRC();
@@ -327,6 +401,7 @@ boost::future<void> WebRtcConnection::setRemoteSdpsToMediaStreams(std::vector<st
   return forEachMediaStreamAsync([weak_this, stream_ids](std::shared_ptr<MediaStream> media_stream) {
     if (auto connection = weak_this.lock()) {
           media_stream->setRemoteSdp(connection->remote_sdp_);
+          connection->updateSsrcRoutes();
           ELOG_DEBUG("%s message: setting remote SDP to stream, stream: %s",
             connection->toLog(), media_stream->getId());
           auto stream_it = std::find(stream_ids.begin(), stream_ids.end(), media_stream->getId());
@@ -377,7 +452,7 @@ boost::future<void> WebRtcConnection::processRemoteSdp(std::vector<std::string>
                       toLog(), username.c_str(), password.c_str());
           video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_ , username, password, false,
-                                                  worker_, io_worker_));
+                                                  getWorker(), io_worker_));
           video_transport_->copyLogContextFrom(*this);
           video_transport_->start();
         } else {
@@ -394,7 +469,7 @@ boost::future<void> WebRtcConnection::processRemoteSdp(std::vector<std::string>
                       toLog(), username.c_str(), password.c_str());
           audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_, username, password, false,
-                                                  worker_, io_worker_));
+                                                  getWorker(), io_worker_));
           audio_transport_->copyLogContextFrom(*this);
           audio_transport_->start();
         } else {
@@ -541,22 +616,135 @@ void WebRtcConnection::onREMBFromTransport(RtcpHeader *chead, Transport *transpo
   distributor_->distribute(chead->getREMBBitRate(), chead->getSSRC(), streams, transport);
 }
 
+void WebRtcConnection::onTransportFeedbackFromTransport(RtcpHeader *chead, Transport *transport) {
+  size_t length = (ntohs(chead->length) + 1) * 4;
+  std::unique_ptr<webrtc::rtcp::TransportFeedback> feedback =
+    webrtc::rtcp::TransportFeedback::ParseFrom(reinterpret_cast<uint8_t*>(chead), length);
+  if (!feedback || !delay_based_bwe_.onTransportFeedback(*feedback)) {
+    return;
+  }
+  // The estimate is transport-wide, so it is shared among the streams the same way REMB is
+  std::vector<std::shared_ptr<MediaStream>> streams;
+  forEachMediaStream([&streams] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (media_stream->getVideoSinkSSRC() != 0 && !media_stream->isPublisher()) {
+      streams.push_back(media_stream);
+    }
+  });
+  if (streams.empty()) {
+    return;
+  }
+  distributor_->distribute(delay_based_bwe_.getEstimate(), chead->getSSRC(), streams, transport);
+}
+
+void WebRtcConnection::onTransportSequenceNumber(uint16_t sequence_number, uint32_t ssrc) {
+  uint32_t sender_ssrc = 0;
+  auto route_it = rtcp_ssrc_routes_.find(ssrc);
+  if (route_it != rtcp_ssrc_routes_.end()) {
+    for (const std::shared_ptr<MediaStream> &media_stream : route_it->second) {
+      if (media_stream->isSourceSSRC(ssrc)) {
+        sender_ssrc = media_stream->getVideoSinkSSRC();
+        feedback_packet_type_ = media_stream->isVideoSourceSSRC(ssrc) ? VIDEO_PACKET : AUDIO_PACKET;
+      }
+    }
+  }
+  feedback_generator_.onPacketReceived(sequence_number, ssrc, sender_ssrc);
+  if (!feedback_scheduled_) {
+    scheduleTransportFeedback();
+  }
+}
+
+void WebRtcConnection::scheduleTransportFeedback() {
+  feedback_scheduled_ = true;
+  std::weak_ptr<WebRtcConnection> weak_this = shared_from_this();
+  getWorker()->scheduleFromNow([weak_this] {
+    if (auto connection = weak_this.lock()) {
+      // Posted again in case the connection has been migrated to another worker in the meantime
+      connection->asyncTask([] (std::shared_ptr<WebRtcConnection> this_ptr) {
+        this_ptr->sendTransportFeedback();
+      });
+    }
+  }, TransportFeedbackGenerator::kFeedbackInterval);
+}
+
+void WebRtcConnection::sendTransportFeedback() {
+  feedback_scheduled_ = false;
+  std::shared_ptr<DataPacket> feedback = feedback_generator_.generateFeedback();
+  if (feedback) {
+    feedback->type = feedback_packet_type_;
+    syncWrite(feedback);
+  }
+  if (feedback_generator_.hasPendingPackets()) {
+    scheduleTransportFeedback();
+  }
+}
+
 void WebRtcConnection::onRtcpFromTransport(std::shared_ptr<DataPacket> packet, Transport *transport) {
-  RtpUtils::forEachRtcpBlock(packet, [this, packet, transport](RtcpHeader *chead) {
-    uint32_t ssrc = chead->isFeedback() ? chead->getSourceSSRC() : chead->getSSRC();
+  // Blocks of the compound packet are grouped by destination, so each stream gets a single packet with its blocks.
+  // Feedback and sender blocks are not mixed because MediaStream dispatches them by their first block.
+  std::vector<RtcpBlock> blocks;
+  std::vector<RtcpDestination> destinations;
+  RtpUtils::forEachRtcpBlock(packet, [this, packet, transport, &blocks, &destinations](RtcpHeader *chead) {
+    int offset = reinterpret_cast<char*>(chead) - packet->data;
+    int length = (ntohs(chead->length) + 1) * 4;
+    if (offset + length > packet->length) {
+      return;
+    }
     if (chead->isREMB()) {
       onREMBFromTransport(chead, transport);
       return;
     }
-    std::shared_ptr<DataPacket> rtcp = std::make_shared<DataPacket>(*packet);
-    rtcp->length = (ntohs(chead->length) + 1) * 4;
-    std::memcpy(rtcp->data, chead, rtcp->length);
-    forEachMediaStream([rtcp, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(rtcp, transport);
+    if (chead->isTransportFeedback()) {
+      onTransportFeedbackFromTransport(chead, transport);
+      return;
+    }
+    uint32_t ssrc = chead->isFeedback() ? chead->getSourceSSRC() : chead->getSSRC();
+    auto route_it = rtcp_ssrc_routes_.find(ssrc);
+    if (route_it == rtcp_ssrc_routes_.end()) {
+      return;
+    }
+    bool is_feedback = chead->isFeedback();
+    blocks.push_back(RtcpBlock{offset, length, route_it->second.size()});
+    for (const std::shared_ptr<MediaStream> &media_stream : route_it->second) {
+      auto destination_it = std::find_if(destinations.begin(), destinations.end(),
+        [&media_stream, is_feedback, ssrc] (const RtcpDestination &destination) {
+          return destination.media_stream == media_stream && destination.is_feedback == is_feedback &&
+            (is_feedback || destination.ssrc == ssrc);
+        });
+      if (destination_it == destinations.end()) {
+        destinations.push_back(RtcpDestination{media_stream, is_feedback, ssrc, {}});
+        destination_it = destinations.end() - 1;
       }
-    });
+      destination_it->blocks.push_back(blocks.size() - 1);
+    }
   });
+
+  for (const RtcpDestination &destination : destinations) {
+    destination.media_stream->onTransportData(makeRtcpPacket(packet, blocks, destination.blocks), transport);
+  }
+}
+
+std::shared_ptr<DataPacket> WebRtcConnection::makeRtcpPacket(std::shared_ptr<DataPacket> packet,
+    const std::vector<RtcpBlock> &blocks, const std::vector<size_t> &block_indexes) {
+  const RtcpBlock &first_block = blocks[block_indexes.front()];
+  int length = first_block.length;
+  bool can_be_shared = first_block.destinations == 1;
+  for (size_t i = 1; i < block_indexes.size(); i++) {
+    const RtcpBlock &block = blocks[block_indexes[i]];
+    can_be_shared = can_be_shared && block.destinations == 1 && block.offset == first_block.offset + length;
+    length += block.length;
+  }
+  // Contiguous blocks that nobody else receives are passed as a view of the original buffer
+  if (can_be_shared) {
+    return packet->slice(first_block.offset, length);
+  }
+  auto rtcp = std::make_shared<DataPacket>(packet->comp, packet->data + first_block.offset, first_block.length,
+                                           packet->type, packet->received_time_ms);
+  for (size_t i = 1; i < block_indexes.size(); i++) {
+    const RtcpBlock &block = blocks[block_indexes[i]];
+    std::memcpy(rtcp->data + rtcp->length, packet->data + block.offset, block.length);
+    rtcp->length += block.length;
+  }
+  return rtcp;
 }
 
 void WebRtcConnection::onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) {
@@ -571,11 +759,20 @@ void WebRtcConnection::onTransportData(std::shared_ptr<DataPacket> packet, Trans
   } else {
     RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
     uint32_t ssrc = head->getSSRC();
-    forEachMediaStream([packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(packet, transport);
-      }
-    });
+    uint16_t transport_sequence_number;
+    if (extension_processor_.getTransportSequenceNumber(packet, &transport_sequence_number)) {
+      onTransportSequenceNumber(transport_sequence_number, ssrc);
+    }
+    auto route_it = rtp_ssrc_routes_.find(ssrc);
+    if (route_it == rtp_ssrc_routes_.end()) {
+      return;
+    }
+    // Streams modify the packets they receive, only the last one gets the original
+    const std::vector<std::shared_ptr<MediaStream>> &media_streams = route_it->second;
+    for (size_t i = 0; i + 1 < media_streams.size(); i++) {
+      media_streams[i]->onTransportData(std::make_shared<DataPacket>(*packet), transport);
+    }
+    media_streams.back()->onTransportData(std::move(packet), transport);
   }
 }
 
@@ -753,6 +950,22 @@ void WebRtcConnection::write(std::shared_ptr<DataPacket> packet) {
 }
 
 void WebRtcConnection::syncWrite(std::shared_ptr<DataPacket> packet) {
+  if (!sending_) {
+    return;
+  }
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (chead->isRtcp()) {
+    sendPacket(std::move(packet));
+    return;
+  }
+  pacer_.enqueue(std::move(packet));
+  pacer_.process();
+  if (pacer_.hasPendingWork()) {
+    schedulePacer();
+  }
+}
+
+void WebRtcConnection::sendPacket(std::shared_ptr<DataPacket> packet) {
   if (!sending_) {
     return;
   }
@@ -761,7 +974,89 @@ void WebRtcConnection::syncWrite(std::shared_ptr<DataPacket> packet) {
     return;
   }
   this->extension_processor_.processRtpExtensions(packet);
-  transport->write(packet->data, packet->length);
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  uint16_t transport_sequence_number;
+  if (!chead->isRtcp() && extension_processor_.stampTransportSequenceNumber(packet, &transport_sequence_number)) {
+    delay_based_bwe_.onPacketSent(transport_sequence_number, packet->length);
+  }
+  transport->write(std::move(packet));
+}
+
+void WebRtcConnection::setStreamBandwidthEstimate(const std::string& stream_id, uint64_t bitrate) {
+  asyncTask([stream_id, bitrate] (std::shared_ptr<WebRtcConnection> connection) {
+    connection->stream_bandwidth_estimates_[stream_id] = bitrate;
+    connection->updatePacerBitrates();
+  });
+}
+
+void WebRtcConnection::setStreamPaddingBitrate(const std::string& stream_id, uint64_t bitrate) {
+  asyncTask([stream_id, bitrate] (std::shared_ptr<WebRtcConnection> connection) {
+    connection->stream_padding_bitrates_[stream_id] = bitrate;
+    connection->updatePacerBitrates();
+  });
+}
+
+void WebRtcConnection::updatePacerBitrates() {
+  uint64_t estimated_bitrate = 0;
+  uint64_t padding_bitrate = 0;
+  forEachMediaStream([this, &estimated_bitrate, &padding_bitrate] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (media_stream->isPublisher()) {
+      return;
+    }
+    auto estimate_it = stream_bandwidth_estimates_.find(media_stream->getId());
+    estimated_bitrate += estimate_it != stream_bandwidth_estimates_.end() ? estimate_it->second : Pacer::kStartBitrate;
+    auto padding_it = stream_padding_bitrates_.find(media_stream->getId());
+    if (padding_it != stream_padding_bitrates_.end()) {
+      padding_bitrate += padding_it->second;
+    }
+  });
+  pacer_.setEstimatedBitrate(estimated_bitrate > 0 ? estimated_bitrate : Pacer::kStartBitrate);
+  pacer_.setPaddingBitrate(padding_bitrate);
+  if (pacer_.hasPendingWork()) {
+    schedulePacer();
+  }
+}
+
+void WebRtcConnection::schedulePacer() {
+  if (pacer_scheduled_) {
+    return;
+  }
+  pacer_scheduled_ = true;
+  std::weak_ptr<WebRtcConnection> weak_this = shared_from_this();
+  getWorker()->scheduleFromNow([weak_this] {
+    if (auto connection = weak_this.lock()) {
+      connection->asyncTask([] (std::shared_ptr<WebRtcConnection> this_ptr) {
+        this_ptr->processPacer();
+      });
+    }
+  }, Pacer::kProcessInterval);
+}
+
+void WebRtcConnection::processPacer() {
+  pacer_scheduled_ = false;
+  pacer_.process();
+  if (pacer_.hasPendingWork()) {
+    schedulePacer();
+  }
+}
+
+void WebRtcConnection::requestPadding(uint32_t bytes) {
+  uint64_t total_padding_bitrate = 0;
+  for (const auto &padding_bitrate : stream_padding_bitrates_) {
+    total_padding_bitrate += padding_bitrate.second;
+  }
+  if (total_padding_bitrate == 0) {
+    return;
+  }
+  // Each stream generates its share of padding with its own sequence numbers, it gets back to the Pacer later
+  forEachMediaStream([this, bytes, total_padding_bitrate] (const std::shared_ptr<MediaStream> &media_stream) {
+    auto padding_it = stream_padding_bitrates_.find(media_stream->getId());
+    if (padding_it == stream_padding_bitrates_.end() || padding_it->second == 0) {
+      return;
+    }
+    uint32_t stream_bytes = bytes * padding_it->second / total_padding_bitrate;
+    media_stream->deliverEvent(std::make_shared<PaddingRequestEvent>(stream_bytes));
+  });
 }
 
 void WebRtcConnection::setTransport(std::shared_ptr<Transport> transport) {  // Only for Testing purposes
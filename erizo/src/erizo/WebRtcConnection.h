@@ -7,6 +7,7 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "./logger.h"
@@ -17,9 +18,13 @@
 #include "bandwidth/BandwidthDistributionAlgorithm.h"
 #include "pipeline/Pipeline.h"
 #include "thread/Worker.h"
+#include "thread/WorkerReference.h"
 #include "thread/IOWorker.h"
 #include "rtp/RtcpProcessor.h"
 #include "rtp/RtpExtensionProcessor.h"
+#include "rtp/TransportFeedbackGenerator.h"
+#include "rtp/DelayBasedBandwidthEstimator.h"
+#include "rtp/Pacer.h"
 #include "lib/Clock.h"
 #include "pipeline/Handler.h"
 #include "pipeline/Service.h"
@@ -136,6 +141,10 @@ class WebRtcConnection: public TransportListener, public LogContext,
   void write(std::shared_ptr<DataPacket> packet);
   void syncWrite(std::shared_ptr<DataPacket> packet);
 
+  // Streams report their estimates and the padding they want so the Pacer can share the connection among them
+  void setStreamBandwidthEstimate(const std::string& stream_id, uint64_t bitrate);
+  void setStreamPaddingBitrate(const std::string& stream_id, uint64_t bitrate);
+
   std::shared_ptr<std::promise<void>> asyncTask(std::function<void(std::shared_ptr<WebRtcConnection>)> f);
 
   bool isAudioMuted() { return audio_muted_; }
@@ -145,6 +154,10 @@ class WebRtcConnection: public TransportListener, public LogContext,
   std::shared_ptr<std::promise<void>> removeMediaStream(const std::string& stream_id);
   void forEachMediaStream(std::function<void(const std::shared_ptr<MediaStream>&)> func);
   boost::future<void> forEachMediaStreamAsync(std::function<void(const std::shared_ptr<MediaStream>&)> func);
+  /**
+   * Rebuilds the SSRC routing tables, it has to be called whenever the SSRCs of a MediaStream change.
+   */
+  void updateSsrcRoutes();
 
   void setTransport(std::shared_ptr<Transport> transport);  // Only for Testing purposes
 
@@ -152,21 +165,51 @@ class WebRtcConnection: public TransportListener, public LogContext,
 
   RtpExtensionProcessor& getRtpExtensionProcessor() { return extension_processor_; }
 
-  std::shared_ptr<Worker> getWorker() { return worker_; }
+  std::shared_ptr<Worker> getWorker() { return worker_->get(); }
+  /**
+   * Moves the connection, its transports and its MediaStreams to another worker. No worker waits, tasks posted
+   * meanwhile are held until the old worker has run the ones it already had.
+   */
+  std::shared_ptr<std::promise<void>> migrateTo(std::shared_ptr<Worker> new_worker);
 
   inline std::string toLog() {
     return "id: " + connection_id_ + ", " + printLogContext();
   }
 
  private:
+  struct RtcpBlock {
+    int offset;
+    int length;
+    size_t destinations;
+  };
+  struct RtcpDestination {
+    std::shared_ptr<MediaStream> media_stream;
+    bool is_feedback;
+    uint32_t ssrc;
+    std::vector<size_t> blocks;
+  };
+
   bool createOfferSync(bool video_enabled, bool audio_enabled, bool bundle);
   boost::future<void> processRemoteSdp(std::vector<std::string> stream_ids);
   boost::future<void> setRemoteSdpsToMediaStreams(std::vector<std::string> stream_ids);
   void onRemoteSdpsSetToMediaStreams(std::string stream_id);
+  void updateLocalRtxSsrcs(const std::shared_ptr<MediaStream> &media_stream);
   std::string getJSONCandidate(const std::string& mid, const std::string& sdp);
   void trackTransportInfo();
   void onRtcpFromTransport(std::shared_ptr<DataPacket> packet, Transport *transport);
+  std::shared_ptr<DataPacket> makeRtcpPacket(std::shared_ptr<DataPacket> packet, const std::vector<RtcpBlock> &blocks,
+                                             const std::vector<size_t> &block_indexes);
   void onREMBFromTransport(RtcpHeader *chead, Transport *transport);
+  void onTransportFeedbackFromTransport(RtcpHeader *chead, Transport *transport);
+  void onTransportSequenceNumber(uint16_t sequence_number, uint32_t ssrc);
+  void syncUpdateSsrcRoutes();
+  void scheduleTransportFeedback();
+  void sendTransportFeedback();
+  void sendPacket(std::shared_ptr<DataPacket> packet);
+  void updatePacerBitrates();
+  void schedulePacer();
+  void processPacer();
+  void requestPadding(uint32_t bytes);
   void maybeNotifyWebRtcConnectionEvent(const WebRTCEvent& event, const std::string& message,
         const std::string& stream_id = "");
 
@@ -194,9 +237,13 @@ class WebRtcConnection: public TransportListener, public LogContext,
   boost::mutex update_state_mutex_;
   boost::mutex event_listener_mutex_;
 
-  std::shared_ptr<Worker> worker_;
+  std::shared_ptr<WorkerReference> worker_;
   std::shared_ptr<IOWorker> io_worker_;
   std::vector<std::shared_ptr<MediaStream>> media_streams_;
+  // Streams by the SSRCs they send or receive. They are only used from the worker, so they are read without locks
+  using SsrcRoutes = std::unordered_map<uint32_t, std::vector<std::shared_ptr<MediaStream>>>;
+  SsrcRoutes rtp_ssrc_routes_;
+  SsrcRoutes rtcp_ssrc_routes_;
   std::shared_ptr<SdpInfo> remote_sdp_;
   std::shared_ptr<SdpInfo> local_sdp_;
   bool audio_muted_;
@@ -204,6 +251,14 @@ class WebRtcConnection: public TransportListener, public LogContext,
   bool first_remote_sdp_processed_;
 
   std::unique_ptr<BandwidthDistributionAlgorithm> distributor_;
+  TransportFeedbackGenerator feedback_generator_;
+  DelayBasedBandwidthEstimator delay_based_bwe_;
+  bool feedback_scheduled_;
+  packetType feedback_packet_type_;
+  Pacer pacer_;
+  bool pacer_scheduled_;
+  std::map<std::string, uint64_t> stream_bandwidth_estimates_;
+  std::map<std::string, uint64_t> stream_padding_bitrates_;
 };
 
 }  // namespace erizo
@@ -12,6 +12,7 @@ extern "C" {
 #include <openssl/crypto.h>
 #include <openssl/ssl.h>
 #include <openssl/bn.h>
+#include <openssl/ec.h>
 #include <openssl/srtp.h>
 #include <openssl/opensslv.h>
 
@@ -19,22 +20,46 @@ extern "C" {
 
 #include <iostream>
 #include <cassert>
+#include <mutex>  // NOLINT
 #include <string>
 #include <cstring>
+#include <vector>
 
 #include "./DtlsSocket.h"
 #include "./bf_dwrap.h"
 
+using dtls::DtlsHandshakeStats;
 using dtls::DtlsSocketContext;
 using dtls::DtlsSocket;
 using std::memcpy;
 
+#ifdef SRTP_AEAD_AES_128_GCM
+// GCM is preferred, it is much cheaper than AES-CM + HMAC-SHA1 with AES-NI
+const char* DtlsSocketContext::DefaultSrtpProfile =
+    "SRTP_AEAD_AES_128_GCM:SRTP_AEAD_AES_256_GCM:SRTP_AES128_CM_SHA1_80";
+#else
 const char* DtlsSocketContext::DefaultSrtpProfile = "SRTP_AES128_CM_SHA1_80";
+#endif
 
 X509 *DtlsSocketContext::mCert = NULL;
 EVP_PKEY *DtlsSocketContext::privkey = NULL;
-
-static const int KEY_LENGTH = 1024;
+SSL_CTX *DtlsSocketContext::sharedContext = NULL;
+std::atomic<uint64_t> DtlsSocketContext::handshakesCompleted{0};
+std::atomic<uint64_t> DtlsSocketContext::handshakesFailed{0};
+std::atomic<uint64_t> DtlsSocketContext::handshakeTotalTimeMs{0};
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+// OpenSSL < 1.1 needs locking callbacks to use the shared SSL_CTX from several threads
+static std::vector<std::mutex> *sslMutexes = NULL;
+
+static void sslLockingCallback(int mode, int n, const char *file, int line) {
+  if (mode & CRYPTO_LOCK) {
+    (*sslMutexes)[n].lock();
+  } else {
+    (*sslMutexes)[n].unlock();
+  }
+}
+#endif
 
 DEFINE_LOGGER(DtlsSocketContext, "dtls.DtlsSocketContext");
 log4cxx::LoggerPtr sslLogger(log4cxx::Logger::getLogger("dtls.SSL"));
@@ -127,29 +152,27 @@ int SSLVerifyCallback(int ok, X509_STORE_CTX* store) {
   return ok;
 }
 
-int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCert, EVP_PKEY*& outKey) {  // NOLINT
+int createCert(const std::string& pAor, int expireDays, X509*& outCert, EVP_PKEY*& outKey) {  // NOLINT
   std::ostringstream info;
   info << "Generating new user cert for" << pAor;
   ELOG_DEBUG2(sslLogger, "%s", info.str().c_str());
   std::string aor = "sip:" + pAor;
 
   // Make sure that necessary algorithms exist:
-  assert(EVP_sha1());
+  assert(EVP_sha256());
 
   EVP_PKEY* privkey = EVP_PKEY_new();
   assert(privkey);
 
-  RSA* rsa = RSA_new();
-
-  BIGNUM* exponent = BN_new();
-  BN_set_word(exponent, 0x10001);
-
-  RSA_generate_key_ex(rsa, KEY_LENGTH, exponent, NULL);
+  // ECDSA P-256 keys are much cheaper to sign the handshake with than RSA ones
+  EC_KEY* ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+  assert(ec_key);    // couldn't make key pair
+  EC_KEY_set_asn1_flag(ec_key, OPENSSL_EC_NAMED_CURVE);
 
-  // RSA* rsa = RSA_generate_key(keyLen, RSA_F4, NULL, NULL);
-  assert(rsa);    // couldn't make key pair
+  int ret = EC_KEY_generate_key(ec_key);
+  assert(ret);
 
-  int ret = EVP_PKEY_set1_RSA(privkey, rsa);
+  ret = EVP_PKEY_assign_EC_KEY(privkey, ec_key);
   assert(ret);
 
   X509* cert = X509_new();
@@ -202,7 +225,7 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
 
     // TODO(javier) add extensions NID_subject_key_identifier and NID_authority_key_identifier
 
-    ret = X509_sign(cert, privkey, EVP_sha1());
+    ret = X509_sign(cert, privkey, EVP_sha256());
     assert(ret);
 
     outCert = cert;
@@ -215,42 +238,57 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
   DtlsSocketContext::DtlsSocketContext() {
     started = false;
 
+    // All the sockets use the context created once by Init()
+    Init();
+    mContext = sharedContext;
+
+    ELOG_DEBUG("DtlsSocketContext created");
+  }
+
+  SSL_CTX* DtlsSocketContext::createSSLContext() {
     ELOG_DEBUG("Creating Dtls factory, Openssl v %s", OPENSSL_VERSION_TEXT);
 
-    mContext = SSL_CTX_new(DTLSv1_method());
-    assert(mContext);
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    // Negotiates DTLS 1.2, or 1.0 with older peers
+    SSL_CTX* context = SSL_CTX_new(DTLS_method());
+#else
+    SSL_CTX* context = SSL_CTX_new(DTLSv1_method());
+#endif
+    assert(context);
 
-    int r = SSL_CTX_use_certificate(mContext, mCert);
+    int r = SSL_CTX_use_certificate(context, mCert);
     assert(r == 1);
 
-    r = SSL_CTX_use_PrivateKey(mContext, privkey);
+    r = SSL_CTX_use_PrivateKey(context, privkey);
     assert(r == 1);
 
-    SSL_CTX_set_cipher_list(mContext, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+    SSL_CTX_set_cipher_list(context, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L && OPENSSL_VERSION_NUMBER < 0x10100000L
+    SSL_CTX_set_ecdh_auto(context, 1);
+#endif
 
-    SSL_CTX_set_info_callback(mContext, SSLInfoCallback);
+    SSL_CTX_set_info_callback(context, SSLInfoCallback);
 
-    SSL_CTX_set_verify(mContext, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+    SSL_CTX_set_verify(context, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
       SSLVerifyCallback);
 
-    SSL_CTX_set_options(mContext, SSL_OP_NO_QUERY_MTU);
-      // SSL_CTX_set_session_cache_mode(mContext, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(context, SSL_OP_NO_QUERY_MTU);
+    // Sessions are never resumed, a cache would only add contention between sockets
+    SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
       // SSL_CTX_set_options(mContext, SSL_OP_NO_TICKET);
       // Set SRTP profiles
-    r = SSL_CTX_set_tlsext_use_srtp(mContext, DefaultSrtpProfile);
+    r = SSL_CTX_set_tlsext_use_srtp(context, DefaultSrtpProfile);
     assert(r == 0);
 
-    SSL_CTX_set_verify_depth(mContext, 2);
-    SSL_CTX_set_read_ahead(mContext, 1);
-
-    ELOG_DEBUG("DtlsSocketContext created");
+    SSL_CTX_set_verify_depth(context, 2);
+    SSL_CTX_set_read_ahead(context, 1);
+    return context;
   }
 
     DtlsSocketContext::~DtlsSocketContext() {
       mSocket->close();
       delete mSocket;
       mSocket = NULL;
-      SSL_CTX_free(mContext);
     }
 
     void DtlsSocketContext::close() {
@@ -258,13 +296,21 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
     }
 
     void DtlsSocketContext::Init() {
-      if (DtlsSocketContext::mCert == NULL) {
+      static std::once_flag initialized;
+      std::call_once(initialized, [] {
         OpenSSL_add_all_algorithms();
         SSL_library_init();
         SSL_load_error_strings();
         ERR_load_crypto_strings();
-        createCert("sip:licode@lynckia.com", 365, 1024, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
-      }
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+        if (CRYPTO_get_locking_callback() == NULL) {
+          sslMutexes = new std::vector<std::mutex>(CRYPTO_num_locks());
+          CRYPTO_set_locking_callback(sslLockingCallback);
+        }
+#endif
+        createCert("sip:licode@lynckia.com", 365, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
+        sharedContext = createSSLContext();
+      });
     }
 
     DtlsSocket* DtlsSocketContext::createClient() {
@@ -294,6 +340,14 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
       return mContext;
     }
 
+    DtlsHandshakeStats DtlsSocketContext::getHandshakeStats() {
+      DtlsHandshakeStats stats;
+      stats.completed = handshakesCompleted;
+      stats.failed = handshakesFailed;
+      stats.total_time_ms = handshakeTotalTimeMs;
+      return stats;
+    }
+
     DtlsSocketContext::PacketType DtlsSocketContext::demuxPacket(const unsigned char *data, unsigned int len) {
       assert(len >= 1);
 
@@ -341,6 +395,9 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
       char fprint[100];
       SRTP_PROTECTION_PROFILE *srtp_profile;
 
+      handshakesCompleted++;
+      handshakeTotalTimeMs += mSocket->getHandshakeDuration().count();
+
       if (mSocket->getRemoteFingerprint(fprint)) {
         ELOG_TRACE("Remote fingerprint == %s", fprint);
 
@@ -391,5 +448,6 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
 
     void DtlsSocketContext::handshakeFailed(const char *err) {
       ELOG_WARN("DTLS Handshake Failure %s", err);
+      handshakesFailed++;
       receiver->onHandshakeFailed(this, std::string(err));
     }
@@ -24,7 +24,9 @@ int dummy_cb(int d, X509_STORE_CTX *x) {
 DtlsSocket::DtlsSocket(DtlsSocketContext* socketContext, enum SocketType type):
               mSocketContext(socketContext),
               mSocketType(type),
-              mHandshakeCompleted(false) {
+              mHandshakeStarted(false),
+              mHandshakeCompleted(false),
+              mHandshakeDuration(0) {
   ELOG_DEBUG("Creating Dtls Socket");
   mSocketContext->setDtlsSocket(this);
   SSL_CTX* mContext = mSocketContext->getSSLContext();
@@ -32,8 +34,6 @@ DtlsSocket::DtlsSocket(DtlsSocketContext* socketContext, enum SocketType type):
   mSsl = SSL_new(mContext);
   assert(mSsl != 0);
   SSL_set_mtu(mSsl, DTLS_MTU);
-  mSsl->ctx = mContext;
-  mSsl->session_ctx = mContext;
 
   switch (type) {
     case Client:
@@ -126,6 +126,11 @@ void DtlsSocket::doHandshakeIteration() {
   if (mHandshakeCompleted)
   return;
 
+  if (!mHandshakeStarted) {
+    mHandshakeStarted = true;
+    mHandshakeStart = std::chrono::steady_clock::now();
+  }
+
   int r = SSL_do_handshake(mSsl);
   errbuf[0] = 0;
   ERR_error_string_n(ERR_peek_error(), errbuf, sizeof(errbuf));
@@ -142,6 +147,8 @@ void DtlsSocket::doHandshakeIteration() {
   switch (sslerr = SSL_get_error(mSsl, r)) {
     case SSL_ERROR_NONE:
       mHandshakeCompleted = true;
+      mHandshakeDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - mHandshakeStart);
       mSocketContext->handshakeCompleted();
       break;
     case SSL_ERROR_WANT_READ:
@@ -198,25 +205,30 @@ SrtpSessionKeys* DtlsSocket::getSrtpSessionKeys() {
 
   SrtpSessionKeys* keys = new SrtpSessionKeys();
 
-  unsigned char material[SRTP_MASTER_KEY_LEN << 1];
-  if (!SSL_export_keying_material(mSsl, material, sizeof(material), "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
+  // Key and salt lengths depend on the negotiated profile (RFC 5764 section 4.2)
+  srtp_profile_t profile = getSelectedSrtpProfile();
+  int key_len = srtp_profile_get_master_key_length(profile);
+  int salt_len = srtp_profile_get_master_salt_length(profile);
+
+  unsigned char material[(SRTP_MASTER_KEY_KEY_LEN + SRTP_MASTER_KEY_SALT_LEN) << 1];
+  if (!SSL_export_keying_material(mSsl, material, (key_len + salt_len) << 1, "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
     return keys;
   }
 
   size_t offset = 0;
 
-  memcpy(keys->clientMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->serverMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->clientMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  memcpy(keys->serverMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  keys->clientMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->serverMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->clientMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
-  keys->serverMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
+  memcpy(keys->clientMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->serverMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->clientMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  memcpy(keys->serverMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  keys->clientMasterKeyLen = key_len;
+  keys->serverMasterKeyLen = key_len;
+  keys->clientMasterSaltLen = salt_len;
+  keys->serverMasterSaltLen = salt_len;
 
   return keys;
 }
@@ -227,6 +239,15 @@ SRTP_PROTECTION_PROFILE* DtlsSocket::getSrtpProfile() {
   return SSL_get_selected_srtp_profile(mSsl);
 }
 
+srtp_profile_t DtlsSocket::getSelectedSrtpProfile() {
+  SRTP_PROTECTION_PROFILE *srtp_profile = getSrtpProfile();
+  if (!srtp_profile) {
+    return srtp_profile_aes128_cm_sha1_80;
+  }
+  // OpenSSL and libsrtp both use the profile identifiers registered by RFC 5764
+  return static_cast<srtp_profile_t>(srtp_profile->id);
+}
+
 // Fingerprint is assumed to be long enough
 void DtlsSocket::computeFingerprint(X509 *cert, char *fingerprint) {
   unsigned char md[EVP_MAX_MD_SIZE];
@@ -276,8 +297,7 @@ void DtlsSocket::handleTimeout() {
 void DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy) {
   assert(mHandshakeCompleted);
 
-  /* we assume that the default profile is in effect, for now */
-  srtp_profile_t profile = srtp_profile_aes128_cm_sha1_80;
+  srtp_profile_t profile = getSelectedSrtpProfile();
   int key_len = srtp_profile_get_master_key_length(profile);
   int salt_len = srtp_profile_get_master_salt_length(profile);
 
@@ -14,12 +14,15 @@ extern "C" {
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <memory>
 #include <string>
 
 #include "../logger.h"
 
-const int SRTP_MASTER_KEY_KEY_LEN = 16;
+// Longest master key (AES-256-GCM) and salt (AES-CM) of the supported SRTP profiles
+const int SRTP_MASTER_KEY_KEY_LEN = 32;
 const int SRTP_MASTER_KEY_SALT_LEN = 14;
 static const int DTLS_MTU = 1472;
 
@@ -99,6 +102,12 @@ class DtlsSocket {
   // Retrieves the DTLS negotiated SRTP profile - may return 0 if profile selection failed
   SRTP_PROTECTION_PROFILE* getSrtpProfile();
 
+  // The negotiated profile as a libsrtp profile, AES128_CM_SHA1_80 if none was selected
+  srtp_profile_t getSelectedSrtpProfile();
+
+  // Time from the first handshake message until the handshake completed
+  std::chrono::milliseconds getHandshakeDuration() const { return mHandshakeDuration; }
+
   // Creates SRTP session policies appropriately based on socket type (client vs server) and keys
   // extracted from the DTLS handshake process
   void createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy);  // NOLINT
@@ -122,10 +131,19 @@ class DtlsSocket {
   BIO *mOutBio;
 
   SocketType mSocketType;
+  bool mHandshakeStarted;
   bool mHandshakeCompleted;
+  std::chrono::steady_clock::time_point mHandshakeStart;
+  std::chrono::milliseconds mHandshakeDuration;
   boost::mutex handshakeMutex_;
 };
 
+struct DtlsHandshakeStats {
+  uint64_t completed = 0;
+  uint64_t failed = 0;
+  uint64_t total_time_ms = 0;
+};
+
 class DtlsReceiver {
  public:
   virtual void onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) = 0;
@@ -154,6 +172,7 @@ class DtlsSocketContext {
   void setDtlsReceiver(DtlsReceiver *recv);
   void setDtlsSocket(DtlsSocket *sock) {mSocket = sock;}
   std::string getFingerprint() const;
+  std::chrono::milliseconds getHandshakeDuration() const { return mSocket->getHandshakeDuration(); }
 
   void handleTimeout();
 
@@ -169,13 +188,13 @@ class DtlsSocketContext {
   // Returns the fingerprint of the user cert that was passed into the constructor
   void getMyCertFingerprint(char *fingerprint);
 
-  // The default SrtpProfile used at construction time (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // The default SrtpProfile used at construction time (AEAD GCM profiles first when OpenSSL supports them)
   static const char* DefaultSrtpProfile;
 
-  // Changes the default SRTP profiles supported (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // Changes the default SRTP profiles supported, the context is shared so it affects every socket
   void setSrtpProfiles(const char *policyStr);
 
-  // Changes the default DTLS Cipher Suites supported
+  // Changes the default DTLS Cipher Suites supported, the context is shared so it affects every socket
   void setCipherSuites(const char *cipherSuites);
 
   SSL_CTX* getSSLContext();
@@ -186,15 +205,25 @@ class DtlsSocketContext {
   static X509 *mCert;
   static EVP_PKEY *privkey;
 
+  // Creates the ECDSA certificate and the SSL context shared by every socket, it only runs once
   static void Init();
 
+  // Handshakes completed and failed by all the sockets of the process
+  static DtlsHandshakeStats getHandshakeStats();
+
  protected:
   DtlsSocket *mSocket;
   DtlsReceiver *receiver;
 
  private:
   // Creates a DTLS SSL Context and enables srtp extension, also sets the private and public key cert
+  static SSL_CTX* createSSLContext();
+
   SSL_CTX* mContext;
+  static SSL_CTX *sharedContext;
+  static std::atomic<uint64_t> handshakesCompleted;
+  static std::atomic<uint64_t> handshakesFailed;
+  static std::atomic<uint64_t> handshakeTotalTimeMs;
 };
 }  // namespace dtls
 
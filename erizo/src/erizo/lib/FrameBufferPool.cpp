@@ -0,0 +1,64 @@
+#include "lib/FrameBufferPool.h"
+
+namespace erizo {
+
+FrameBufferPool::FrameBufferPool(size_t max_cached_buffers)
+    : max_cached_buffers_{max_cached_buffers},
+      allocations_{0},
+      pool_hits_{0} {
+}
+
+FrameBufferPool::~FrameBufferPool() {
+  std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+  for (FrameBuffer *buffer : free_buffers_) {
+    delete buffer;
+  }
+  free_buffers_.clear();
+}
+
+FrameBufferPtr FrameBufferPool::allocate(size_t size) {
+  FrameBuffer *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    if (!free_buffers_.empty()) {
+      buffer = free_buffers_.back();
+      free_buffers_.pop_back();
+    }
+  }
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  if (buffer) {
+    pool_hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    buffer = new FrameBuffer();
+  }
+  buffer->resize(size);
+  // The buffer keeps the pool alive until it is released
+  std::shared_ptr<FrameBufferPool> pool = shared_from_this();
+  return FrameBufferPtr(buffer, [pool] (FrameBuffer *released) {
+    pool->release(released);
+  });
+}
+
+void FrameBufferPool::release(FrameBuffer *buffer) {
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    if (free_buffers_.size() < max_cached_buffers_) {
+      free_buffers_.push_back(buffer);
+      return;
+    }
+  }
+  delete buffer;
+}
+
+FrameBufferPoolStats FrameBufferPool::getStats() const {
+  FrameBufferPoolStats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    stats.cached = free_buffers_.size();
+  }
+  return stats;
+}
+
+}  // namespace erizo
@@ -0,0 +1,48 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_FRAMEBUFFERPOOL_H_
+#define ERIZO_SRC_ERIZO_LIB_FRAMEBUFFERPOOL_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+namespace erizo {
+
+static constexpr size_t kDefaultMaxCachedFrameBuffers = 16;
+
+typedef std::vector<unsigned char> FrameBuffer;
+typedef std::shared_ptr<FrameBuffer> FrameBufferPtr;
+
+struct FrameBufferPoolStats {
+  uint64_t allocations = 0;
+  uint64_t pool_hits = 0;
+  uint64_t cached = 0;
+};
+
+// Cache of variable size buffers for assembled video frames. Buffers keep their capacity when they go back to
+// the pool, so after the first keyframes a stream reuses that storage instead of reallocating large frames.
+// Every allocation still creates a shared_ptr control block, and growing a reused buffer zero-fills the new bytes.
+// Buffers can be released from any thread.
+class FrameBufferPool : public std::enable_shared_from_this<FrameBufferPool> {
+ public:
+  explicit FrameBufferPool(size_t max_cached_buffers = kDefaultMaxCachedFrameBuffers);
+  ~FrameBufferPool();
+
+  FrameBufferPtr allocate(size_t size);
+
+  FrameBufferPoolStats getStats() const;
+
+ private:
+  void release(FrameBuffer *buffer);
+
+ private:
+  size_t max_cached_buffers_;
+  std::vector<FrameBuffer*> free_buffers_;
+  mutable std::mutex free_buffers_mutex_;
+  std::atomic<uint64_t> allocations_;
+  std::atomic<uint64_t> pool_hits_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_FRAMEBUFFERPOOL_H_
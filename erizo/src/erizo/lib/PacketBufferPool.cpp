@@ -0,0 +1,99 @@
+#include "lib/PacketBufferPool.h"
+
+namespace erizo {
+
+static thread_local std::shared_ptr<PacketBufferPool> current_pool;
+
+void intrusive_ptr_add_ref(PacketBuffer *buffer) {
+  buffer->ref_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void intrusive_ptr_release(PacketBuffer *buffer) {
+  if (buffer->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // The pool may be destroyed when this reference goes away, which also frees the buffer
+    std::shared_ptr<PacketBufferPool> pool = std::move(buffer->pool_);
+    pool->release(buffer);
+  }
+}
+
+PacketBufferPool::PacketBufferPool(size_t max_cached_buffers)
+    : max_cached_buffers_{max_cached_buffers},
+      allocations_{0},
+      pool_hits_{0},
+      heap_allocations_{0},
+      in_use_{0} {
+}
+
+PacketBufferPool::~PacketBufferPool() {
+  std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+  for (PacketBuffer *buffer : free_buffers_) {
+    delete buffer;
+  }
+  free_buffers_.clear();
+}
+
+PacketBufferPtr PacketBufferPool::allocate() {
+  PacketBuffer *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    if (!free_buffers_.empty()) {
+      buffer = free_buffers_.back();
+      free_buffers_.pop_back();
+    }
+  }
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  if (buffer) {
+    pool_hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+    buffer = new PacketBuffer();
+  }
+  in_use_.fetch_add(1, std::memory_order_relaxed);
+  buffer->pool_ = shared_from_this();
+  return PacketBufferPtr(buffer);
+}
+
+void PacketBufferPool::release(PacketBuffer *buffer) {
+  in_use_.fetch_sub(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    if (free_buffers_.size() < max_cached_buffers_) {
+      free_buffers_.push_back(buffer);
+      return;
+    }
+  }
+  delete buffer;
+}
+
+PacketBufferPoolStats PacketBufferPool::getStats() const {
+  PacketBufferPoolStats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+  stats.heap_allocations = heap_allocations_.load(std::memory_order_relaxed);
+  stats.in_use = in_use_.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(free_buffers_mutex_);
+    stats.cached = free_buffers_.size();
+  }
+  return stats;
+}
+
+std::shared_ptr<PacketBufferPool> PacketBufferPool::current() {
+  if (!current_pool) {
+    current_pool = std::make_shared<PacketBufferPool>();
+  }
+  return current_pool;
+}
+
+void PacketBufferPool::setCurrent(std::shared_ptr<PacketBufferPool> pool) {
+  current_pool = pool;
+}
+
+PacketBufferPtr PacketBufferPool::allocateFromCurrent() {
+  if (!current_pool) {
+    current_pool = std::make_shared<PacketBufferPool>();
+  }
+  return current_pool->allocate();
+}
+
+}  // namespace erizo
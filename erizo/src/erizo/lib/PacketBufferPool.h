@@ -0,0 +1,86 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_PACKETBUFFERPOOL_H_
+#define ERIZO_SRC_ERIZO_LIB_PACKETBUFFERPOOL_H_
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+namespace erizo {
+
+static constexpr int kPacketBufferSize = 1500;
+static constexpr size_t kDefaultMaxCachedPacketBuffers = 4096;
+
+class PacketBufferPool;
+
+// Fixed size storage for a single packet. Buffers are reference counted and go back to the pool
+// that created them when the last reference is released.
+class PacketBuffer {
+ public:
+  char* data() { return data_; }
+  bool isShared() const { return ref_count_.load(std::memory_order_acquire) > 1; }
+
+ private:
+  PacketBuffer() : ref_count_{0} {}
+
+  friend class PacketBufferPool;
+  friend void intrusive_ptr_add_ref(PacketBuffer *buffer);
+  friend void intrusive_ptr_release(PacketBuffer *buffer);
+
+  std::atomic<int> ref_count_;
+  std::shared_ptr<PacketBufferPool> pool_;
+  char data_[kPacketBufferSize];
+};
+
+typedef boost::intrusive_ptr<PacketBuffer> PacketBufferPtr;
+
+void intrusive_ptr_add_ref(PacketBuffer *buffer);
+void intrusive_ptr_release(PacketBuffer *buffer);
+
+struct PacketBufferPoolStats {
+  uint64_t allocations = 0;
+  uint64_t pool_hits = 0;
+  uint64_t heap_allocations = 0;
+  uint64_t in_use = 0;
+  uint64_t cached = 0;
+
+  double getHitRate() const {
+    return allocations == 0 ? 0. : static_cast<double>(pool_hits) / allocations;
+  }
+};
+
+// Per thread cache of packet buffers. Workers install their own pool when their thread starts so
+// allocations can be accounted per worker; any other thread lazily gets a default one.
+class PacketBufferPool : public std::enable_shared_from_this<PacketBufferPool> {
+ public:
+  explicit PacketBufferPool(size_t max_cached_buffers = kDefaultMaxCachedPacketBuffers);
+  ~PacketBufferPool();
+
+  PacketBufferPtr allocate();
+
+  PacketBufferPoolStats getStats() const;
+
+  static std::shared_ptr<PacketBufferPool> current();
+  static void setCurrent(std::shared_ptr<PacketBufferPool> pool);
+  static PacketBufferPtr allocateFromCurrent();
+
+ private:
+  void release(PacketBuffer *buffer);
+
+  friend void intrusive_ptr_release(PacketBuffer *buffer);
+
+ private:
+  size_t max_cached_buffers_;
+  std::vector<PacketBuffer*> free_buffers_;
+  mutable std::mutex free_buffers_mutex_;
+  std::atomic<uint64_t> allocations_;
+  std::atomic<uint64_t> pool_hits_;
+  std::atomic<uint64_t> heap_allocations_;
+  std::atomic<uint64_t> in_use_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_PACKETBUFFERPOOL_H_
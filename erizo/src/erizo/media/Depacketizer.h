@@ -55,6 +55,11 @@ class Depacketizer {
    */
   virtual bool isKeyframe() const = 0;
 
+  /**
+   * @returns True if the last fetched packet is known to be the first one of a frame
+   */
+  virtual bool isFrameStart() const = 0;
+
  protected:
   enum class SearchState {
     lookingForStart, lookingForEnd
@@ -93,12 +98,15 @@ class Vp8Depacketizer: public Depacketizer {
   bool processPacket() override;
 
   bool isKeyframe() const override;
+
+  bool isFrameStart() const override;
  private:
   void resetImpl() override;
 
   RtpVP8Parser parser_;
   const RtpHeader* head_;
-  std::unique_ptr<erizo::RTPPayloadVP8> last_payload_;
+  erizo::RTPPayloadVP8 last_payload_;
+  bool has_last_payload_ = false;
 };
 
 class H264Depacketizer: public Depacketizer {
@@ -108,11 +116,17 @@ class H264Depacketizer: public Depacketizer {
   bool processPacket() override;
 
   bool isKeyframe() const override;
+
+  // NAL units don't tell where an access unit starts, the end of the previous one (marker bit) does
+  bool isFrameStart() const override {
+    return false;
+  }
  private:
   void resetImpl() override;
 
   RtpH264Parser parser_;
-  std::unique_ptr<erizo::RTPPayloadH264> last_payload_;
+  erizo::RTPPayloadH264 last_payload_;
+  bool has_last_payload_ = false;
 };
 }  // namespace erizo
 
@@ -2,8 +2,13 @@
 
 #include <sys/time.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
 #include <string>
 #include <cstring>
+#include <thread>  // NOLINT
 
 #include "lib/ClockUtils.h"
 
@@ -19,12 +24,49 @@ using std::memcpy;
 namespace erizo {
 
 DEFINE_LOGGER(ExternalOutput, "media.ExternalOutput");
+
+static int writeFile(void* opaque, uint8_t* buffer, int size) {
+  FILE* file = static_cast<FILE*>(opaque);
+  return fwrite(buffer, 1, size, file) == static_cast<size_t>(size) ? size : AVERROR(EIO);
+}
+
+static int64_t seekFile(void* opaque, int64_t offset, int whence) {
+  FILE* file = static_cast<FILE*>(opaque);
+  if (whence == AVSEEK_SIZE) {
+    int64_t position = ftello(file);
+    if (position < 0 || fseeko(file, 0, SEEK_END) != 0) {
+      return AVERROR(errno);
+    }
+    int64_t size = ftello(file);
+    fseeko(file, position, SEEK_SET);
+    return size;
+  }
+  if (fseeko(file, offset, whence & ~AVSEEK_FORCE) != 0) {
+    return AVERROR(errno);
+  }
+  return ftello(file);
+}
+
+constexpr unsigned int ExternalOutput::kMaxMuxerThreads;
+constexpr int ExternalOutput::kMaxWriteBatchSize;
+constexpr double ExternalOutput::kQueueDepth;
+constexpr double ExternalOutput::kQueueMaxDepth;
+constexpr double ExternalOutput::kBackpressureDepth;
+constexpr int ExternalOutput::kFragmentDurationMs;
+constexpr int ExternalOutput::kFileBufferSize;
+constexpr duration ExternalOutput::kMinKeyframeRequestInterval;
+
 ExternalOutput::ExternalOutput(std::shared_ptr<Worker> worker, const std::string& output_url,
                                const std::vector<RtpMap> rtp_mappings,
-                               const std::vector<erizo::ExtMap> ext_mappings)
-  : worker_{worker}, pipeline_{Pipeline::create()}, audio_queue_{5.0, 10.0}, video_queue_{5.0, 10.0},
-    inited_{false}, video_stream_{nullptr},
-    audio_stream_{nullptr}, video_source_ssrc_{0},
+                               const std::vector<erizo::ExtMap> ext_mappings,
+                               std::shared_ptr<Worker> muxer_worker)
+  : worker_{worker}, muxer_worker_{muxer_worker ? muxer_worker : getMuxerThreadPool()->getLessUsedWorker()},
+    pipeline_{Pipeline::create()}, audio_queue_{kQueueDepth, kQueueMaxDepth}, video_queue_{kQueueDepth, kQueueMaxDepth},
+    recording_{false}, inited_{false}, closing_{false}, write_scheduled_{false}, muxer_closed_{false},
+    dropping_video_{false}, written_packets_{0}, dropped_video_packets_{0}, write_batches_{0}, write_time_us_{0},
+    max_write_time_us_{0}, video_stream_{nullptr},
+    audio_stream_{nullptr}, context_{nullptr}, file_{nullptr}, output_url_{output_url}, segment_number_{0},
+    segment_start_ms_{-1}, last_video_ms_{0}, video_source_ssrc_{0},
     first_video_timestamp_{-1}, first_audio_timestamp_{-1},
     first_data_received_{}, video_offset_ms_{-1}, audio_offset_ms_{-1},
     need_to_send_fir_{true}, rtp_mappings_{rtp_mappings}, video_codec_{AV_CODEC_ID_NONE},
@@ -55,18 +97,6 @@ ExternalOutput::ExternalOutput(std::shared_ptr<Worker> worker, const std::string
     }
   }
 
-  context_ = avformat_alloc_context();
-  if (context_ == nullptr) {
-    ELOG_ERROR("Error allocating memory for IO context");
-  } else {
-    output_url.copy(context_->filename, sizeof(context_->filename), 0);
-
-    context_->oformat = av_guess_format(nullptr,  context_->filename, nullptr);
-    if (!context_->oformat) {
-      ELOG_ERROR("Error guessing format %s", context_->filename);
-    }
-  }
-
   // Set a fixed extension map to parse video orientation
   // TODO(yannistseng): Update extension maps dymaically from SDP info
   std::shared_ptr<SdpInfo> sdp = std::make_shared<SdpInfo>(rtp_mappings_);
@@ -76,19 +106,58 @@ ExternalOutput::ExternalOutput(std::shared_ptr<Worker> worker, const std::string
   ext_processor_.setSdpInfo(sdp);
 }
 
+void ExternalOutput::setSegmentation(const RecordingSegmentation& segmentation) {
+  segmentation_ = segmentation;
+}
+
 bool ExternalOutput::init() {
   MediaInfo m;
   m.hasVideo = false;
   m.hasAudio = false;
+  if (segmentation_.isEnabled() && output_url_.find("://") != std::string::npos) {
+    ELOG_WARN("message: Segmented recording is only supported for files, url: %s", output_url_.c_str());
+    segmentation_ = RecordingSegmentation();
+  }
+  createContext(segmentation_.isEnabled() ? getSegmentUrl(output_url_, segment_number_) : output_url_);
   recording_ = true;
   asyncTask([] (std::shared_ptr<ExternalOutput> output) {
     output->initializePipeline();
   });
-  thread_ = boost::thread(&ExternalOutput::sendLoop, this);
   ELOG_DEBUG("Initialized successfully");
   return true;
 }
 
+std::string ExternalOutput::getSegmentUrl(const std::string& output_url, int segment_number) {
+  char suffix[16];
+  snprintf(suffix, sizeof(suffix), "_%05d", segment_number);
+  std::size_t extension = output_url.find_last_of('.');
+  std::size_t directory = output_url.find_last_of('/');
+  if (extension == std::string::npos || (directory != std::string::npos && extension < directory)) {
+    return output_url + suffix;
+  }
+  return output_url.substr(0, extension) + suffix + output_url.substr(extension);
+}
+
+std::string ExternalOutput::getIndexUrl(const std::string& output_url) {
+  std::size_t extension = output_url.find_last_of('.');
+  std::size_t directory = output_url.find_last_of('/');
+  if (extension == std::string::npos || (directory != std::string::npos && extension < directory)) {
+    return output_url + ".index";
+  }
+  return output_url.substr(0, extension) + ".index";
+}
+
+std::shared_ptr<ThreadPool> ExternalOutput::getMuxerThreadPool() {
+  static std::once_flag created;
+  static std::shared_ptr<ThreadPool> muxer_thread_pool;
+  std::call_once(created, [] {
+    unsigned int threads = std::min(kMaxMuxerThreads, std::max(1u, std::thread::hardware_concurrency() / 2));
+    muxer_thread_pool = std::make_shared<ThreadPool>(threads);
+    muxer_thread_pool->start();
+  });
+  return muxer_thread_pool;
+}
+
 
 ExternalOutput::~ExternalOutput() {
   ELOG_DEBUG("Destructing");
@@ -102,15 +171,57 @@ void ExternalOutput::close() {
 }
 
 void ExternalOutput::syncClose() {
-  if (!recording_) {
+  if (!recording_ || closing_) {
     return;
   }
-  // Stop our thread so we can safely nuke libav stuff and close our
-  // our file.
-  cond_.notify_one();
-  thread_.join();
+  closing_ = true;
+  pipeline_initialized_ = false;
+  // Queued writes for this output run in muxer_worker_ too, so they are done before closing the file
+  std::shared_ptr<ExternalOutput> shared_this = shared_from_this();
+  muxer_worker_->task([shared_this] {
+    shared_this->closeOutput();
+  });
+}
+
+void ExternalOutput::closeOutput() {
+  // Since we're bailing, let's completely drain our queues of all data.
+  while (audio_queue_.getSize() > 0) {
+    std::shared_ptr<DataPacket> audio_packet = audio_queue_.popPacket(true);  // ignore our minimum depth check
+    writeAudioData(audio_packet->data, audio_packet->length);
+  }
+  while (video_queue_.getSize() > 0) {
+    std::shared_ptr<DataPacket> video_packet = video_queue_.popPacket(true);  // ignore our minimum depth check
+    writeVideoData(std::move(video_packet));
+  }
+  if (frame_assembler_) {
+    frame_assembler_->flush();
+    FrameAssemblerStats frame_stats = frame_assembler_->getStats();
+    ELOG_INFO("message: Assembled video frames, complete: %lu, incomplete: %lu, latePackets: %lu",
+              frame_stats.complete_frames, frame_stats.incomplete_frames, frame_stats.late_packets);
+  }
+
+  closeContext(last_video_ms_, true);
+  muxer_closed_ = true;
+
+  ExternalOutputStats stats = getStats();
+  ELOG_INFO("message: Recording closed, writtenPackets: %lu, droppedVideoPackets: %lu, "
+            "averageWriteLatencyUs: %lu, maxWriteLatencyUs: %lu",
+            stats.written_packets, stats.dropped_video_packets,
+            stats.average_write_latency_us, stats.max_write_latency_us);
+  ELOG_INFO("message: Discarded queue packets, audio late: %lu, duplicate: %lu, overflow: %lu, "
+            "video late: %lu, duplicate: %lu, overflow: %lu",
+            stats.audio_queue.late, stats.audio_queue.duplicate, stats.audio_queue.overflow,
+            stats.video_queue.late, stats.video_queue.duplicate, stats.video_queue.overflow);
+  recording_ = false;
+  ELOG_DEBUG("Closed Successfully");
+}
 
-  if (audio_stream_ != nullptr && video_stream_ != nullptr && context_ != nullptr) {
+void ExternalOutput::closeContext(int64_t end_ms, bool last_segment) {
+  if (context_ == nullptr) {
+    return;
+  }
+  bool written = audio_stream_ != nullptr && video_stream_ != nullptr;
+  if (written) {
       av_write_trailer(context_);
   }
 
@@ -122,16 +233,94 @@ void ExternalOutput::syncClose() {
       avcodec_close(audio_stream_->codec);
   }
 
-  if (context_ != nullptr) {
-      avio_close(context_->pb);
-      avformat_free_context(context_);
-      context_ = nullptr;
+  int64_t bytes = context_->pb != nullptr ? avio_tell(context_->pb) : 0;
+  std::string file = context_->filename;
+  closeIo();
+  avformat_free_context(context_);
+  context_ = nullptr;
+  video_stream_ = nullptr;
+  audio_stream_ = nullptr;
+
+  if (!segmentation_.isEnabled() || !written) {
+    return;
+  }
+  // Segments are only listed once they are complete, so anything in the index can be played or uploaded
+  if (!index_.is_open()) {
+    index_.open(getIndexUrl(output_url_), std::ofstream::out | std::ofstream::app);
   }
+  char entry[1024];
+  snprintf(entry, sizeof(entry),
+           "{\"file\":\"%s\",\"segment\":%d,\"startMs\":%" PRId64 ",\"durationMs\":%" PRId64
+           ",\"bytes\":%" PRId64 ",\"last\":%s}",
+           file.substr(file.find_last_of('/') + 1).c_str(), segment_number_, segment_start_ms_,
+           std::max<int64_t>(0, end_ms - segment_start_ms_), bytes, last_segment ? "true" : "false");
+  index_ << entry << std::endl;
+  if (!index_) {
+    ELOG_ERROR("message: Error writing recording index, url: %s", getIndexUrl(output_url_).c_str());
+  }
+  ELOG_DEBUG("message: Recording segment finished, file: %s, bytes: %" PRId64, file.c_str(), bytes);
+  if (last_segment) {
+    index_.close();
+  }
+}
 
-  pipeline_initialized_ = false;
-  recording_ = false;
+void ExternalOutput::maybeStartNewSegment(int64_t timestamp_ms) {
+  bool too_long = segmentation_.max_duration > duration::zero() &&
+      timestamp_ms - segment_start_ms_ >= ClockUtils::durationToMs(segmentation_.max_duration);
+  bool too_big = segmentation_.max_bytes > 0 && context_->pb != nullptr &&
+      static_cast<uint64_t>(avio_tell(context_->pb)) >= segmentation_.max_bytes;
+  if (!too_long && !too_big) {
+    return;
+  }
+  closeContext(timestamp_ms, false);
+  segment_number_++;
+  segment_start_ms_ = timestamp_ms;
+  if (!createContext(getSegmentUrl(output_url_, segment_number_)) || !initContext()) {
+    ELOG_ERROR("message: Could not start recording segment, segment: %d", segment_number_);
+  }
+}
 
-  ELOG_DEBUG("Closed Successfully");
+ExternalOutputStats ExternalOutput::getStats() {
+  ExternalOutputStats stats;
+  stats.written_packets = written_packets_;
+  stats.dropped_video_packets = dropped_video_packets_;
+  uint64_t batches = write_batches_;
+  stats.average_write_latency_us = batches == 0 ? 0 : write_time_us_ / batches;
+  stats.max_write_latency_us = max_write_time_us_;
+  stats.audio_queue_depth = audio_queue_.getDepth();
+  stats.video_queue_depth = video_queue_.getDepth();
+  stats.audio_queue = audio_queue_.getStats();
+  stats.video_queue = video_queue_.getStats();
+  return stats;
+}
+
+void ExternalOutput::getJSONStats(std::function<void(std::string)> callback) {
+  std::weak_ptr<ExternalOutput> weak_this = shared_from_this();
+  worker_->task([weak_this, callback] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->updateStats();
+      callback(this_ptr->stats_->getStats());
+    } else {
+      callback("{}");
+    }
+  });
+}
+
+void ExternalOutput::updateStats() {
+  ExternalOutputStats stats = getStats();
+  StatNode &recording = stats_->getNode()["recording"];
+  recording.insertStat("writtenPackets", CumulativeStat{stats.written_packets});
+  recording.insertStat("droppedVideoPackets", CumulativeStat{stats.dropped_video_packets});
+  recording.insertStat("averageWriteLatencyUs", GaugeStat{stats.average_write_latency_us});
+  recording.insertStat("maxWriteLatencyUs", GaugeStat{stats.max_write_latency_us});
+  recording.insertStat("audioQueueDepthMs", GaugeStat{static_cast<uint64_t>(stats.audio_queue_depth * 1000)});
+  recording.insertStat("videoQueueDepthMs", GaugeStat{static_cast<uint64_t>(stats.video_queue_depth * 1000)});
+  recording["audioQueue"].insertStat("late", CumulativeStat{stats.audio_queue.late});
+  recording["audioQueue"].insertStat("duplicate", CumulativeStat{stats.audio_queue.duplicate});
+  recording["audioQueue"].insertStat("overflow", CumulativeStat{stats.audio_queue.overflow});
+  recording["videoQueue"].insertStat("late", CumulativeStat{stats.video_queue.late});
+  recording["videoQueue"].insertStat("duplicate", CumulativeStat{stats.video_queue.duplicate});
+  recording["videoQueue"].insertStat("overflow", CumulativeStat{stats.video_queue.overflow});
 }
 
 void ExternalOutput::asyncTask(std::function<void(std::shared_ptr<ExternalOutput>)> f) {
@@ -208,18 +397,14 @@ void ExternalOutput::writeAudioData(char* buf, int len) {
   av_interleaved_write_frame(context_, &av_packet);   // takes ownership of the packet
 }
 
-void ExternalOutput::writeVideoData(char* buf, int len) {
-  RtpHeader* head = reinterpret_cast<RtpHeader*>(buf);
+void ExternalOutput::writeVideoData(std::shared_ptr<DataPacket> video_packet) {
+  RtpHeader* head = reinterpret_cast<RtpHeader*>(video_packet->data);
 
   uint16_t current_video_sequence_number = head->getSeqNumber();
   if (current_video_sequence_number != last_video_sequence_number_ + 1) {
-    // Something screwy.  We should always see sequence numbers incrementing monotonically.
+    // Missing packets only make their own frames incomplete, the frame assembler keeps the rest
     ELOG_DEBUG("Unexpected video sequence number; current %d, previous %d",
               current_video_sequence_number, last_video_sequence_number_);
-    // Restart the depacketizer so it looks for the start of a frame
-    if (depacketizer_!= nullptr) {
-      depacketizer_->reset();
-    }
   }
 
   last_video_sequence_number_ = current_video_sequence_number;
@@ -230,8 +415,8 @@ void ExternalOutput::writeVideoData(char* buf, int len) {
   auto map_iterator = video_maps_.find(head->getPayloadType());
   if (map_iterator != video_maps_.end()) {
     updateVideoCodec(map_iterator->second);
-    if (map_iterator->second.encoding_name == "VP8" || map_iterator->second.encoding_name == "H264") {
-      maybeWriteVideoPacket(buf, len);
+    if (frame_assembler_) {
+      frame_assembler_->addPacket(std::move(video_packet));
     }
   }
 }
@@ -253,52 +438,93 @@ void ExternalOutput::updateVideoCodec(RtpMap map) {
     return;
   }
   video_map_ = map;
+  std::unique_ptr<Depacketizer> depacketizer;
   if (map.encoding_name == "VP8") {
-    depacketizer_.reset(new Vp8Depacketizer());
+    depacketizer.reset(new Vp8Depacketizer());
     video_codec_ = AV_CODEC_ID_VP8;
   } else if (map.encoding_name == "H264") {
-    depacketizer_.reset(new H264Depacketizer());
+    depacketizer.reset(new H264Depacketizer());
     video_codec_ = AV_CODEC_ID_H264;
+  } else {
+    return;
   }
+  // The assembler is owned by this output and only used from the muxer worker
+  frame_assembler_.reset(new FrameAssembler(std::move(depacketizer), map.clock_rate,
+                                            [this] (const AssembledFrame& frame) {
+    writeVideoFrame(frame);
+  }));
 }
 
-void ExternalOutput::maybeWriteVideoPacket(char* buf, int len) {
-  RtpHeader* head = reinterpret_cast<RtpHeader*>(buf);
-  depacketizer_->fetchPacket((unsigned char*)buf, len);
-  bool deliver = depacketizer_->processPacket();
-
+void ExternalOutput::writeVideoFrame(const AssembledFrame& frame) {
   initContext();
   if (video_stream_ == nullptr) {
     // could not init our context yet.
     return;
   }
 
-  if (deliver) {
-    long long current_timestamp = head->getTimestamp();  // NOLINT
-    if (current_timestamp - first_video_timestamp_ < 0) {
-      // we wrapped.  add 2^32 to correct this.
-      // We only handle a single wrap around since that's ~13 hours of recording, minimum.
-      current_timestamp += 0xFFFFFFFF;
+  if (!frame.is_decodable) {
+    // Writing it would show artifacts until the next keyframe, a short freeze is better
+    maybeRequestKeyframe();
+    return;
+  }
+
+  long long current_timestamp = frame.timestamp;  // NOLINT
+  if (current_timestamp - first_video_timestamp_ < 0) {
+    // we wrapped.  add 2^32 to correct this.
+    // We only handle a single wrap around since that's ~13 hours of recording, minimum.
+    current_timestamp += 0xFFFFFFFF;
+  }
+
+  int64_t timestamp_ms = (current_timestamp - first_video_timestamp_) * 1000 / video_map_.clock_rate +
+                         video_offset_ms_;
+  if (segmentation_.isEnabled()) {
+    if (segment_start_ms_ == -1) {
+      segment_start_ms_ = timestamp_ms;
+    } else if (frame.is_keyframe) {
+      // Every segment starts with a keyframe so it can be played on its own
+      maybeStartNewSegment(timestamp_ms);
+      if (video_stream_ == nullptr) {
+        return;
+      }
     }
+  }
+  last_video_ms_ = timestamp_ms;
 
-    // All of our video offerings are using a 90khz clock.
-    long long timestamp_to_write = (current_timestamp - first_video_timestamp_) /  // NOLINT
-                                              (video_map_.clock_rate / video_stream_->time_base.den);
+  // All of our video offerings are using a 90khz clock.
+  long long timestamp_to_write = (current_timestamp - first_video_timestamp_) /  // NOLINT
+                                            (video_map_.clock_rate / video_stream_->time_base.den);
 
-    // Adjust for our start time offset
+  // Adjust for our start time offset
 
-    // in practice, our timebase den is 1000, so this operation is a no-op.
-    timestamp_to_write += video_offset_ms_ / (1000 / video_stream_->time_base.den);
+  // in practice, our timebase den is 1000, so this operation is a no-op.
+  timestamp_to_write += video_offset_ms_ / (1000 / video_stream_->time_base.den);
 
-    AVPacket av_packet;
-    av_init_packet(&av_packet);
-    av_packet.data = depacketizer_->frame();
-    av_packet.size = depacketizer_->frameSize();
-    av_packet.pts = timestamp_to_write;
-    av_packet.stream_index = 0;
-    av_interleaved_write_frame(context_, &av_packet);   // takes ownership of the packet
-    depacketizer_->reset();
+  AVPacket av_packet;
+  av_init_packet(&av_packet);
+  av_packet.data = frame.data();
+  av_packet.size = frame.size();
+  av_packet.pts = timestamp_to_write;
+  av_packet.stream_index = 0;
+  if (frame.is_keyframe) {
+    av_packet.flags |= AV_PKT_FLAG_KEY;
+    if (segmentation_.isEnabled() && context_->pb != nullptr) {
+      // Fragments start on keyframes, the buffered ones are complete and go to storage so they survive a crash
+      avio_flush(context_->pb);
+    }
   }
+  av_interleaved_write_frame(context_, &av_packet);   // takes ownership of the packet
+}
+
+void ExternalOutput::maybeRequestKeyframe() {
+  time_point now = clock::now();
+  if (now - last_keyframe_request_ < kMinKeyframeRequestInterval) {
+    return;
+  }
+  last_keyframe_request_ = now;
+  // Feedback goes out from the media worker, like the rest of this output's packets
+  asyncTask([] (std::shared_ptr<ExternalOutput> output) {
+    output->sendFirPacket();
+  });
 }
 
 void ExternalOutput::notifyUpdateToHandlers() {
@@ -325,6 +551,10 @@ void ExternalOutput::initializePipeline() {
 }
 
 void ExternalOutput::write(std::shared_ptr<DataPacket> packet) {
+  if (packet->type == VIDEO_PACKET && shouldDropVideo(*packet)) {
+    dropped_video_packets_++;
+    return;
+  }
   queueData(packet->data, packet->length, packet->type);
 }
 
@@ -345,12 +575,12 @@ int ExternalOutput::deliverAudioData_(std::shared_ptr<DataPacket> audio_packet)
 }
 
 int ExternalOutput::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
+  std::shared_ptr<DataPacket> copied_packet = std::make_shared<DataPacket>(*video_packet);
   if (video_source_ssrc_ == 0) {
-    RtpHeader* h = reinterpret_cast<RtpHeader*>(video_packet->data);
+    RtpHeader* h = reinterpret_cast<RtpHeader*>(copied_packet->data);
     video_source_ssrc_ = h->getSSRC();
   }
 
-  std::shared_ptr<DataPacket> copied_packet = std::make_shared<DataPacket>(*video_packet);
   copied_packet->type = VIDEO_PACKET;
   ext_processor_.processRtpExtensions(copied_packet);
   queueDataAsync(copied_packet);
@@ -368,7 +598,64 @@ int ExternalOutput::deliverEvent_(MediaEventPtr event) {
   return 1;
 }
 
+bool ExternalOutput::createContext(const std::string& url) {
+  context_ = avformat_alloc_context();
+  if (context_ == nullptr) {
+    ELOG_ERROR("Error allocating memory for IO context");
+    return false;
+  }
+  url.copy(context_->filename, sizeof(context_->filename), 0);
+
+  context_->oformat = av_guess_format(nullptr,  context_->filename, nullptr);
+  if (!context_->oformat) {
+    ELOG_ERROR("Error guessing format %s", context_->filename);
+    return false;
+  }
+  return true;
+}
+
+bool ExternalOutput::openIo() {
+  std::string url = context_->filename;
+  if (url.find("://") != std::string::npos) {
+    return avio_open(&context_->pb, context_->filename, AVIO_FLAG_WRITE) >= 0;
+  }
+  file_ = fopen(context_->filename, "wb");
+  if (file_ == nullptr) {
+    return false;
+  }
+  unsigned char* buffer = static_cast<unsigned char*>(av_malloc(kFileBufferSize));
+  context_->pb = buffer == nullptr ? nullptr :
+      avio_alloc_context(buffer, kFileBufferSize, 1, file_, nullptr, writeFile, seekFile);
+  if (context_->pb == nullptr) {
+    av_free(buffer);
+    fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void ExternalOutput::closeIo() {
+  if (context_->pb == nullptr) {
+    return;
+  }
+  if (file_ == nullptr) {
+    avio_close(context_->pb);
+    context_->pb = nullptr;
+    return;
+  }
+  avio_flush(context_->pb);
+  av_free(context_->pb->buffer);
+  av_free(context_->pb);
+  context_->pb = nullptr;
+  fclose(file_);
+  file_ = nullptr;
+}
+
 bool ExternalOutput::initContext() {
+  if (context_ == nullptr || context_->oformat == nullptr) {
+    return false;
+  }
   if (video_codec_ != AV_CODEC_ID_NONE &&
             audio_codec_ != AV_CODEC_ID_NONE &&
             video_stream_ == nullptr &&
@@ -378,7 +665,10 @@ bool ExternalOutput::initContext() {
       ELOG_ERROR("Could not find video codec");
       return false;
     }
-    need_to_send_fir_ = true;
+    if (segment_number_ == 0) {
+      // Later segments are started on a keyframe
+      need_to_send_fir_ = true;
+    }
     video_queue_.setTimebase(video_map_.clock_rate);
     video_stream_ = avformat_new_stream(context_, video_codec);
     video_stream_->id = 0;
@@ -413,12 +703,24 @@ bool ExternalOutput::initContext() {
 
     context_->streams[0] = video_stream_;
     context_->streams[1] = audio_stream_;
-    if (avio_open(&context_->pb, context_->filename, AVIO_FLAG_WRITE) < 0) {
+    if (!openIo()) {
       ELOG_ERROR("Error opening output file");
       return false;
     }
 
-    if (avformat_write_header(context_, nullptr) < 0) {
+    // Fragmented output keeps everything written so far playable if we crash before writing the trailer
+    AVDictionary* options = nullptr;
+    if (segmentation_.isEnabled()) {
+      std::string format = context_->oformat->name;
+      if (format == "mp4" || format == "mov") {
+        av_dict_set(&options, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0);
+      } else if (format == "matroska" || format == "webm") {
+        av_dict_set(&options, "cluster_time_limit", std::to_string(kFragmentDurationMs).c_str(), 0);
+      }
+    }
+    int result = avformat_write_header(context_, &options);
+    av_dict_free(&options);
+    if (result < 0) {
       ELOG_ERROR("Error writing header");
       return false;
     }
@@ -428,7 +730,7 @@ bool ExternalOutput::initContext() {
 }
 
 void ExternalOutput::queueData(char* buffer, int length, packetType type) {
-  if (!recording_) {
+  if (!recording_ || closing_) {
     return;
   }
 
@@ -455,7 +757,7 @@ void ExternalOutput::queueData(char* buffer, int length, packetType type) {
     uint8_t payloadtype = h->getPayloadType();
     if (video_offset_ms_ == -1) {
       video_offset_ms_ = ClockUtils::durationToMs(clock::now() - first_data_received_);
-      ELOG_DEBUG("File %s, video offset msec: %llu", context_->filename, video_offset_ms_);
+      ELOG_DEBUG("File %s, video offset msec: %llu", output_url_.c_str(), video_offset_ms_);
       video_queue_.setTimebase(video_maps_[payloadtype].clock_rate);
     }
 
@@ -483,7 +785,7 @@ void ExternalOutput::queueData(char* buffer, int length, packetType type) {
   } else {
     if (audio_offset_ms_ == -1) {
       audio_offset_ms_ = ClockUtils::durationToMs(clock::now() - first_data_received_);
-      ELOG_DEBUG("File %s, audio offset msec: %llu", context_->filename, audio_offset_ms_);
+      ELOG_DEBUG("File %s, audio offset msec: %llu", output_url_.c_str(), audio_offset_ms_);
 
       // Let's also take a moment to set our audio queue timebase.
       RtpHeader* h = reinterpret_cast<RtpHeader*>(buffer);
@@ -497,11 +799,83 @@ void ExternalOutput::queueData(char* buffer, int length, packetType type) {
   }
 
   if (audio_queue_.hasData() || video_queue_.hasData()) {
-    // One or both of our queues has enough data to write stuff out.  Notify our writer.
-    cond_.notify_one();
+    // One or both of our queues has enough data to write stuff out.
+    scheduleWrite();
   }
 }
 
+void ExternalOutput::scheduleWrite() {
+  if (write_scheduled_.exchange(true)) {
+    return;
+  }
+  std::weak_ptr<ExternalOutput> weak_this = shared_from_this();
+  muxer_worker_->task([weak_this] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->writeQueuedData();
+    }
+  });
+}
+
+void ExternalOutput::writeQueuedData() {
+  // Cleared before writing so packets queued meanwhile schedule the next batch
+  write_scheduled_ = false;
+  if (muxer_closed_) {
+    return;
+  }
+  time_point start = clock::now();
+  int written = 0;
+  while (written < kMaxWriteBatchSize && audio_queue_.hasData()) {
+    std::shared_ptr<DataPacket> audio_packet = audio_queue_.popPacket();
+    writeAudioData(audio_packet->data, audio_packet->length);
+    written++;
+  }
+  while (written < kMaxWriteBatchSize && video_queue_.hasData()) {
+    std::shared_ptr<DataPacket> video_packet = video_queue_.popPacket();
+    writeVideoData(std::move(video_packet));
+    written++;
+  }
+  if (!inited_ && first_data_received_ != time_point()) {
+    inited_ = true;
+  }
+  if (written == 0) {
+    return;
+  }
+
+  uint64_t write_time_us = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+  written_packets_ += written;
+  write_batches_++;
+  write_time_us_ += write_time_us;
+  if (write_time_us > max_write_time_us_) {
+    max_write_time_us_ = write_time_us;
+  }
+
+  if (written == kMaxWriteBatchSize) {
+    // Yield to the other recordings of this thread before writing the rest
+    scheduleWrite();
+  }
+}
+
+bool ExternalOutput::shouldDropVideo(const DataPacket& packet) {
+  if (packet.codec != RtpCodec::VP8 && packet.codec != RtpCodec::VP9 && packet.codec != RtpCodec::H264) {
+    // We can't tell keyframes apart (i.e. RED), the queue max depth will discard the oldest packets instead
+    return false;
+  }
+  double depth = video_queue_.getDepth();
+  if (!dropping_video_) {
+    if (depth <= kBackpressureDepth) {
+      return false;
+    }
+    ELOG_WARN("message: Storage is slow, dropping video until the next keyframe, queueDepth: %f", depth);
+    dropping_video_ = true;
+    sendFirPacket();
+  }
+  if (packet.is_keyframe && depth <= kBackpressureDepth) {
+    dropping_video_ = false;
+    return false;
+  }
+  return true;
+}
+
 int ExternalOutput::sendFirPacket() {
     if (fb_sink_ != nullptr) {
       RtcpHeader pli_header;
@@ -519,34 +893,6 @@ int ExternalOutput::sendFirPacket() {
     return -1;
 }
 
-void ExternalOutput::sendLoop() {
-  while (recording_) {
-    boost::unique_lock<boost::mutex> lock(mtx_);
-    cond_.wait(lock);
-    while (audio_queue_.hasData()) {
-      boost::shared_ptr<DataPacket> audio_packet = audio_queue_.popPacket();
-      writeAudioData(audio_packet->data, audio_packet->length);
-    }
-    while (video_queue_.hasData()) {
-      boost::shared_ptr<DataPacket> video_packet = video_queue_.popPacket();
-      writeVideoData(video_packet->data, video_packet->length);
-    }
-    if (!inited_ && first_data_received_ != time_point()) {
-      inited_ = true;
-    }
-  }
-
-  // Since we're bailing, let's completely drain our queues of all data.
-  while (audio_queue_.getSize() > 0) {
-    boost::shared_ptr<DataPacket> audio_packet = audio_queue_.popPacket(true);  // ignore our minimum depth check
-    writeAudioData(audio_packet->data, audio_packet->length);
-  }
-  while (video_queue_.getSize() > 0) {
-    boost::shared_ptr<DataPacket> video_packet = video_queue_.popPacket(true);  // ignore our minimum depth check
-    writeVideoData(video_packet->data, video_packet->length);
-  }
-}
-
 AVDictionary* ExternalOutput::genVideoMetadata() {
     AVDictionary* dict = NULL;
     switch (ext_processor_.getVideoRotation()) {
@@ -1,22 +1,23 @@
 #ifndef ERIZO_SRC_ERIZO_MEDIA_EXTERNALOUTPUT_H_
 #define ERIZO_SRC_ERIZO_MEDIA_EXTERNALOUTPUT_H_
 
-#include <boost/thread.hpp>
-
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 }
 
+#include <atomic>
+#include <fstream>
 #include <string>
 
 #include "./MediaDefinitions.h"
+#include "thread/ThreadPool.h"
 #include "thread/Worker.h"
 #include "rtp/RtpPacketQueue.h"
 #include "rtp/RtpExtensionProcessor.h"
 #include "webrtc/modules/rtp_rtcp/source/ulpfec_receiver_impl.h"
 #include "media/MediaProcessor.h"
-#include "media/Depacketizer.h"
+#include "media/FrameAssembler.h"
 #include "./Stats.h"
 #include "lib/Clock.h"
 #include "SdpInfo.h"
@@ -30,16 +31,43 @@ namespace erizo {
 
 static constexpr uint64_t kExternalOutputMaxBitrate = 1000000000;
 
+// Streaming mode: the recording is split in fragmented files (fMP4 or Matroska with short clusters) that
+// start with a keyframe, and every finished one is listed in a sidecar index, so they can be played or
+// uploaded while recording
+struct RecordingSegmentation {
+  duration max_duration = duration::zero();
+  uint64_t max_bytes = 0;
+
+  bool isEnabled() const {
+    return max_duration > duration::zero() || max_bytes > 0;
+  }
+};
+
+struct ExternalOutputStats {
+  uint64_t written_packets = 0;
+  uint64_t dropped_video_packets = 0;  // dropped until the next keyframe while storage was slow
+  uint64_t average_write_latency_us = 0;  // per batch of packets written
+  uint64_t max_write_latency_us = 0;
+  double audio_queue_depth = 0;  // seconds
+  double video_queue_depth = 0;
+  RtpPacketQueueStats audio_queue;
+  RtpPacketQueueStats video_queue;
+};
+
 class ExternalOutput : public MediaSink, public RawDataReceiver, public FeedbackSource,
                        public webrtc::RtpData, public HandlerManagerListener,
                        public std::enable_shared_from_this<ExternalOutput> {
   DECLARE_LOGGER();
 
  public:
+  // Files are written in muxer_worker, one from the shared muxer thread pool by default
   explicit ExternalOutput(std::shared_ptr<Worker> worker, const std::string& output_url,
                           const std::vector<RtpMap> rtp_mappings,
-                          const std::vector<erizo::ExtMap> ext_mappings);
+                          const std::vector<erizo::ExtMap> ext_mappings,
+                          std::shared_ptr<Worker> muxer_worker = nullptr);
   virtual ~ExternalOutput();
+  // Must be called before init()
+  void setSegmentation(const RecordingSegmentation& segmentation);
   bool init();
   void receiveRawData(const RawDataPacket& packet) override;
 
@@ -57,20 +85,59 @@ class ExternalOutput : public MediaSink, public RawDataReceiver, public Feedback
 
   bool isRecording() { return recording_; }
 
+  ExternalOutputStats getStats();
+  // The output stats are published in its stats tree under "recording" before serializing it
+  void getJSONStats(std::function<void(std::string)> callback);
+
+  // Shared by every recording in the process, so a few threads do all the muxing and disk writes
+  static std::shared_ptr<ThreadPool> getMuxerThreadPool();
+
+  static constexpr unsigned int kMaxMuxerThreads = 4;
+  static constexpr int kMaxWriteBatchSize = 256;
+  static constexpr double kQueueDepth = 5.0;
+  static constexpr double kQueueMaxDepth = 10.0;
+  // Video queued beyond this means the muxer is not keeping up, non key video is dropped until it does
+  static constexpr double kBackpressureDepth = 7.5;
+  static constexpr int kFragmentDurationMs = 1000;
+  // Files are written through a buffer this big, so storage gets a few large writes per fragment
+  static constexpr int kFileBufferSize = 1024 * 1024;
+  // Frames that can't be decoded are not written, and we ask for a keyframe at most this often until one arrives
+  static constexpr duration kMinKeyframeRequestInterval = std::chrono::milliseconds(500);
+
+  // i.e. /recordings/1234.mkv is written to /recordings/1234_00000.mkv, /recordings/1234_00001.mkv...
+  // and indexed in /recordings/1234.index
+  static std::string getSegmentUrl(const std::string& output_url, int segment_number);
+  static std::string getIndexUrl(const std::string& output_url);
+
  private:
   std::shared_ptr<Worker> worker_;
+  std::shared_ptr<Worker> muxer_worker_;
   Pipeline::Ptr pipeline_;
   std::unique_ptr<webrtc::UlpfecReceiver> fec_receiver_;
   RtpPacketQueue audio_queue_, video_queue_;
   std::atomic<bool> recording_, inited_;
-  boost::mutex mtx_;  // a mutex we use to signal our writer thread that data is waiting.
-  boost::thread thread_;
-  boost::condition_variable cond_;
+  std::atomic<bool> closing_;
+  std::atomic<bool> write_scheduled_;
+  bool muxer_closed_;  // only accessed in muxer_worker_
+  bool dropping_video_;
+  std::atomic<uint64_t> written_packets_;
+  std::atomic<uint64_t> dropped_video_packets_;
+  std::atomic<uint64_t> write_batches_;
+  std::atomic<uint64_t> write_time_us_;
+  std::atomic<uint64_t> max_write_time_us_;
   AVStream *video_stream_, *audio_stream_;
   AVFormatContext *context_;
+  FILE *file_;  // backs context_->pb when recording to a local file
+  std::string output_url_;
+  RecordingSegmentation segmentation_;
+  int segment_number_;
+  int64_t segment_start_ms_;
+  int64_t last_video_ms_;
+  std::ofstream index_;
 
   uint32_t video_source_ssrc_;
-  std::unique_ptr<Depacketizer> depacketizer_;
+  std::unique_ptr<FrameAssembler> frame_assembler_;
+  time_point last_keyframe_request_;
 
   // Timestamping strategy: we use the RTP timestamps so we don't have to restamp and we're not
   // subject to error due to the RTP packet queue depth and playout.
@@ -119,20 +186,30 @@ class ExternalOutput : public MediaSink, public RawDataReceiver, public Feedback
   std::shared_ptr<HandlerManager> handler_manager_;
   RtpExtensionProcessor ext_processor_;
 
+  bool createContext(const std::string& url);
   bool initContext();
+  bool openIo();
+  void closeIo();
+  void maybeStartNewSegment(int64_t timestamp_ms);
+  void closeContext(int64_t end_ms, bool last_segment);
   int sendFirPacket();
   void asyncTask(std::function<void(std::shared_ptr<ExternalOutput>)> f);
   void queueData(char* buffer, int length, packetType type);
   void queueDataAsync(std::shared_ptr<DataPacket> copied_packet);
-  void sendLoop();
+  void scheduleWrite();
+  void writeQueuedData();
+  void closeOutput();
+  bool shouldDropVideo(const DataPacket& packet);
+  void updateStats();
   int deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<DataPacket> video_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void writeAudioData(char* buf, int len);
-  void writeVideoData(char* buf, int len);
+  void writeVideoData(std::shared_ptr<DataPacket> video_packet);
   void updateVideoCodec(RtpMap map);
   void updateAudioCodec(RtpMap map);
-  void maybeWriteVideoPacket(char* buf, int len);
+  void writeVideoFrame(const AssembledFrame& frame);
+  void maybeRequestKeyframe();
   void initializePipeline();
   void syncClose();
   AVDictionary* genVideoMetadata();
@@ -0,0 +1,158 @@
+#include "media/FrameAssembler.h"
+
+#include <cstring>
+
+#include "rtp/RtpHeaders.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(FrameAssembler, "media.FrameAssembler");
+
+constexpr size_t FrameAssembler::kMaxFramesInFlight;
+constexpr int FrameAssembler::kMaxReorderDelayMs;
+
+FrameAssembler::FrameAssembler(std::unique_ptr<Depacketizer> depacketizer, uint32_t clock_rate,
+                               FrameCallback callback, std::shared_ptr<FrameBufferPool> pool)
+  : depacketizer_{std::move(depacketizer)}, max_reorder_delay_{int64_t{kMaxReorderDelayMs} * clock_rate / 1000},
+    callback_{callback}, pool_{pool}, newest_timestamp_{-1}, last_emitted_timestamp_{-1},
+    last_emitted_sequence_number_{-1}, waiting_for_keyframe_{true} {
+  // Unwrapped values start one wrap around above zero, so packets reordered around the first ones stay positive
+  sequence_number_unwrapper_.UpdateLast(1 << 16);
+}
+
+void FrameAssembler::reset() {
+  frames_.clear();
+  sequence_number_unwrapper_.UpdateLast(1 << 16);
+  newest_timestamp_ = -1;
+  last_emitted_timestamp_ = -1;
+  last_emitted_sequence_number_ = -1;
+  waiting_for_keyframe_ = true;
+  depacketizer_->reset();
+}
+
+int64_t FrameAssembler::unwrapTimestamp(uint32_t timestamp) {
+  if (newest_timestamp_ == -1) {
+    newest_timestamp_ = (int64_t{1} << 32) + timestamp;
+    return newest_timestamp_;
+  }
+  int64_t unwrapped = newest_timestamp_ + static_cast<int32_t>(timestamp - static_cast<uint32_t>(newest_timestamp_));
+  if (unwrapped > newest_timestamp_) {
+    newest_timestamp_ = unwrapped;
+  }
+  return unwrapped;
+}
+
+void FrameAssembler::addPacket(std::shared_ptr<DataPacket> packet) {
+  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(packet->data);
+  int64_t timestamp = unwrapTimestamp(head->getTimestamp());
+  if (timestamp <= last_emitted_timestamp_) {
+    if (last_emitted_timestamp_ - timestamp <= max_reorder_delay_) {
+      stats_.late_packets++;
+      return;
+    }
+    ELOG_DEBUG("message: Timestamp jumped backwards, restarting, timestamp: %u", head->getTimestamp());
+    reset();
+    timestamp = unwrapTimestamp(head->getTimestamp());
+  }
+  int64_t sequence_number = sequence_number_unwrapper_.Unwrap(head->getSeqNumber());
+
+  PendingFrame& frame = frames_[timestamp];
+  if (frame.packets.find(sequence_number) != frame.packets.end()) {
+    stats_.duplicate_packets++;
+    return;
+  }
+  frame.timestamp = head->getTimestamp();
+  depacketizer_->fetchPacket(reinterpret_cast<unsigned char*>(packet->data), packet->length);
+  frame.is_keyframe |= depacketizer_->isKeyframe();
+  if (depacketizer_->isFrameStart()) {
+    frame.first_sequence_number = sequence_number;
+  }
+  if (head->getMarker()) {
+    frame.last_sequence_number = sequence_number;
+  }
+  frame.packets[sequence_number] = std::move(packet);
+  depacketizer_->reset();
+
+  releaseFrames();
+}
+
+bool FrameAssembler::isComplete(const PendingFrame& frame) const {
+  if (frame.packets.empty() || frame.last_sequence_number == -1) {
+    return false;
+  }
+  int64_t first_sequence_number = frame.first_sequence_number;
+  if (first_sequence_number == -1 && last_emitted_sequence_number_ != -1) {
+    // Only called for the oldest frame, so it starts right after the end of the last emitted one
+    first_sequence_number = last_emitted_sequence_number_ + 1;
+  }
+  return first_sequence_number != -1 &&
+      frame.packets.begin()->first == first_sequence_number &&
+      frame.packets.rbegin()->first == frame.last_sequence_number &&
+      static_cast<int64_t>(frame.packets.size()) == frame.last_sequence_number - first_sequence_number + 1;
+}
+
+void FrameAssembler::releaseFrames() {
+  while (!frames_.empty()) {
+    auto oldest = frames_.begin();
+    bool complete = isComplete(oldest->second);
+    if (!complete && frames_.size() <= kMaxFramesInFlight &&
+        newest_timestamp_ - oldest->first <= max_reorder_delay_) {
+      // Missing packets may still arrive
+      return;
+    }
+    last_emitted_timestamp_ = oldest->first;
+    emitFrame(oldest->second, complete);
+    frames_.erase(oldest);
+  }
+}
+
+void FrameAssembler::flush() {
+  while (!frames_.empty()) {
+    auto oldest = frames_.begin();
+    last_emitted_timestamp_ = oldest->first;
+    emitFrame(oldest->second, isComplete(oldest->second));
+    frames_.erase(oldest);
+  }
+}
+
+void FrameAssembler::emitFrame(const PendingFrame& frame, bool complete) {
+  // Whole frames lost since the last one leave no trace in this frame's packets
+  bool follows_lost_frames = last_emitted_sequence_number_ != -1 && frame.first_sequence_number != -1 &&
+      frame.first_sequence_number != last_emitted_sequence_number_ + 1;
+  last_emitted_sequence_number_ = frame.last_sequence_number;
+  if (complete) {
+    stats_.complete_frames++;
+    if (frame.is_keyframe) {
+      waiting_for_keyframe_ = false;
+    } else if (follows_lost_frames) {
+      waiting_for_keyframe_ = true;
+    }
+  } else {
+    stats_.incomplete_frames++;
+    waiting_for_keyframe_ = true;
+  }
+
+  depacketizer_->reset();
+  for (const auto& sequenced_packet : frame.packets) {
+    const std::shared_ptr<DataPacket>& packet = sequenced_packet.second;
+    depacketizer_->fetchPacket(reinterpret_cast<unsigned char*>(packet->data), packet->length);
+    depacketizer_->processPacket();
+  }
+  int size = depacketizer_->frameSize();
+  if (size == 0) {
+    depacketizer_->reset();
+    return;
+  }
+
+  AssembledFrame assembled;
+  assembled.buffer = pool_->allocate(size);
+  std::memcpy(assembled.buffer->data(), depacketizer_->frame(), size);
+  depacketizer_->reset();
+  assembled.timestamp = frame.timestamp;
+  assembled.is_keyframe = frame.is_keyframe;
+  assembled.is_complete = complete;
+  assembled.is_decodable = complete && !waiting_for_keyframe_;
+  callback_(assembled);
+}
+
+}  // namespace erizo
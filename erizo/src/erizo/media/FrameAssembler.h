@@ -0,0 +1,101 @@
+#ifndef ERIZO_SRC_ERIZO_MEDIA_FRAMEASSEMBLER_H_
+#define ERIZO_SRC_ERIZO_MEDIA_FRAMEASSEMBLER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "./MediaDefinitions.h"
+#include "./logger.h"
+#include "lib/FrameBufferPool.h"
+#include "media/Depacketizer.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace erizo {
+
+struct AssembledFrame {
+  FrameBufferPtr buffer;
+  uint32_t timestamp = 0;
+  bool is_keyframe = false;
+  // Every packet of the frame was received
+  bool is_complete = false;
+  // Complete, and so were all the frames since the last complete keyframe
+  bool is_decodable = false;
+
+  unsigned char* data() const {
+    return buffer->data();
+  }
+
+  int size() const {
+    return buffer->size();
+  }
+};
+
+struct FrameAssemblerStats {
+  uint64_t complete_frames = 0;
+  uint64_t incomplete_frames = 0;
+  uint64_t late_packets = 0;
+  uint64_t duplicate_packets = 0;
+};
+
+/**
+ * Groups rtp packets by timestamp into frames. Several frames can be in flight at the same time, so packets
+ * reordered within the window complete their frame instead of breaking it. Frames are emitted in timestamp order
+ * once they are complete, or incomplete when they fall out of the window. Not thread safe.
+ */
+class FrameAssembler {
+  DECLARE_LOGGER();
+
+ public:
+  typedef std::function<void(const AssembledFrame&)> FrameCallback;
+
+  static constexpr size_t kMaxFramesInFlight = 30;
+  static constexpr int kMaxReorderDelayMs = 100;
+
+  FrameAssembler(std::unique_ptr<Depacketizer> depacketizer, uint32_t clock_rate, FrameCallback callback,
+                 std::shared_ptr<FrameBufferPool> pool = std::make_shared<FrameBufferPool>());
+
+  void addPacket(std::shared_ptr<DataPacket> packet);
+  // Emits the frames that are still in flight, complete or not
+  void flush();
+  void reset();
+
+  bool isWaitingForKeyframe() const {
+    return waiting_for_keyframe_;
+  }
+
+  FrameAssemblerStats getStats() const {
+    return stats_;
+  }
+
+ private:
+  struct PendingFrame {
+    uint32_t timestamp = 0;
+    std::map<int64_t, std::shared_ptr<DataPacket>> packets;
+    int64_t first_sequence_number = -1;
+    int64_t last_sequence_number = -1;
+    bool is_keyframe = false;
+  };
+
+  int64_t unwrapTimestamp(uint32_t timestamp);
+  bool isComplete(const PendingFrame& frame) const;
+  void releaseFrames();
+  void emitFrame(const PendingFrame& frame, bool complete);
+
+ private:
+  std::unique_ptr<Depacketizer> depacketizer_;
+  int64_t max_reorder_delay_;
+  FrameCallback callback_;
+  std::shared_ptr<FrameBufferPool> pool_;
+  std::map<int64_t, PendingFrame> frames_;
+  webrtc::SequenceNumberUnwrapper sequence_number_unwrapper_;
+  int64_t newest_timestamp_;
+  int64_t last_emitted_timestamp_;
+  int64_t last_emitted_sequence_number_;
+  bool waiting_for_keyframe_;
+  FrameAssemblerStats stats_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_MEDIA_FRAMEASSEMBLER_H_
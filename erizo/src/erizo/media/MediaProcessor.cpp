@@ -279,14 +279,12 @@ int InputProcessor::unpackageVideo(unsigned char* inBuff, int inBuffLen, unsigne
   int l = inBuffLen - head->getHeaderLength();
   inBuffOffset += head->getHeaderLength();
 
-  erizo::RTPPayloadVP8* parsed = pars.parseVP8((unsigned char*) &inBuff[inBuffOffset], l);
-  memcpy(outBuff, parsed->data, parsed->dataLength);
+  erizo::RTPPayloadVP8 parsed = pars.parseVP8((unsigned char*) &inBuff[inBuffOffset], l);
+  memcpy(outBuff, parsed.data, parsed.dataLength);
   if (head->getMarker()) {
     *gotFrame = 1;
   }
-  int ret = parsed->dataLength;
-  delete parsed;
-  return ret;
+  return parsed.dataLength;
 }
 
 void InputProcessor::closeSink() {
@@ -400,6 +398,10 @@ void OutputProcessor::receiveRawData(const RawDataPacket& packet) {
   // av_free_packet(&pkt);
 }
 
+void OutputProcessor::requestKeyframe() {
+  vCoder.requestKeyframe();
+}
+
 bool OutputProcessor::initAudioCoder() {
   aCoder = avcodec_find_encoder(static_cast<AVCodecID>(mediaInfo.audioCodec.codec));
   if (!aCoder) {
@@ -141,6 +141,7 @@ class OutputProcessor: public RawDataReceiver {
   int init(const MediaInfo& info, RTPDataReceiver* rtpReceiver);
   void close();
   void receiveRawData(const RawDataPacket& packet);
+  void requestKeyframe();
 
   int packageAudio(unsigned char* inBuff, int inBuffLen, unsigned char* outBuff, long int pts = 0);  // NOLINT
 
@@ -5,10 +5,13 @@
 #include <map>
 #include <string>
 #include <cstring>
+#include <utility>
 
 #include "media/OneToManyTranscoder.h"
 #include "./MediaStream.h"
 #include "rtp/RtpHeaders.h"
+#include "rtp/RtpUtils.h"
+#include "rtp/RtpVP8Parser.h"
 
 using std::memcpy;
 
@@ -16,44 +19,42 @@ namespace erizo {
 
 DEFINE_LOGGER(OneToManyTranscoder, "media.OneToManyTranscoder");
 
-OneToManyTranscoder::OneToManyTranscoder() {
+constexpr duration OneToManyTranscoder::kBandwidthPollInterval;
+constexpr duration OneToManyTranscoder::kMinKeyframeRequestInterval;
+
+static constexpr uint32_t kTranscoderSSRC = 55543;
+
+static bool isKeyframeStart(const std::shared_ptr<DataPacket>& packet) {
+  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(packet->data);
+  int header_length = head->getHeaderLength();
+  RtpVP8Parser parser;
+  RTPPayloadVP8 payload = parser.parseVP8(reinterpret_cast<const unsigned char*>(packet->data) + header_length,
+                                          packet->length - header_length);
+  return payload.frameType == kVP8IFrame && payload.beginningOfPartition && payload.partitionID == 0;
+}
+
+OneToManyTranscoder::OneToManyTranscoder(std::vector<TranscodingRendition> renditions)
+    : last_bandwidth_poll_{clock::now()}, last_keyframe_request_{} {
   publisher = NULL;
   sentPackets_ = 0;
-  ip_ = new InputProcessor();
-  MediaInfo m;
-  m.processorType = RTP_ONLY;
-  // m.videoCodec.bitRate = 2000000;
-  // ELOG_DEBUG("m.videoCodec.bitrate %d\n", m.videoCodec.bitRate);
-  m.hasVideo = true;
-  m.videoCodec.width = 640;
-  m.videoCodec.height = 480;
-  m.hasAudio = false;
-
-  ELOG_DEBUG("init ip");
-  ip_->init(m, this);
-
-  MediaInfo om;
-  om.processorType = RTP_ONLY;
-  om.videoCodec.bitRate = 2000000;
-  om.videoCodec.width = 640;
-  om.videoCodec.height = 480;
-  om.videoCodec.frameRate = 20;
-  om.hasVideo = true;
-  // om.url = "file://tmp/test.mp4";
-
-  om.hasAudio = false;
-
-  op_ = new OutputProcessor();
-  op_->init(om, this);
+  ladder_ = std::make_shared<TranscodingLadder>(std::move(renditions),
+      [this] (size_t rendition, std::shared_ptr<DataPacket> packet) {
+        onRenditionPacket(rendition, packet);
+      });
+  frame_assembler_.reset(new FrameAssembler(std::unique_ptr<Depacketizer>(new Vp8Depacketizer()), 90000,
+      [this] (const AssembledFrame& frame) {
+        onAssembledFrame(frame);
+      }));
 }
 
 OneToManyTranscoder::~OneToManyTranscoder() {
+  // Renditions stop delivering packets before the subscribers go away
+  ladder_->close();
   this->closeAll();
-  delete ip_; ip_ = NULL;
-  delete op_; op_ = NULL;
 }
 
 int OneToManyTranscoder::deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
   if (subscribers.empty() || audio_packet->length <= 0)
   return 0;
 
@@ -71,7 +72,10 @@ int OneToManyTranscoder::deliverVideoData_(std::shared_ptr<DataPacket> video_pac
   // theHead->getPayloadType());
 
   if (theHead->getPayloadType() == 100) {
-    ip_->deliverVideoData(video_packet);
+    frame_assembler_->addPacket(video_packet);
+    if (clock::now() - last_bandwidth_poll_ >= kBandwidthPollInterval) {
+      pollBandwidthEstimates();
+    }
   } else {
     memcpy(sendVideoBuffer_, video_packet->data, video_packet->length);
     this->receiveRtpData((unsigned char*) sendVideoBuffer_, video_packet->length);
@@ -85,12 +89,49 @@ int OneToManyTranscoder::deliverEvent_(MediaEventPtr event) {
   return 0;
 }
 
-void OneToManyTranscoder::receiveRawData(const RawDataPacket& pkt) {
-  // ELOG_DEBUG("Received %d", pkt.length);
-  op_->receiveRawData(pkt);
+void OneToManyTranscoder::onAssembledFrame(const AssembledFrame& frame) {
+  if (!frame.is_decodable) {
+    maybeRequestPublisherKeyframe();
+    return;
+  }
+  ladder_->addFrame(frame);
+}
+
+void OneToManyTranscoder::maybeRequestPublisherKeyframe() {
+  time_point now = clock::now();
+  if (publisher == NULL || now - last_keyframe_request_ < kMinKeyframeRequestInterval) {
+    return;
+  }
+  last_keyframe_request_ = now;
+  FeedbackSink* feedback_sink = publisher->getFeedbackSink();
+  if (feedback_sink) {
+    feedback_sink->deliverFeedback(RtpUtils::createPLI(publisher->getVideoSourceSSRC(), kTranscoderSSRC));
+  }
+}
+
+void OneToManyTranscoder::onRenditionPacket(size_t rendition, std::shared_ptr<DataPacket> packet) {
+  bool keyframe_start = isKeyframeStart(packet);
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  for (auto& subscriber_state : subscriber_states_) {
+    SubscriberState& state = subscriber_state.second;
+    if (keyframe_start && rendition == state.target_rendition) {
+      // Renditions are independent streams, subscribers can only move to another one at a keyframe
+      state.rendition = rendition;
+      state.started = true;
+    }
+    auto subscriber = subscribers.find(subscriber_state.first);
+    if (!state.started || state.rendition != rendition || subscriber == subscribers.end()) {
+      continue;
+    }
+    // Every subscriber gets a single sequence number space, whatever the rendition
+    auto subscriber_packet = std::make_shared<DataPacket>(*packet);
+    reinterpret_cast<RtpHeader*>(subscriber_packet->data)->setSeqNumber(state.sequence_number++);
+    subscriber->second->deliverVideoData(subscriber_packet);
+  }
 }
 
 void OneToManyTranscoder::receiveRtpData(unsigned char*rtpdata, int len) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
   if (subscribers.empty() || len <= 0)
   return;
   std::map<std::string, MediaSink*>::iterator it;
@@ -102,15 +143,69 @@ void OneToManyTranscoder::receiveRtpData(unsigned char*rtpdata, int len) {
   sentPackets_++;
 }
 
+void OneToManyTranscoder::setTargetRendition(SubscriberState* state, uint64_t bitrate) {
+  size_t target = TranscodingLadder::selectRendition(ladder_->getRenditions(), bitrate);
+  if (target == state->target_rendition) {
+    return;
+  }
+  state->target_rendition = target;
+  if (!state->started || state->rendition != target) {
+    ladder_->requestKeyframe(target);
+  }
+}
+
+void OneToManyTranscoder::updateSubscriberBandwidth(const std::string& peer_id, uint64_t bitrate) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  auto state = subscriber_states_.find(peer_id);
+  if (state != subscriber_states_.end()) {
+    setTargetRendition(&state->second, bitrate);
+  }
+}
+
+void OneToManyTranscoder::pollBandwidthEstimates() {
+  last_bandwidth_poll_ = clock::now();
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  for (auto& subscriber_state : subscriber_states_) {
+    auto subscriber = subscribers.find(subscriber_state.first);
+    if (subscriber == subscribers.end()) {
+      continue;
+    }
+    MediaStream* stream = dynamic_cast<MediaStream*>(subscriber->second);
+    uint64_t bitrate = stream ? stream->getSenderBandwidthEstimate() : 0;
+    if (bitrate > 0) {
+      setTargetRendition(&subscriber_state.second, bitrate);
+    }
+  }
+}
+
+std::string OneToManyTranscoder::getSubscriberRendition(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  auto state = subscriber_states_.find(peer_id);
+  if (state == subscriber_states_.end() || !state->second.started) {
+    return "";
+  }
+  return ladder_->getRenditions()[state->second.rendition].id;
+}
+
 void OneToManyTranscoder::setPublisher(MediaSource* webRtcConn) {
   this->publisher = webRtcConn;
 }
 
 void OneToManyTranscoder::addSubscriber(MediaSink* webRtcConn, const std::string& peerId) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
   this->subscribers[peerId] = webRtcConn;
+  // Subscribers without an estimate yet start with the lowest rendition
+  MediaStream* stream = dynamic_cast<MediaStream*>(webRtcConn);
+  uint64_t bitrate = stream ? stream->getSenderBandwidthEstimate() : 0;
+  SubscriberState state;
+  state.target_rendition = TranscodingLadder::selectRendition(ladder_->getRenditions(), bitrate);
+  subscriber_states_[peerId] = state;
+  ladder_->requestKeyframe(state.target_rendition);
 }
 
 void OneToManyTranscoder::removeSubscriber(const std::string& peerId) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  subscriber_states_.erase(peerId);
   if (this->subscribers.find(peerId) != subscribers.end()) {
     delete this->subscribers[peerId];
     this->subscribers.erase(peerId);
@@ -119,6 +214,8 @@ void OneToManyTranscoder::removeSubscriber(const std::string& peerId) {
 
 void OneToManyTranscoder::closeAll() {
   ELOG_WARN("OneToManyTranscoder closeAll");
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  subscriber_states_.clear();
   std::map<std::string, MediaSink*>::iterator it = subscribers.begin();
   while (it != subscribers.end()) {
     delete (*it).second;
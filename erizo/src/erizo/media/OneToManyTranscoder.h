@@ -6,29 +6,38 @@
 #define ERIZO_SRC_ERIZO_MEDIA_ONETOMANYTRANSCODER_H_
 
 #include <map>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
 #include "./MediaDefinitions.h"
+#include "media/FrameAssembler.h"
 #include "media/MediaProcessor.h"
+#include "media/TranscodingLadder.h"
+#include "lib/Clock.h"
 #include "./logger.h"
 
 namespace erizo {
 class MediaStream;
-class RTPSink;
 
 /**
 * Represents a One to Many connection.
-* Receives media from one publisher and retransmits it to every subscriber.
+* Receives media from one publisher, decodes its VP8 video once and encodes it again for every rendition of a
+* ladder. Every subscriber gets the rendition that fits its bandwidth estimate.
 */
-class OneToManyTranscoder : public MediaSink, public RawDataReceiver, public RTPDataReceiver {
+class OneToManyTranscoder : public MediaSink, public RTPDataReceiver {
   DECLARE_LOGGER();
 
  public:
+  static constexpr duration kBandwidthPollInterval = std::chrono::seconds(1);
+  static constexpr duration kMinKeyframeRequestInterval = std::chrono::milliseconds(500);
+
   MediaSource* publisher;
   std::map<std::string, MediaSink*> subscribers;
 
-  OneToManyTranscoder();
+  explicit OneToManyTranscoder(
+      std::vector<TranscodingRendition> renditions = TranscodingLadder::getDefaultRenditions());
   virtual ~OneToManyTranscoder();
   /**
   * Sets the Publisher
@@ -46,25 +55,41 @@ class OneToManyTranscoder : public MediaSink, public RawDataReceiver, public RTP
   * @param peerId the peerId
   */
   void removeSubscriber(const std::string& peerId);
-  void receiveRawData(const RawDataPacket& packet) override;
+  /**
+  * Moves the subscriber to the rendition that fits the bitrate, at the next keyframe of that rendition.
+  * MediaStream subscribers are updated with their own estimates periodically.
+  */
+  void updateSubscriberBandwidth(const std::string& peer_id, uint64_t bitrate);
+  // Id of the rendition the subscriber is receiving, empty until it gets its first keyframe
+  std::string getSubscriberRendition(const std::string& peer_id);
   void receiveRtpData(unsigned char*rtpdata, int len) override;
 
-  // MediaProcessor *mp;
-  InputProcessor* ip_;
-  OutputProcessor* op_;
-
  private:
+  struct SubscriberState {
+    size_t rendition = 0;
+    size_t target_rendition = 0;
+    bool started = false;
+    uint16_t sequence_number = 0;
+  };
+
   char sendVideoBuffer_[2000];
-  char sendAudioBuffer_[2000];
-  RTPSink* sink_;
-  std::vector<DataPacket> head;
-  int gotFrame_, gotDecodedFrame_, size_;
-  void sendHead(MediaStream* conn);
-  RtpVP8Parser pars;
   unsigned int sentPackets_;
+  std::unique_ptr<FrameAssembler> frame_assembler_;
+  std::shared_ptr<TranscodingLadder> ladder_;
+  std::map<std::string, SubscriberState> subscriber_states_;
+  std::mutex subscribers_mutex_;
+  time_point last_bandwidth_poll_;
+  time_point last_keyframe_request_;
+
   int deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<DataPacket> video_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
+  void onAssembledFrame(const AssembledFrame& frame);
+  void onRenditionPacket(size_t rendition, std::shared_ptr<DataPacket> packet);
+  // Needs subscribers_mutex_
+  void setTargetRendition(SubscriberState* state, uint64_t bitrate);
+  void pollBandwidthEstimates();
+  void maybeRequestPublisherKeyframe();
   /**
   * Closes all the subscribers and the publisher, the object is useless after this
   */
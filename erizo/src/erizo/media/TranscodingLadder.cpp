@@ -0,0 +1,218 @@
+#include "media/TranscodingLadder.h"
+
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "media/codecs/VideoScaler.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(RenditionEncoder, "media.RenditionEncoder");
+DEFINE_LOGGER(TranscodingLadder, "media.TranscodingLadder");
+
+constexpr unsigned int TranscodingLadder::kMaxEncoderThreads;
+constexpr double TranscodingLadder::kBandwidthUsage;
+
+static constexpr uint32_t kVideoClockRate = 90000;
+// Used until the decoder knows the size of the stream
+static constexpr int kMaxDecodedFrameSize = 1920 * 1080 * 3 / 2;
+
+RenditionEncoder::RenditionEncoder(const TranscodingRendition& rendition, size_t index, std::shared_ptr<Worker> worker,
+                                   RenditionPacketCallback callback)
+  : rendition_(rendition), index_{index}, worker_{worker}, callback_{callback},
+    min_frame_interval_{kVideoClockRate / std::max(rendition.frame_rate, 1)}, last_timestamp_{0},
+    has_last_timestamp_{false}, encoding_{false}, keyframe_requested_{false}, closed_{false}, output_width_{0},
+    output_height_{0} {
+}
+
+void RenditionEncoder::encodeFrame(FrameBufferPtr frame, int width, int height, uint32_t timestamp) {
+  if (has_last_timestamp_) {
+    int32_t elapsed = static_cast<int32_t>(timestamp - last_timestamp_);
+    // Some slack so jitter does not halve the frame rate when it matches the input one
+    if (elapsed >= 0 && static_cast<uint32_t>(elapsed) < min_frame_interval_ * 3 / 4) {
+      return;
+    }
+  }
+  if (encoding_.exchange(true)) {
+    return;
+  }
+  last_timestamp_ = timestamp;
+  has_last_timestamp_ = true;
+  std::shared_ptr<RenditionEncoder> this_ptr = shared_from_this();
+  worker_->task([this_ptr, frame, width, height] {
+    this_ptr->encode(frame, width, height);
+  });
+}
+
+void RenditionEncoder::encode(FrameBufferPtr frame, int width, int height) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_ || static_cast<int>(frame->size()) < VideoScaler::getI420Size(width, height)) {
+    encoding_ = false;
+    return;
+  }
+  if (!output_processor_) {
+    TranscodingLadder::getOutputSize(width, height, rendition_.height, &output_width_, &output_height_);
+    MediaInfo info;
+    info.processorType = RTP_ONLY;
+    info.hasVideo = true;
+    info.hasAudio = false;
+    info.videoCodec.width = output_width_;
+    info.videoCodec.height = output_height_;
+    info.videoCodec.bitRate = rendition_.bitrate;
+    info.videoCodec.frameRate = rendition_.frame_rate;
+    output_processor_.reset(new OutputProcessor());
+    output_processor_->init(info, this);
+    scaled_frame_.resize(VideoScaler::getI420Size(output_width_, output_height_));
+    ELOG_DEBUG("message: Rendition encoder created, rendition: %s, input: %dx%d, output: %dx%d",
+               rendition_.id.c_str(), width, height, output_width_, output_height_);
+  }
+  if (keyframe_requested_.exchange(false)) {
+    output_processor_->requestKeyframe();
+  }
+  VideoScaler::scaleI420(frame->data(), width, height, scaled_frame_.data(), output_width_, output_height_);
+  RawDataPacket packet;
+  packet.data = scaled_frame_.data();
+  packet.length = scaled_frame_.size();
+  packet.type = VIDEO;
+  output_processor_->receiveRawData(packet);
+  encoding_ = false;
+}
+
+void RenditionEncoder::requestKeyframe() {
+  // Not taking the lock, this is called with the subscribers locked and packets are delivered with the lock held
+  keyframe_requested_ = true;
+}
+
+void RenditionEncoder::receiveRtpData(unsigned char* rtpdata, int len) {
+  // Only called from encode, with the lock held
+  callback_(index_, std::make_shared<DataPacket>(0, reinterpret_cast<char*>(rtpdata), len, VIDEO_PACKET));
+}
+
+void RenditionEncoder::close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = true;
+  output_processor_.reset();
+}
+
+std::vector<TranscodingRendition> TranscodingLadder::getDefaultRenditions() {
+  return {
+    {"720p", 720, 1500000, 30},
+    {"360p", 360, 600000, 30},
+    {"180p", 180, 150000, 15}
+  };
+}
+
+size_t TranscodingLadder::selectRendition(const std::vector<TranscodingRendition>& renditions, uint64_t bitrate) {
+  uint64_t usable_bitrate = static_cast<uint64_t>(bitrate * kBandwidthUsage);
+  for (size_t index = 0; index < renditions.size(); index++) {
+    if (renditions[index].bitrate <= usable_bitrate) {
+      return index;
+    }
+  }
+  return renditions.empty() ? 0 : renditions.size() - 1;
+}
+
+void TranscodingLadder::getOutputSize(int input_width, int input_height, int target_height, int* width,
+                                      int* height) {
+  int output_height = std::min(target_height, input_height);
+  int output_width = input_height > 0 ? static_cast<int64_t>(input_width) * output_height / input_height : 0;
+  *width = std::max(2, output_width & ~1);
+  *height = std::max(2, output_height & ~1);
+}
+
+std::shared_ptr<ThreadPool> TranscodingLadder::getEncoderThreadPool() {
+  static std::once_flag created;
+  static std::shared_ptr<ThreadPool> encoder_thread_pool;
+  std::call_once(created, [] {
+    unsigned int threads = std::min(kMaxEncoderThreads, std::max(1u, std::thread::hardware_concurrency() / 2));
+    encoder_thread_pool = std::make_shared<ThreadPool>(threads);
+    encoder_thread_pool->start();
+  });
+  return encoder_thread_pool;
+}
+
+TranscodingLadder::TranscodingLadder(std::vector<TranscodingRendition> renditions,
+                                     RenditionPacketCallback callback)
+  : renditions_{std::move(renditions)}, decoder_worker_{getEncoderThreadPool()->getLessUsedWorker()},
+    decoded_frame_pool_{std::make_shared<FrameBufferPool>()}, decoder_inited_{false}, closed_{false} {
+  std::stable_sort(renditions_.begin(), renditions_.end(),
+                   [] (const TranscodingRendition& first, const TranscodingRendition& second) {
+    return first.bitrate > second.bitrate;
+  });
+  for (size_t index = 0; index < renditions_.size(); index++) {
+    encoders_.push_back(std::make_shared<RenditionEncoder>(renditions_[index], index,
+                                                           getEncoderThreadPool()->getLessUsedWorker(), callback));
+  }
+}
+
+TranscodingLadder::~TranscodingLadder() {
+  close();
+}
+
+void TranscodingLadder::addFrame(const AssembledFrame& frame) {
+  std::shared_ptr<TranscodingLadder> this_ptr = shared_from_this();
+  decoder_worker_->task([this_ptr, frame] {
+    this_ptr->decode(frame);
+  });
+}
+
+void TranscodingLadder::decode(const AssembledFrame& frame) {
+  std::lock_guard<std::mutex> lock(decoder_mutex_);
+  if (closed_) {
+    return;
+  }
+  if (!decoder_inited_) {
+    VideoCodecInfo info;
+    info.codec = VIDEO_CODEC_VP8;
+    info.payloadType = 0;
+    info.width = 0;
+    info.height = 0;
+    info.bitRate = 0;
+    info.frameRate = 0;
+    if (decoder_.initDecoder(info) != 0) {
+      ELOG_ERROR("message: Error initializing the decoder");
+      closed_ = true;
+      return;
+    }
+    decoder_inited_ = true;
+  }
+
+  int width = decoder_.getWidth();
+  int height = decoder_.getHeight();
+  int buffer_size = width > 0 && height > 0 ? VideoScaler::getI420Size(width, height) : kMaxDecodedFrameSize;
+  FrameBufferPtr decoded = decoded_frame_pool_->allocate(buffer_size);
+  int got_frame = 0;
+  int decoded_size = decoder_.decodeVideo(frame.data(), frame.size(), decoded->data(), buffer_size, &got_frame);
+  if (!got_frame || decoded_size <= 0) {
+    return;
+  }
+  if (decoded_size > buffer_size) {
+    // The size changed, the next frames will get buffers that fit
+    ELOG_DEBUG("message: Decoded frame size changed, width: %d, height: %d",
+               decoder_.getWidth(), decoder_.getHeight());
+    return;
+  }
+  decoded->resize(decoded_size);
+  for (const std::shared_ptr<RenditionEncoder>& encoder : encoders_) {
+    encoder->encodeFrame(decoded, decoder_.getWidth(), decoder_.getHeight(), frame.timestamp);
+  }
+}
+
+void TranscodingLadder::requestKeyframe(size_t rendition) {
+  if (rendition < encoders_.size()) {
+    encoders_[rendition]->requestKeyframe();
+  }
+}
+
+void TranscodingLadder::close() {
+  {
+    std::lock_guard<std::mutex> lock(decoder_mutex_);
+    closed_ = true;
+  }
+  for (const std::shared_ptr<RenditionEncoder>& encoder : encoders_) {
+    encoder->close();
+  }
+}
+
+}  // namespace erizo
@@ -0,0 +1,117 @@
+#ifndef ERIZO_SRC_ERIZO_MEDIA_TRANSCODINGLADDER_H_
+#define ERIZO_SRC_ERIZO_MEDIA_TRANSCODINGLADDER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "./MediaDefinitions.h"
+#include "./logger.h"
+#include "lib/FrameBufferPool.h"
+#include "media/FrameAssembler.h"
+#include "media/MediaProcessor.h"
+#include "thread/ThreadPool.h"
+
+namespace erizo {
+
+struct TranscodingRendition {
+  std::string id;
+  int height;
+  uint32_t bitrate;
+  int frame_rate;
+};
+
+typedef std::function<void(size_t rendition, std::shared_ptr<DataPacket> packet)> RenditionPacketCallback;
+
+/**
+ * Scales and encodes the decoded frames of one rendition. Everything runs on a single worker, frames that arrive
+ * while the previous one is still being encoded, or sooner than the frame rate allows, are skipped.
+ */
+class RenditionEncoder : public RTPDataReceiver, public std::enable_shared_from_this<RenditionEncoder> {
+  DECLARE_LOGGER();
+
+ public:
+  RenditionEncoder(const TranscodingRendition& rendition, size_t index, std::shared_ptr<Worker> worker,
+                   RenditionPacketCallback callback);
+
+  // Called for every decoded frame, always from the same thread
+  void encodeFrame(FrameBufferPtr frame, int width, int height, uint32_t timestamp);
+  void requestKeyframe();
+  // No packets are delivered once this returns
+  void close();
+
+  void receiveRtpData(unsigned char* rtpdata, int len) override;
+
+ private:
+  void encode(FrameBufferPtr frame, int width, int height);
+
+ private:
+  TranscodingRendition rendition_;
+  size_t index_;
+  std::shared_ptr<Worker> worker_;
+  RenditionPacketCallback callback_;
+  uint32_t min_frame_interval_;
+  uint32_t last_timestamp_;
+  bool has_last_timestamp_;
+  std::atomic<bool> encoding_;
+  std::atomic<bool> keyframe_requested_;
+  std::mutex mutex_;
+  bool closed_;
+  // The output size is set by the first frame, later frames are scaled to it
+  std::unique_ptr<OutputProcessor> output_processor_;
+  int output_width_;
+  int output_height_;
+  std::vector<unsigned char> scaled_frame_;
+};
+
+/**
+ * Decodes the frames of a VP8 publisher once and encodes them again for every rendition of the ladder. Decoding and
+ * every rendition run in parallel in workers of a shared pool. Renditions are sorted by bitrate, highest first.
+ */
+class TranscodingLadder : public std::enable_shared_from_this<TranscodingLadder> {
+  DECLARE_LOGGER();
+
+ public:
+  static constexpr unsigned int kMaxEncoderThreads = 8;
+  // Only this share of the bandwidth estimate is used to pick a rendition, there is audio and overhead too
+  static constexpr double kBandwidthUsage = 0.85;
+
+  static std::vector<TranscodingRendition> getDefaultRenditions();
+  // Highest rendition whose bitrate fits in the estimate, the lowest one when none does
+  static size_t selectRendition(const std::vector<TranscodingRendition>& renditions, uint64_t bitrate);
+  // Keeps the input aspect ratio, never upscales and rounds down to even sizes
+  static void getOutputSize(int input_width, int input_height, int target_height, int* width, int* height);
+  static std::shared_ptr<ThreadPool> getEncoderThreadPool();
+
+  TranscodingLadder(std::vector<TranscodingRendition> renditions, RenditionPacketCallback callback);
+  virtual ~TranscodingLadder();
+
+  // Only decodable frames, see FrameAssembler
+  void addFrame(const AssembledFrame& frame);
+  void requestKeyframe(size_t rendition);
+  void close();
+
+  const std::vector<TranscodingRendition>& getRenditions() const {
+    return renditions_;
+  }
+
+ private:
+  void decode(const AssembledFrame& frame);
+
+ private:
+  std::vector<TranscodingRendition> renditions_;
+  std::shared_ptr<Worker> decoder_worker_;
+  std::shared_ptr<FrameBufferPool> decoded_frame_pool_;
+  std::vector<std::shared_ptr<RenditionEncoder>> encoders_;
+  std::mutex decoder_mutex_;
+  VideoDecoder decoder_;
+  bool decoder_inited_;
+  bool closed_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_MEDIA_TRANSCODINGLADDER_H_
@@ -23,7 +23,7 @@ inline AVCodecID VideoCodecID2ffmpegDecoderID(VideoCodecID codec) {
   }
 }
 
-VideoEncoder::VideoEncoder() {
+VideoEncoder::VideoEncoder() : keyframe_requested_{false} {
   avcodec_register_all();
   vCoder = NULL;
   vCoderContext = NULL;
@@ -96,6 +96,7 @@ int VideoEncoder::encodeVideo(unsigned char* inBuffer, int inLength, unsigned ch
   cPicture->linesize[0] = vCoderContext->width;
   cPicture->linesize[1] = vCoderContext->width / 2;
   cPicture->linesize[2] = vCoderContext->width / 2;
+  cPicture->pict_type = keyframe_requested_.exchange(false) ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
 
   AVPacket pkt;
   av_init_packet(&pkt);
@@ -127,6 +128,9 @@ int VideoEncoder::closeEncoder() {
   return 0;
 }
 
+void VideoEncoder::requestKeyframe() {
+  keyframe_requested_ = true;
+}
 
 VideoDecoder::VideoDecoder() {
   avcodec_register_all();
@@ -282,6 +286,14 @@ decoding:
   return outSize * 3 / 2;
 }
 
+int VideoDecoder::getWidth() const {
+  return vDecoderContext ? vDecoderContext->width : 0;
+}
+
+int VideoDecoder::getHeight() const {
+  return vDecoderContext ? vDecoderContext->height : 0;
+}
+
 int VideoDecoder::closeDecoder() {
   if (!initWithContext_ && vDecoderContext != NULL)
     avcodec_close(vDecoderContext);
@@ -5,6 +5,8 @@
 #ifndef ERIZO_SRC_ERIZO_MEDIA_CODECS_VIDEOCODEC_H_
 #define ERIZO_SRC_ERIZO_MEDIA_CODECS_VIDEOCODEC_H_
 
+#include <atomic>
+
 #include "media/codecs/Codecs.h"
 #include "./logger.h"
 
@@ -33,11 +35,14 @@ class VideoEncoder {
   int initEncoder(const VideoCodecInfo& info);
   int encodeVideo(unsigned char* inBuffer, int length, unsigned char* outBuffer, int outLength);
   int closeEncoder();
+  // The next encoded frame will be a keyframe, can be called from any thread
+  void requestKeyframe();
 
  private:
   AVCodec* vCoder;
   AVCodecContext* vCoderContext;
   AVFrame* cPicture;
+  std::atomic<bool> keyframe_requested_;
 };
 
 class VideoDecoder {
@@ -51,6 +56,9 @@ class VideoDecoder {
   int decodeVideo(unsigned char* inBuff, int inBuffLen,
       unsigned char* outBuff, int outBuffLen, int* gotFrame);
   int closeDecoder();
+  // Size of the last decoded frame
+  int getWidth() const;
+  int getHeight() const;
 
  private:
   AVCodec* vDecoder;
@@ -0,0 +1,62 @@
+/**
+ * VideoScaler.cpp
+ */
+#include "media/codecs/VideoScaler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace erizo {
+
+int VideoScaler::getI420Size(int width, int height) {
+  return width * height * 3 / 2;
+}
+
+void VideoScaler::scaleI420(const unsigned char* src, int src_width, int src_height,
+                            unsigned char* dst, int dst_width, int dst_height) {
+  int src_size = src_width * src_height;
+  int dst_size = dst_width * dst_height;
+  if (src_width == dst_width && src_height == dst_height) {
+    std::memcpy(dst, src, getI420Size(src_width, src_height));
+    return;
+  }
+  scalePlane(src, src_width, src_height, dst, dst_width, dst_height);
+  scalePlane(src + src_size, src_width / 2, src_height / 2,
+             dst + dst_size, dst_width / 2, dst_height / 2);
+  scalePlane(src + src_size + src_size / 4, src_width / 2, src_height / 2,
+             dst + dst_size + dst_size / 4, dst_width / 2, dst_height / 2);
+}
+
+void VideoScaler::scalePlane(const unsigned char* src, int src_width, int src_height,
+                             unsigned char* dst, int dst_width, int dst_height) {
+  if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+    return;
+  }
+  // Source columns covered by every destination column, the same for every row
+  std::vector<int> column_start(dst_width + 1);
+  for (int x = 0; x <= dst_width; x++) {
+    column_start[x] = x * src_width / dst_width;
+  }
+
+  for (int y = 0; y < dst_height; y++) {
+    int row_start = y * src_height / dst_height;
+    int row_end = std::max(row_start + 1, (y + 1) * src_height / dst_height);
+    unsigned char* dst_row = dst + y * dst_width;
+    for (int x = 0; x < dst_width; x++) {
+      int first_column = column_start[x];
+      int last_column = std::max(first_column + 1, column_start[x + 1]);
+      unsigned int sum = 0;
+      for (int row = row_start; row < row_end; row++) {
+        const unsigned char* src_row = src + row * src_width;
+        for (int column = first_column; column < last_column; column++) {
+          sum += src_row[column];
+        }
+      }
+      unsigned int count = (row_end - row_start) * (last_column - first_column);
+      dst_row[x] = static_cast<unsigned char>((sum + count / 2) / count);
+    }
+  }
+}
+
+}  // namespace erizo
@@ -0,0 +1,27 @@
+/**
+ * VideoScaler.h
+ */
+
+#ifndef ERIZO_SRC_ERIZO_MEDIA_CODECS_VIDEOSCALER_H_
+#define ERIZO_SRC_ERIZO_MEDIA_CODECS_VIDEOSCALER_H_
+
+namespace erizo {
+
+/**
+ * Resizes raw I420 frames laid out as the VideoDecoder writes them (Y, U and V planes back to back, no padding).
+ * Every destination pixel is the average of the source pixels it covers, which is cheap and avoids aliasing when
+ * downscaling. Upscaling falls back to nearest neighbour.
+ */
+class VideoScaler {
+ public:
+  static int getI420Size(int width, int height);
+
+  static void scaleI420(const unsigned char* src, int src_width, int src_height,
+                        unsigned char* dst, int dst_width, int dst_height);
+
+  static void scalePlane(const unsigned char* src, int src_width, int src_height,
+                         unsigned char* dst, int dst_width, int dst_height);
+};
+
+}  // namespace erizo
+#endif  // ERIZO_SRC_ERIZO_MEDIA_CODECS_VIDEOSCALER_H_
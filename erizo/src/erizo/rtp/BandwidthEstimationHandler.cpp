@@ -75,7 +75,6 @@ void BandwidthEstimationHandler::notifyUpdate() {
   if (!stream_) {
     return;
   }
-  worker_ = stream_->getWorker();
   stats_ = pipeline->getService<Stats>();
   RtpExtensionProcessor& ext_processor = stream_->getRtpExtensionProcessor();
   if (ext_processor.getVideoExtensionMap().size() == 0) {
@@ -90,7 +89,7 @@ void BandwidthEstimationHandler::notifyUpdate() {
 void BandwidthEstimationHandler::process() {
   rbe_->Process();
   std::weak_ptr<BandwidthEstimationHandler> weak_ptr = shared_from_this();
-  worker_->scheduleFromNow([weak_ptr]() {
+  stream_->scheduleFromNow([weak_ptr]() {
     if (auto this_ptr = weak_ptr.lock()) {
       this_ptr->process();
     }
@@ -69,7 +69,6 @@ class BandwidthEstimationHandler: public Handler, public RemoteBitrateObserver,
   void updateExtensionMap(bool video, std::array<RTPExtensions, 10> map);
 
   MediaStream *stream_;
-  std::shared_ptr<Worker> worker_;
   std::shared_ptr<Stats> stats_;
   webrtc::Clock* const clock_;
   std::shared_ptr<RemoteBitrateEstimatorPicker> picker_;
@@ -0,0 +1,111 @@
+#include "rtp/DelayBasedBandwidthEstimator.h"
+
+#include <vector>
+
+#include "lib/ClockUtils.h"
+
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(DelayBasedBandwidthEstimator, "rtp.DelayBasedBandwidthEstimator");
+
+constexpr uint32_t DelayBasedBandwidthEstimator::kStartBitrate;
+constexpr size_t DelayBasedBandwidthEstimator::kHistorySize;
+
+// Send times are converted to the abs-send-time format that InterArrival works with
+static constexpr int kAbsSendTimeFraction = 18;
+static constexpr int kAbsSendTimeInterArrivalUpshift = 8;
+static constexpr int kInterArrivalShift = kAbsSendTimeFraction + kAbsSendTimeInterArrivalUpshift;
+static constexpr int kTimestampGroupLengthMs = 5;
+static constexpr double kTimestampToMs = 1000.0 / static_cast<double>(1 << kInterArrivalShift);
+static constexpr int64_t kAckedBitrateWindowMs = 1000;
+static constexpr int64_t kMaxPacketAgeMs = 2000;
+
+static uint32_t toInterArrivalTimestamp(int64_t time_ms) {
+  uint32_t time_24_bits = static_cast<uint32_t>(
+    ((static_cast<uint64_t>(time_ms) << kAbsSendTimeFraction) + 500) / 1000) & 0x00FFFFFF;
+  return time_24_bits << kAbsSendTimeInterArrivalUpshift;
+}
+
+DelayBasedBandwidthEstimator::DelayBasedBandwidthEstimator(std::shared_ptr<Clock> the_clock)
+    : clock_{the_clock},
+      inter_arrival_{(kTimestampGroupLengthMs << kInterArrivalShift) / 1000, kTimestampToMs, true},
+      estimator_{webrtc::OverUseDetectorOptions()},
+      detector_{webrtc::OverUseDetectorOptions()},
+      acked_bitrate_{kAckedBitrateWindowMs, 8000},
+      last_update_ms_{-1},
+      estimated_bitrate_{kStartBitrate},
+      lost_packets_{0} {
+  rate_control_.SetEstimate(kStartBitrate, ClockUtils::timePointToMs(clock_->now()));
+}
+
+void DelayBasedBandwidthEstimator::onPacketSent(uint16_t sequence_number, size_t size) {
+  SentPacket &packet = history_[sequence_number % kHistorySize];
+  packet.send_time_ms = ClockUtils::timePointToMs(clock_->now());
+  packet.size = size;
+  packet.sequence_number = sequence_number;
+}
+
+bool DelayBasedBandwidthEstimator::onTransportFeedback(const webrtc::rtcp::TransportFeedback &feedback) {
+  int64_t now_ms = ClockUtils::timePointToMs(clock_->now());
+  std::vector<webrtc::rtcp::TransportFeedback::StatusSymbol> statuses = feedback.GetStatusVector();
+  std::vector<int64_t> deltas_us = feedback.GetReceiveDeltasUs();
+  uint16_t sequence_number = feedback.GetBaseSequence();
+  int64_t arrival_time_us = feedback.GetBaseTimeUs();
+  size_t delta_index = 0;
+  for (webrtc::rtcp::TransportFeedback::StatusSymbol status : statuses) {
+    const SentPacket &packet = history_[sequence_number % kHistorySize];
+    bool is_known = packet.send_time_ms >= 0 && packet.sequence_number == sequence_number &&
+      now_ms - packet.send_time_ms < kMaxPacketAgeMs;
+    if (status == webrtc::rtcp::TransportFeedback::StatusSymbol::kNotReceived) {
+      lost_packets_ += is_known ? 1 : 0;
+    } else if (delta_index < deltas_us.size()) {
+      arrival_time_us += deltas_us[delta_index++];
+      if (is_known) {
+        onPacketAcked(packet, arrival_time_us / 1000, now_ms);
+      }
+    }
+    sequence_number++;
+  }
+  return maybeUpdateEstimate(now_ms);
+}
+
+void DelayBasedBandwidthEstimator::onPacketAcked(const SentPacket &packet, int64_t arrival_time_ms,
+                                                 int64_t now_ms) {
+  acked_bitrate_.Update(packet.size, now_ms);
+  uint32_t timestamp_delta = 0;
+  int64_t arrival_time_delta_ms = 0;
+  int size_delta = 0;
+  if (inter_arrival_.ComputeDeltas(toInterArrivalTimestamp(packet.send_time_ms), arrival_time_ms, now_ms,
+                                   packet.size, &timestamp_delta, &arrival_time_delta_ms, &size_delta)) {
+    double timestamp_delta_ms = timestamp_delta * kTimestampToMs;
+    estimator_.Update(arrival_time_delta_ms, timestamp_delta_ms, size_delta, detector_.State(), arrival_time_ms);
+    detector_.Detect(estimator_.offset(), timestamp_delta_ms, estimator_.num_of_deltas(), arrival_time_ms);
+  }
+}
+
+bool DelayBasedBandwidthEstimator::maybeUpdateEstimate(int64_t now_ms) {
+  rtc::Optional<uint32_t> acked_bitrate = acked_bitrate_.Rate(now_ms);
+  bool update_estimate = last_update_ms_ == -1 || now_ms - last_update_ms_ > rate_control_.GetFeedbackInterval();
+  if (!update_estimate && detector_.State() == webrtc::kBwOverusing) {
+    // Overuse has to be reacted to right away instead of waiting for the next periodic update
+    update_estimate = acked_bitrate && rate_control_.TimeToReduceFurther(now_ms, *acked_bitrate);
+  }
+  if (!update_estimate) {
+    return false;
+  }
+  const webrtc::RateControlInput input(detector_.State(), acked_bitrate, estimator_.var_noise());
+  rate_control_.Update(&input, now_ms);
+  uint32_t estimated_bitrate = rate_control_.UpdateBandwidthEstimate(now_ms);
+  if (!rate_control_.ValidEstimate()) {
+    return false;
+  }
+  last_update_ms_ = now_ms;
+  estimated_bitrate_ = estimated_bitrate;
+  ELOG_DEBUG("message: Delay based estimate updated, bitrate: %u, state: %d", estimated_bitrate_,
+             detector_.State());
+  return true;
+}
+
+}  // namespace erizo
@@ -0,0 +1,70 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_DELAYBASEDBANDWIDTHESTIMATOR_H_
+#define ERIZO_SRC_ERIZO_RTP_DELAYBASEDBANDWIDTHESTIMATOR_H_
+
+#include <array>
+#include <memory>
+
+#include "./logger.h"
+#include "lib/Clock.h"
+
+#include "webrtc/base/rate_statistics.h"
+#include "webrtc/modules/remote_bitrate_estimator/aimd_rate_control.h"
+#include "webrtc/modules/remote_bitrate_estimator/inter_arrival.h"
+#include "webrtc/modules/remote_bitrate_estimator/overuse_detector.h"
+#include "webrtc/modules/remote_bitrate_estimator/overuse_estimator.h"
+
+namespace webrtc {
+namespace rtcp {
+class TransportFeedback;
+}  // namespace rtcp
+}  // namespace webrtc
+
+namespace erizo {
+
+// Send side of transport-wide congestion control. It keeps the send time of the last packets stamped with a
+// transport-wide sequence number and runs the delay based estimator with the arrival times reported in
+// transport feedback packets.
+class DelayBasedBandwidthEstimator {
+  DECLARE_LOGGER();
+
+ public:
+  static constexpr uint32_t kStartBitrate = 300000;
+  // It must cover the packets sent between two feedback packets
+  static constexpr size_t kHistorySize = 2048;
+
+  explicit DelayBasedBandwidthEstimator(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+
+  void onPacketSent(uint16_t sequence_number, size_t size);
+
+  // Returns true if there is a new estimate
+  bool onTransportFeedback(const webrtc::rtcp::TransportFeedback &feedback);
+
+  uint32_t getEstimate() { return estimated_bitrate_; }
+  uint64_t getLostPackets() { return lost_packets_; }
+
+ private:
+  struct SentPacket {
+    int64_t send_time_ms = -1;
+    uint32_t size = 0;
+    uint16_t sequence_number = 0;
+  };
+
+  void onPacketAcked(const SentPacket &packet, int64_t arrival_time_ms, int64_t now_ms);
+  bool maybeUpdateEstimate(int64_t now_ms);
+
+ private:
+  std::shared_ptr<Clock> clock_;
+  std::array<SentPacket, kHistorySize> history_;
+  webrtc::InterArrival inter_arrival_;
+  webrtc::OveruseEstimator estimator_;
+  webrtc::OveruseDetector detector_;
+  webrtc::AimdRateControl rate_control_;
+  webrtc::RateStatistics acked_bitrate_;
+  int64_t last_update_ms_;
+  uint32_t estimated_bitrate_;
+  uint64_t lost_packets_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_DELAYBASEDBANDWIDTHESTIMATOR_H_
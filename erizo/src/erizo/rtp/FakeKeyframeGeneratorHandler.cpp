@@ -6,6 +6,7 @@
 #include "./MediaDefinitions.h"
 #include "./MediaStream.h"
 #include "./RtpUtils.h"
+#include "./PayloadTypeTable.h"
 
 namespace erizo {
 
@@ -69,11 +70,12 @@ void FakeKeyframeGeneratorHandler::write(Context *ctx, std::shared_ptr<DataPacke
 
 std::shared_ptr<DataPacket> FakeKeyframeGeneratorHandler::transformIntoKeyframePacket
   (std::shared_ptr<DataPacket> packet) {
-    if (packet->codec == "VP8") {
+    if (packet->codec == RtpCodec::VP8) {
       auto keyframe_packet = RtpUtils::makeVP8BlackKeyframePacket(packet);
       return keyframe_packet;
     } else {
-      ELOG_DEBUG("Generate keyframe packet is not available for codec %s", packet->codec);
+      ELOG_DEBUG("Generate keyframe packet is not available for codec %s",
+                 PayloadTypeTable::getCodecName(packet->codec));
       return packet;
     }
   }
@@ -93,7 +95,7 @@ void FakeKeyframeGeneratorHandler::sendPLI() {
 
 void FakeKeyframeGeneratorHandler::schedulePLI() {
   std::weak_ptr<FakeKeyframeGeneratorHandler> weak_this = shared_from_this();
-  stream_->getWorker()->scheduleEvery([weak_this] {
+  stream_->scheduleEvery([weak_this] {
     if (auto this_ptr = weak_this.lock()) {
       if (!this_ptr->first_keyframe_received_) {
         ELOG_DEBUG("Sending PLI in FakeGenerator, scheduling another");
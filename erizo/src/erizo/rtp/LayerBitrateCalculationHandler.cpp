@@ -25,25 +25,37 @@ void LayerBitrateCalculationHandler::write(Context *ctx, std::shared_ptr<DataPac
     return;
   }
 
-  std::for_each(packet->compatible_spatial_layers.begin(),
-      packet->compatible_spatial_layers.end(), [this, packet](int &layer_num){
-        std::string spatial_layer_name = std::to_string(layer_num);
-        std::for_each(packet->compatible_temporal_layers.begin(),
-          packet->compatible_temporal_layers.end(), [this, packet, spatial_layer_name](int &layer_num){
-            std::string temporal_layer_name = std::to_string(layer_num);
-            if (!stats_->getNode()[kQualityLayersStatsKey][spatial_layer_name].hasChild(temporal_layer_name)) {
-              stats_->getNode()[kQualityLayersStatsKey][spatial_layer_name].insertStat(
-                  temporal_layer_name, MovingIntervalRateStat{kLayerRateStatIntervalSize,
-                  kLayerRateStatIntervals, 8.});
-            } else {
-              stats_->getNode()[kQualityLayersStatsKey][spatial_layer_name][temporal_layer_name]+=packet->length;
-            }
-          });
-      });
+  for (int spatial_layer : packet->compatible_spatial_layers) {
+    for (int temporal_layer : packet->compatible_temporal_layers) {
+      *getLayerBitrateStat(spatial_layer, temporal_layer) += packet->length;
+    }
+  }
   quality_manager_->notifyQualityUpdate();
   ctx->fireWrite(std::move(packet));
 }
 
+std::shared_ptr<MovingIntervalRateStat> LayerBitrateCalculationHandler::getLayerBitrateStat(int spatial_layer,
+    int temporal_layer) {
+  if (spatial_layer < 0 || temporal_layer < 0) {
+    return stats_->getNode()[kQualityLayersStatsKey][std::to_string(spatial_layer)].getOrInsertStat(
+        std::to_string(temporal_layer), MovingIntervalRateStat{kLayerRateStatIntervalSize,
+        kLayerRateStatIntervals, 8.});
+  }
+  if (static_cast<size_t>(spatial_layer) >= layer_bitrates_.size()) {
+    layer_bitrates_.resize(spatial_layer + 1);
+  }
+  auto &temporal_layers = layer_bitrates_[spatial_layer];
+  if (static_cast<size_t>(temporal_layer) >= temporal_layers.size()) {
+    temporal_layers.resize(temporal_layer + 1);
+  }
+  auto &layer_bitrate = temporal_layers[temporal_layer];
+  if (!layer_bitrate) {
+    layer_bitrate = stats_->getNode()[kQualityLayersStatsKey][std::to_string(spatial_layer)].getOrInsertStat(
+        std::to_string(temporal_layer), MovingIntervalRateStat{kLayerRateStatIntervalSize,
+        kLayerRateStatIntervals, 8.});
+  }
+  return layer_bitrate;
+}
 
 void LayerBitrateCalculationHandler::notifyUpdate() {
   if (initialized_) {
@@ -1,6 +1,9 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_LAYERBITRATECALCULATIONHANDLER_H_
 #define ERIZO_SRC_ERIZO_RTP_LAYERBITRATECALCULATIONHANDLER_H_
 
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "./logger.h"
 #include "pipeline/Handler.h"
@@ -30,12 +33,16 @@ class LayerBitrateCalculationHandler: public OutboundHandler {
   void write(Context *ctx, std::shared_ptr<DataPacket> packet) override;
   void notifyUpdate() override;
 
+ private:
+  std::shared_ptr<MovingIntervalRateStat> getLayerBitrateStat(int spatial_layer, int temporal_layer);
+
  private:
   const std::string kQualityLayersStatsKey = "qualityLayers";
   bool enabled_;
   bool initialized_;
   std::shared_ptr<Stats> stats_;
   std::shared_ptr<QualityManager> quality_manager_;
+  std::vector<std::vector<std::shared_ptr<MovingIntervalRateStat>>> layer_bitrates_;
 };
 }  // namespace erizo
 
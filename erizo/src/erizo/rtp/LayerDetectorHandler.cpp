@@ -34,11 +34,11 @@ void LayerDetectorHandler::disable() {
 void LayerDetectorHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
   if (!chead->isRtcp() && enabled_ && packet->type == VIDEO_PACKET) {
-    if (packet->codec == "VP8") {
+    if (packet->codec == RtpCodec::VP8) {
       parseLayerInfoFromVP8(packet);
-    } else if (packet->codec == "VP9") {
+    } else if (packet->codec == RtpCodec::VP9) {
       parseLayerInfoFromVP9(packet);
-    } else if (packet->codec == "H264") {
+    } else if (packet->codec == RtpCodec::H264) {
       parseLayerInfoFromH264(packet);
     }
   }
@@ -85,41 +85,41 @@ void LayerDetectorHandler::parseLayerInfoFromVP8(std::shared_ptr<DataPacket> pac
   RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
   unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
   start_buffer = start_buffer + rtp_header->getHeaderLength();
-  RTPPayloadVP8* payload = vp8_parser_.parseVP8(
+  RTPPayloadVP8 payload = vp8_parser_.parseVP8(
       start_buffer, packet->length - rtp_header->getHeaderLength());
-  if (payload->hasPictureID) {
-    packet->picture_id = payload->pictureID;
+  if (payload.hasPictureID) {
+    packet->picture_id = payload.pictureID;
   }
-  if (payload->hasTl0PicIdx) {
-    packet->tl0_pic_idx = payload->tl0PicIdx;
+  if (payload.hasTl0PicIdx) {
+    packet->tl0_pic_idx = payload.tl0PicIdx;
   }
-  packet->compatible_temporal_layers = {};
-  switch (payload->tID) {
-    case 0: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfPartition);
-    case 1: addTemporalLayerAndCalculateRate(packet, 1, payload->beginningOfPartition);
-    case 2: addTemporalLayerAndCalculateRate(packet, 2, payload->beginningOfPartition);
+  packet->compatible_temporal_layers.clear();
+  switch (payload.tID) {
+    case 0: addTemporalLayerAndCalculateRate(packet, 0, payload.beginningOfPartition);
+    case 1: addTemporalLayerAndCalculateRate(packet, 1, payload.beginningOfPartition);
+    case 2: addTemporalLayerAndCalculateRate(packet, 2, payload.beginningOfPartition);
     // case 3 and beyond are not handled because Chrome only
     // supports 3 temporal scalability today (03/15/17)
       break;
-    default: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfPartition);
+    default: addTemporalLayerAndCalculateRate(packet, 0, payload.beginningOfPartition);
       break;
   }
 
   int position = getSsrcPosition(rtp_header->getSSRC());
   packet->compatible_spatial_layers = {position};
-  if (!payload->frameType) {
+  if (!payload.frameType) {
     packet->is_keyframe = true;
   } else {
     packet->is_keyframe = false;
   }
 
-  if (payload->frameWidth != -1 && static_cast<uint>(payload->frameWidth) != video_frame_width_list_[position]) {
-    video_frame_width_list_[position] = payload->frameWidth;
-    video_frame_height_list_[position] = payload->frameHeight;
+  if (position >= 0 && payload.frameWidth != -1 &&
+      static_cast<uint>(payload.frameWidth) != video_frame_width_list_[position]) {
+    video_frame_width_list_[position] = payload.frameWidth;
+    video_frame_height_list_[position] = payload.frameHeight;
     notifyLayerInfoChangedEvent();
   }
   notifyLayerInfoChangedEventMaybe();
-  delete payload;
 }
 
 void LayerDetectorHandler::addTemporalLayerAndCalculateRate(const std::shared_ptr<DataPacket> &packet,
@@ -127,46 +127,43 @@ void LayerDetectorHandler::addTemporalLayerAndCalculateRate(const std::shared_pt
   if (new_frame) {
     video_frame_rate_list_[temporal_layer]++;
   }
-  packet->compatible_temporal_layers.push_back(temporal_layer);
+  packet->compatible_temporal_layers.add(temporal_layer);
 }
 
 void LayerDetectorHandler::parseLayerInfoFromVP9(std::shared_ptr<DataPacket> packet) {
   RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
   unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
   start_buffer = start_buffer + rtp_header->getHeaderLength();
-  RTPPayloadVP9* payload = vp9_parser_.parseVP9(
+  RTPPayloadVP9 payload = vp9_parser_.parseVP9(
       start_buffer, packet->length - rtp_header->getHeaderLength());
 
-  int spatial_layer = payload->spatialID;
+  int spatial_layer = payload.spatialID;
 
-  packet->compatible_spatial_layers = {};
-  for (int i = 5; i >= spatial_layer; i--) {
-    packet->compatible_spatial_layers.push_back(i);
-  }
+  packet->compatible_spatial_layers.clear();
+  packet->compatible_spatial_layers.addRange(spatial_layer, 5);
 
-  packet->compatible_temporal_layers = {};
-  switch (payload->temporalID) {
-    case 0: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfLayerFrame);
-    case 2: addTemporalLayerAndCalculateRate(packet, 1, payload->beginningOfLayerFrame);
-    case 1: addTemporalLayerAndCalculateRate(packet, 2, payload->beginningOfLayerFrame);
-    case 3: addTemporalLayerAndCalculateRate(packet, 3, payload->beginningOfLayerFrame);
+  packet->compatible_temporal_layers.clear();
+  switch (payload.temporalID) {
+    case 0: addTemporalLayerAndCalculateRate(packet, 0, payload.beginningOfLayerFrame);
+    case 2: addTemporalLayerAndCalculateRate(packet, 1, payload.beginningOfLayerFrame);
+    case 1: addTemporalLayerAndCalculateRate(packet, 2, payload.beginningOfLayerFrame);
+    case 3: addTemporalLayerAndCalculateRate(packet, 3, payload.beginningOfLayerFrame);
       break;
-    default: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfLayerFrame);
+    default: addTemporalLayerAndCalculateRate(packet, 0, payload.beginningOfLayerFrame);
       break;
   }
 
-  if (!payload->frameType) {
+  if (!payload.frameType) {
     packet->is_keyframe = true;
   } else {
     packet->is_keyframe = false;
   }
   bool resolution_changed = false;
-  if (payload->resolutions.size() > 0) {
-    for (uint position = 0; position < payload->resolutions.size(); position++) {
-      resolution_changed = true;
-      video_frame_width_list_[position] = payload->resolutions[position].width;
-      video_frame_height_list_[position] = payload->resolutions[position].height;
-    }
+  for (uint position = 0; position < static_cast<uint>(payload.resolutionsCount) &&
+       position < video_frame_width_list_.size(); position++) {
+    resolution_changed = true;
+    video_frame_width_list_[position] = payload.resolutions[position].width;
+    video_frame_height_list_[position] = payload.resolutions[position].height;
   }
   if (resolution_changed) {
     notifyLayerInfoChangedEvent();
@@ -174,31 +171,29 @@ void LayerDetectorHandler::parseLayerInfoFromVP9(std::shared_ptr<DataPacket> pac
 
   notifyLayerInfoChangedEventMaybe();
 
-  packet->ending_of_layer_frame = payload->endingOfLayerFrame;
-  delete payload;
+  packet->ending_of_layer_frame = payload.endingOfLayerFrame;
 }
 
 void LayerDetectorHandler::parseLayerInfoFromH264(std::shared_ptr<DataPacket> packet) {
   RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
   unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
   start_buffer = start_buffer + rtp_header->getHeaderLength();
-  RTPPayloadH264* payload = h264_parser_.parseH264(
+  RTPPayloadH264 payload = h264_parser_.parseH264(
       start_buffer, packet->length - rtp_header->getHeaderLength());
 
   int position = getSsrcPosition(rtp_header->getSSRC());
   packet->compatible_spatial_layers = {position};
 
-  if (payload->frameType == kH264IFrame) {
+  if (payload.frameType == kH264IFrame) {
     packet->is_keyframe = true;
   } else {
     packet->is_keyframe = false;
   }
 
-  addTemporalLayerAndCalculateRate(packet, 0, payload->start_bit);
+  packet->compatible_temporal_layers.clear();
+  addTemporalLayerAndCalculateRate(packet, 0, payload.start_bit);
 
   notifyLayerInfoChangedEventMaybe();
-
-  delete payload;
 }
 
 void LayerDetectorHandler::notifyUpdate() {
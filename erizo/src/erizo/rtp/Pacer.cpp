@@ -0,0 +1,193 @@
+#include "rtp/Pacer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtp/RtpHeaders.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(Pacer, "rtp.Pacer");
+
+constexpr duration Pacer::kProcessInterval;
+constexpr double Pacer::kPacingFactor;
+constexpr duration Pacer::kMaxBudgetTime;
+constexpr duration Pacer::kMaxQueueDelay;
+constexpr duration Pacer::kPaddingRequestTimeout;
+constexpr uint32_t Pacer::kMinPaddingRequestBytes;
+constexpr uint32_t Pacer::kStartBitrate;
+
+// Padding is requested in chunks, so it can be accumulated for longer than media
+static constexpr duration kMaxPaddingBudgetTime = std::chrono::milliseconds(100);
+
+static int64_t getBytesForTime(uint64_t bitrate, duration time) {
+  return bitrate * std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 8000000;
+}
+
+Pacer::Pacer(SendCallback send, PaddingCallback request_padding, std::shared_ptr<Clock> the_clock)
+  : send_{send}, request_padding_{request_padding}, clock_{the_clock},
+    pacing_bitrate_{static_cast<uint64_t>(kStartBitrate * kPacingFactor)}, padding_bitrate_{0},
+    media_budget_{0}, padding_budget_{0}, last_process_time_{clock_->now()},
+    last_padding_request_time_{clock_->now()}, padding_requested_{false}, dropped_packets_{0} {
+}
+
+Pacer::Priority Pacer::getPriority(const DataPacket &packet) {
+  if (packet.is_padding) {
+    return PADDING;
+  }
+  if (packet.is_retransmission) {
+    return RETRANSMISSION;
+  }
+  return packet.type == AUDIO_PACKET ? AUDIO : VIDEO;
+}
+
+void Pacer::enqueue(std::shared_ptr<DataPacket> packet) {
+  Priority priority = getPriority(*packet);
+  if (priority == PADDING) {
+    padding_requested_ = false;
+  } else if (priority == VIDEO && packet->is_keyframe) {
+    const RtpHeader *head = reinterpret_cast<const RtpHeader*>(packet->data);
+    keyframe_timestamps_[head->getSSRC()] = head->getTimestamp();
+  }
+  queues_[priority].push_back(QueuedPacket{std::move(packet), clock_->now()});
+}
+
+void Pacer::process() {
+  time_point now = clock_->now();
+  updateBudgets(now);
+  sendMedia(now);
+  if (!hasQueuedMedia()) {
+    sendPadding();
+    maybeRequestPadding(now);
+  }
+}
+
+bool Pacer::hasPendingWork() const {
+  return getQueueSize() > 0 || padding_bitrate_ > 0;
+}
+
+void Pacer::setEstimatedBitrate(uint64_t bitrate) {
+  pacing_bitrate_ = bitrate * kPacingFactor;
+}
+
+void Pacer::setPaddingBitrate(uint64_t bitrate) {
+  padding_bitrate_ = bitrate;
+  if (padding_bitrate_ == 0) {
+    padding_budget_ = 0;
+    padding_requested_ = false;
+  }
+}
+
+size_t Pacer::getQueueSize() const {
+  size_t size = 0;
+  for (const auto &queue : queues_) {
+    size += queue.size();
+  }
+  return size;
+}
+
+duration Pacer::getQueueDelay() const {
+  time_point now = clock_->now();
+  duration delay = duration::zero();
+  for (int priority = AUDIO; priority < PADDING; priority++) {
+    if (!queues_[priority].empty()) {
+      delay = std::max(delay, now - queues_[priority].front().enqueued_at);
+    }
+  }
+  return delay;
+}
+
+void Pacer::updateBudgets(time_point now) {
+  duration elapsed = now - last_process_time_;
+  last_process_time_ = now;
+  media_budget_ = std::min(media_budget_ + getBytesForTime(pacing_bitrate_, elapsed),
+                           getBytesForTime(pacing_bitrate_, kMaxBudgetTime));
+  padding_budget_ = std::min(padding_budget_ + getBytesForTime(padding_bitrate_, elapsed),
+                             getBytesForTime(padding_bitrate_, kMaxPaddingBudgetTime));
+}
+
+void Pacer::sendMedia(time_point now) {
+  while (!queues_[AUDIO].empty()) {
+    send(&queues_[AUDIO]);
+  }
+  dropDelayedVideo(now);
+  while (!queues_[RETRANSMISSION].empty() || !queues_[VIDEO].empty()) {
+    if (media_budget_ <= 0 && !isVideoDelayed(now)) {
+      break;
+    }
+    send(queues_[RETRANSMISSION].empty() ? &queues_[VIDEO] : &queues_[RETRANSMISSION]);
+  }
+}
+
+void Pacer::dropDelayedVideo(time_point now) {
+  auto &retransmissions = queues_[RETRANSMISSION];
+  while (!retransmissions.empty() && now - retransmissions.front().enqueued_at >= kMaxQueueDelay) {
+    retransmissions.pop_front();
+    dropped_packets_++;
+  }
+  auto &video = queues_[VIDEO];
+  if (video.empty() || now - video.front().enqueued_at < kMaxQueueDelay) {
+    return;
+  }
+  auto delayed_end = std::find_if(video.begin(), video.end(), [now](const QueuedPacket &queued) {
+    return now - queued.enqueued_at < kMaxQueueDelay;
+  });
+  auto kept_end = std::remove_if(video.begin(), delayed_end, [this](const QueuedPacket &queued) {
+    return !isKeyframePacket(*queued.packet);
+  });
+  size_t dropped = delayed_end - kept_end;
+  video.erase(kept_end, delayed_end);
+  dropped_packets_ += dropped;
+  ELOG_DEBUG("message: Dropped delayed video, packets: %zu, queued: %zu", dropped, video.size());
+}
+
+bool Pacer::isKeyframePacket(const DataPacket &packet) const {
+  if (packet.is_keyframe) {
+    return true;
+  }
+  const RtpHeader *head = reinterpret_cast<const RtpHeader*>(packet.data);
+  auto keyframe_timestamp = keyframe_timestamps_.find(head->getSSRC());
+  return keyframe_timestamp != keyframe_timestamps_.end() && keyframe_timestamp->second == head->getTimestamp();
+}
+
+void Pacer::sendPadding() {
+  auto &queue = queues_[PADDING];
+  while (!queue.empty() && media_budget_ > 0) {
+    padding_budget_ -= queue.front().packet->length;
+    send(&queue);
+  }
+}
+
+void Pacer::maybeRequestPadding(time_point now) {
+  if (padding_bitrate_ == 0 || !queues_[PADDING].empty() || padding_budget_ < kMinPaddingRequestBytes) {
+    return;
+  }
+  if (padding_requested_ && now - last_padding_request_time_ < kPaddingRequestTimeout) {
+    return;
+  }
+  padding_requested_ = true;
+  last_padding_request_time_ = now;
+  request_padding_(padding_budget_);
+}
+
+bool Pacer::hasQueuedMedia() const {
+  return !queues_[AUDIO].empty() || !queues_[RETRANSMISSION].empty() || !queues_[VIDEO].empty();
+}
+
+bool Pacer::isVideoDelayed(time_point now) const {
+  for (int priority = RETRANSMISSION; priority <= VIDEO; priority++) {
+    if (!queues_[priority].empty() && now - queues_[priority].front().enqueued_at >= kMaxQueueDelay) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Pacer::send(std::deque<QueuedPacket> *queue) {
+  std::shared_ptr<DataPacket> packet = std::move(queue->front().packet);
+  queue->pop_front();
+  media_budget_ -= packet->length;
+  send_(std::move(packet));
+}
+
+}  // namespace erizo
@@ -0,0 +1,96 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_PACER_H_
+#define ERIZO_SRC_ERIZO_RTP_PACER_H_
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "./logger.h"
+#include "./MediaDefinitions.h"
+#include "lib/Clock.h"
+
+namespace erizo {
+
+// Leaky bucket for the RTP packets sent by a WebRtcConnection. Packets are queued by priority and released at a
+// multiple of the estimated bitrate, so keyframes and layer switches do not leave as a single burst. The budget
+// that media leaves unused is offered to the streams as padding. Audio is deliberately not paced, it is a small
+// and steady share of the bitrate and holding it back would only add jitter.
+class Pacer {
+  DECLARE_LOGGER();
+
+ public:
+  enum Priority { AUDIO = 0, RETRANSMISSION, VIDEO, PADDING, kNumPriorities };
+
+  using SendCallback = std::function<void(std::shared_ptr<DataPacket>)>;
+  using PaddingCallback = std::function<void(uint32_t)>;
+
+  static constexpr duration kProcessInterval = std::chrono::milliseconds(5);
+  // Media is allowed to leave faster than the estimate, the pacer only smooths bursts out
+  static constexpr double kPacingFactor = 2.5;
+  // Media budget that can be accumulated while idle
+  static constexpr duration kMaxBudgetTime = std::chrono::milliseconds(20);
+  // Video queued for longer than this is dropped so the queue catches up, receivers recover with NACKs or a
+  // keyframe. Keyframe packets are sent instead, regardless of the budget.
+  static constexpr duration kMaxQueueDelay = std::chrono::milliseconds(500);
+  // Padding is requested again if the previous request has not been answered after this time
+  static constexpr duration kPaddingRequestTimeout = std::chrono::milliseconds(50);
+  static constexpr uint32_t kMinPaddingRequestBytes = 200;
+  static constexpr uint32_t kStartBitrate = 300000;
+
+  Pacer(SendCallback send, PaddingCallback request_padding,
+        std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+
+  void enqueue(std::shared_ptr<DataPacket> packet);
+  // Sends the packets allowed by the budget accumulated since the last call
+  void process();
+  // Returns true while process() has to be called periodically
+  bool hasPendingWork() const;
+
+  void setEstimatedBitrate(uint64_t bitrate);
+  void setPaddingBitrate(uint64_t bitrate);
+  uint64_t getPacingBitrate() const { return pacing_bitrate_; }
+
+  size_t getQueueSize() const;
+  duration getQueueDelay() const;
+  uint64_t getDroppedPackets() const { return dropped_packets_; }
+
+  static Priority getPriority(const DataPacket &packet);
+
+ private:
+  struct QueuedPacket {
+    std::shared_ptr<DataPacket> packet;
+    time_point enqueued_at;
+  };
+
+  void updateBudgets(time_point now);
+  void sendMedia(time_point now);
+  void dropDelayedVideo(time_point now);
+  bool isKeyframePacket(const DataPacket &packet) const;
+  void sendPadding();
+  void maybeRequestPadding(time_point now);
+  bool hasQueuedMedia() const;
+  bool isVideoDelayed(time_point now) const;
+  void send(std::deque<QueuedPacket> *queue);
+
+ private:
+  SendCallback send_;
+  PaddingCallback request_padding_;
+  std::shared_ptr<Clock> clock_;
+  std::array<std::deque<QueuedPacket>, kNumPriorities> queues_;
+  uint64_t pacing_bitrate_;
+  uint64_t padding_bitrate_;
+  int64_t media_budget_;
+  int64_t padding_budget_;
+  time_point last_process_time_;
+  time_point last_padding_request_time_;
+  bool padding_requested_;
+  uint64_t dropped_packets_;
+  // Timestamp of the last keyframe of every SSRC, only the first packet of a keyframe is marked
+  std::map<uint32_t, uint32_t> keyframe_timestamps_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_PACER_H_
@@ -1,35 +1,99 @@
 #include "rtp/PacketBufferService.h"
 
+#include <algorithm>
+
+#include "rtp/RtpUtils.h"
+
 namespace erizo {
 DEFINE_LOGGER(PacketBufferService, "rtp.PacketBufferService");
 
-PacketBufferService::PacketBufferService(): audio_{kServicePacketBufferSize},
-  video_{kServicePacketBufferSize} {
+// A NACK for a packet usually arrives one RTT after sending it, give some room for repeated NACKs
+static constexpr int kRttsToRetain = 4;
+
+PacketBufferService::PacketBufferService(std::shared_ptr<Clock> the_clock)
+  : clock_{the_clock}, retention_time_{kMinPacketRetentionTime},
+    video_rtx_ssrc_{0}, video_rtx_sequence_number_{0} {
 }
 
 void PacketBufferService::insertPacket(std::shared_ptr<DataPacket> packet) {
   RtpHeader *head = reinterpret_cast<RtpHeader*> (packet->data);
-  switch (packet->type) {
-    case VIDEO_PACKET:
-      video_[getIndexInBuffer(head->getSeqNumber())] = packet;
-      break;
-    case AUDIO_PACKET:
-      audio_[getIndexInBuffer(head->getSeqNumber())] = packet;
-      break;
-    default:
-      ELOG_INFO("message: Trying to store an unknown packet");
-      break;
+  uint32_t ssrc = head->getSSRC();
+  if (video_rtx_ssrc_ != 0 && ssrc == video_rtx_ssrc_) {
+    return;
+  }
+  if (packet->type != VIDEO_PACKET && packet->type != AUDIO_PACKET) {
+    ELOG_INFO("message: Trying to store an unknown packet");
+    return;
+  }
+  auto buffer_it = buffers_.find(ssrc);
+  if (buffer_it == buffers_.end()) {
+    buffer_it = buffers_.emplace(ssrc, RetransmissionBuffer{clock_, retention_time_}).first;
+  }
+  buffer_it->second.insert(std::move(packet));
+}
+
+std::shared_ptr<DataPacket> PacketBufferService::getPacket(uint32_t ssrc, uint16_t seq_num) {
+  auto buffer_it = buffers_.find(ssrc);
+  if (buffer_it == buffers_.end()) {
+    return nullptr;
+  }
+  return buffer_it->second.get(seq_num);
+}
+
+std::shared_ptr<DataPacket> PacketBufferService::getPacketToRetransmit(uint32_t ssrc, uint16_t seq_num) {
+  std::shared_ptr<DataPacket> packet = getPacket(ssrc, seq_num);
+  if (!packet) {
+    stats_.misses++;
+    return nullptr;
   }
+  uint64_t age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    buffers_.at(ssrc).getAge(seq_num)).count();
+  stats_.hits++;
+  stats_.total_age_ms += age_ms;
+  stats_.max_age_ms = std::max(stats_.max_age_ms, age_ms);
+  return packet;
 }
 
-std::shared_ptr<DataPacket> PacketBufferService::getVideoPacket(uint16_t seq_num) {
-  return video_[getIndexInBuffer(seq_num)];
+void PacketBufferService::setRtt(duration rtt) {
+  retention_time_ = std::min(std::max(rtt * kRttsToRetain, kMinPacketRetentionTime), kMaxPacketRetentionTime);
+  for (auto &buffer : buffers_) {
+    buffer.second.setRetentionTime(retention_time_);
+  }
+}
+
+PacketBufferStats PacketBufferService::getStats() const {
+  PacketBufferStats stats = stats_;
+  for (const auto &buffer : buffers_) {
+    stats.buffered_packets += buffer.second.size();
+  }
+  return stats;
 }
-std::shared_ptr<DataPacket> PacketBufferService::getAudioPacket(uint16_t seq_num) {
-  return audio_[getIndexInBuffer(seq_num)];
+
+void PacketBufferService::setVideoRtx(uint32_t rtx_ssrc, const std::map<uint8_t, uint8_t> &rtx_payload_types,
+                                      uint16_t first_sequence_number) {
+  if (rtx_ssrc != video_rtx_ssrc_) {
+    video_rtx_sequence_number_ = first_sequence_number;
+  }
+  video_rtx_ssrc_ = rtx_ssrc;
+  video_rtx_payload_types_ = rtx_payload_types;
 }
-uint16_t PacketBufferService::getIndexInBuffer(uint16_t seq_num) {
-  return seq_num % kServicePacketBufferSize;
+
+std::shared_ptr<DataPacket> PacketBufferService::makeVideoRtxPacket(std::shared_ptr<DataPacket> packet) {
+  if (!packet || video_rtx_ssrc_ == 0) {
+    return nullptr;
+  }
+  RtpHeader *head = reinterpret_cast<RtpHeader*> (packet->data);
+  auto rtx_payload_type = video_rtx_payload_types_.find(head->getPayloadType());
+  if (rtx_payload_type == video_rtx_payload_types_.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<DataPacket> rtx_packet = RtpUtils::makeRtxPacket(packet, video_rtx_ssrc_,
+                                                                   rtx_payload_type->second,
+                                                                   video_rtx_sequence_number_);
+  if (rtx_packet) {
+    video_rtx_sequence_number_++;
+  }
+  return rtx_packet;
 }
 
 }  // namespace erizo
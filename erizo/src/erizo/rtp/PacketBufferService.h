@@ -1,34 +1,70 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_PACKETBUFFERSERVICE_H_
 #define ERIZO_SRC_ERIZO_RTP_PACKETBUFFERSERVICE_H_
 
+#include <map>
+#include <memory>
+#include <unordered_map>
+
 #include "./logger.h"
 #include "./MediaDefinitions.h"
+#include "lib/Clock.h"
+#include "rtp/RetransmissionBuffer.h"
 #include "rtp/RtpHeaders.h"
 #include "pipeline/Service.h"
 
-static constexpr uint16_t kServicePacketBufferSize = 256;
-
 namespace erizo {
+
+static constexpr duration kMinPacketRetentionTime = std::chrono::milliseconds(500);
+static constexpr duration kMaxPacketRetentionTime = std::chrono::seconds(3);
+
+struct PacketBufferStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t total_age_ms = 0;
+  uint64_t max_age_ms = 0;
+  uint64_t buffered_packets = 0;
+
+  uint64_t getAverageAgeMs() const {
+    return hits == 0 ? 0 : total_age_ms / hits;
+  }
+};
+
 class PacketBufferService: public Service {
  public:
   DECLARE_LOGGER();
 
-  PacketBufferService();
+  explicit PacketBufferService(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
   ~PacketBufferService() {}
 
-  PacketBufferService(const PacketBufferService&& service);
-
   void insertPacket(std::shared_ptr<DataPacket> packet);
 
-  std::shared_ptr<DataPacket> getVideoPacket(uint16_t seq_num);
-  std::shared_ptr<DataPacket> getAudioPacket(uint16_t seq_num);
+  // Does not count towards the retransmission stats
+  std::shared_ptr<DataPacket> getPacket(uint32_t ssrc, uint16_t seq_num);
+  // Returns nullptr and counts a miss if the packet is not buffered anymore
+  std::shared_ptr<DataPacket> getPacketToRetransmit(uint32_t ssrc, uint16_t seq_num);
 
- private:
-  uint16_t getIndexInBuffer(uint16_t seq_num);
+  // Packets are kept for a few RTTs so late NACKs from far away receivers can still be answered
+  void setRtt(duration rtt);
+  duration getRetentionTime() const { return retention_time_; }
+  PacketBufferStats getStats() const;
+
+  // rtx_payload_types maps each video payload type to its RTX payload type
+  void setVideoRtx(uint32_t rtx_ssrc, const std::map<uint8_t, uint8_t> &rtx_payload_types,
+                   uint16_t first_sequence_number);
+  bool hasVideoRtx() { return video_rtx_ssrc_ != 0; }
+  uint32_t getVideoRtxSSRC() { return video_rtx_ssrc_; }
+
+  // Returns the packet encapsulated in the RTX stream, or nullptr if its payload type has no RTX
+  std::shared_ptr<DataPacket> makeVideoRtxPacket(std::shared_ptr<DataPacket> packet);
 
  private:
-  std::vector<std::shared_ptr<DataPacket>> audio_;
-  std::vector<std::shared_ptr<DataPacket>> video_;
+  std::shared_ptr<Clock> clock_;
+  duration retention_time_;
+  std::unordered_map<uint32_t, RetransmissionBuffer> buffers_;
+  PacketBufferStats stats_;
+  uint32_t video_rtx_ssrc_;
+  std::map<uint8_t, uint8_t> video_rtx_payload_types_;
+  uint16_t video_rtx_sequence_number_;
 };
 
 }  // namespace erizo
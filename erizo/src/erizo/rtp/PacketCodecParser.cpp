@@ -22,14 +22,9 @@ void PacketCodecParser::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
   if (!chead->isRtcp() && enabled_) {
     RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
-    RtpMap *codec =
-        stream_->getRemoteSdpInfo()->getCodecByExternalPayloadType(
-            rtp_header->getPayloadType());
-    if (codec) {
-      packet->codec = codec->encoding_name;
-      packet->clock_rate = codec->clock_rate;
-      ELOG_DEBUG("Reading codec: %s, clock: %u", packet->codec.c_str(), packet->clock_rate);
-    }
+    const PayloadTypeInfo &payload_type = payload_types_.get(rtp_header->getPayloadType());
+    packet->codec = payload_type.codec;
+    packet->clock_rate = payload_type.clock_rate;
   }
   ctx->fireRead(std::move(packet));
 }
@@ -48,5 +43,7 @@ void PacketCodecParser::notifyUpdate() {
   if (!stream_) {
     return;
   }
+  // The pipeline is notified whenever the remote SDP changes
+  payload_types_ = PayloadTypeTable{stream_->getRemoteSdpInfo()->getPayloadInfos()};
 }
 }  // namespace erizo
@@ -3,6 +3,7 @@
 
 #include "./logger.h"
 #include "pipeline/Handler.h"
+#include "rtp/PayloadTypeTable.h"
 
 namespace erizo {
 
@@ -27,6 +28,7 @@ class PacketCodecParser: public InboundHandler {
 
  private:
   MediaStream *stream_;
+  PayloadTypeTable payload_types_;
   bool enabled_;
   bool initialized_;
 };
@@ -0,0 +1,37 @@
+#include "rtp/PayloadTypeTable.h"
+
+#include <strings.h>
+
+namespace erizo {
+
+constexpr size_t PayloadTypeTable::kPayloadTypes;
+
+static const char* kCodecNames[] = {
+  "unknown", "VP8", "VP9", "H264", "red", "ulpfec", "rtx", "opus", "PCMU", "PCMA"
+};
+
+PayloadTypeTable::PayloadTypeTable(const std::vector<RtpMap> &rtp_maps) {
+  for (const RtpMap &rtp_map : rtp_maps) {
+    if (rtp_map.payload_type >= kPayloadTypes) {
+      continue;
+    }
+    PayloadTypeInfo &info = table_[rtp_map.payload_type];
+    info.codec = getCodec(rtp_map.encoding_name);
+    info.clock_rate = rtp_map.clock_rate;
+  }
+}
+
+RtpCodec PayloadTypeTable::getCodec(const std::string &encoding_name) {
+  for (size_t codec = 1; codec < sizeof(kCodecNames) / sizeof(kCodecNames[0]); codec++) {
+    if (strcasecmp(encoding_name.c_str(), kCodecNames[codec]) == 0) {
+      return static_cast<RtpCodec>(codec);
+    }
+  }
+  return RtpCodec::UNKNOWN;
+}
+
+const char* PayloadTypeTable::getCodecName(RtpCodec codec) {
+  return kCodecNames[static_cast<size_t>(codec)];
+}
+
+}  // namespace erizo
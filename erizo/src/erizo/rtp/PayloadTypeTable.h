@@ -0,0 +1,40 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_PAYLOADTYPETABLE_H_
+#define ERIZO_SRC_ERIZO_RTP_PAYLOADTYPETABLE_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "./MediaDefinitions.h"
+#include "./SdpInfo.h"
+
+namespace erizo {
+
+// Payload types that are not in the SDP keep the defaults
+struct PayloadTypeInfo {
+  RtpCodec codec = RtpCodec::UNKNOWN;
+  unsigned int clock_rate = 0;
+};
+
+// Codec and clock rate of every RTP payload type, built from the SDP so packets are identified with an array index
+class PayloadTypeTable {
+ public:
+  static constexpr size_t kPayloadTypes = 128;
+
+  PayloadTypeTable() = default;
+  explicit PayloadTypeTable(const std::vector<RtpMap> &rtp_maps);
+
+  const PayloadTypeInfo& get(uint8_t payload_type) const {
+    return table_[payload_type & (kPayloadTypes - 1)];
+  }
+
+  static RtpCodec getCodec(const std::string &encoding_name);
+  static const char* getCodecName(RtpCodec codec);
+
+ private:
+  std::array<PayloadTypeInfo, kPayloadTypes> table_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_PAYLOADTYPETABLE_H_
@@ -37,7 +37,7 @@ void PliPacerHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   if (enabled_ && packet->is_keyframe) {
     time_last_keyframe_ = clock_->now();
     waiting_for_keyframe_ = false;
-    stream_->getWorker()->unschedule(scheduled_pli_);
+    stream_->unschedule(scheduled_pli_);
     scheduled_pli_ = std::make_shared<ScheduledTaskReference>();
   }
   ctx->fireRead(std::move(packet));
@@ -62,7 +62,7 @@ void PliPacerHandler::scheduleNextPLI() {
     return;
   }
   std::weak_ptr<PliPacerHandler> weak_this = shared_from_this();
-  scheduled_pli_ = stream_->getWorker()->scheduleFromNow([weak_this] {
+  scheduled_pli_ = stream_->scheduleFromNow([weak_this] {
     if (auto this_ptr = weak_this.lock()) {
       if (this_ptr->clock_->now() - this_ptr->time_last_keyframe_ >= kKeyframeTimeout) {
         this_ptr->sendFIR();
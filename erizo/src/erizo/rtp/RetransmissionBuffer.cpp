@@ -0,0 +1,103 @@
+#include "rtp/RetransmissionBuffer.h"
+
+#include <utility>
+
+#include "rtp/RtpHeaders.h"
+#include "rtp/RtpUtils.h"
+
+namespace erizo {
+
+RetransmissionBuffer::RetransmissionBuffer(std::shared_ptr<Clock> the_clock, duration retention_time)
+  : clock_{the_clock}, retention_time_{retention_time}, entries_(kRetransmissionBufferMinCapacity), size_{0},
+    has_packets_{false}, oldest_seq_num_{0}, newest_seq_num_{0} {
+}
+
+void RetransmissionBuffer::insert(std::shared_ptr<DataPacket> packet) {
+  time_point now = clock_->now();
+  uint16_t seq_num = reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber();
+  if (!has_packets_) {
+    has_packets_ = true;
+    oldest_seq_num_ = seq_num;
+    newest_seq_num_ = seq_num;
+  } else if (RtpUtils::sequenceNumberLessThan(newest_seq_num_, seq_num)) {
+    newest_seq_num_ = seq_num;
+  }
+
+  // Only overwrite packets that could not be retransmitted anyway
+  while (entries_.size() < kRetransmissionBufferMaxCapacity) {
+    const Entry &entry = entries_[getIndex(seq_num)];
+    if (!entry.packet || entry.seq_num == seq_num || !isRetained(entry, now)) {
+      break;
+    }
+    grow();
+  }
+
+  Entry &entry = entries_[getIndex(seq_num)];
+  if (!entry.packet) {
+    size_++;
+  }
+  entry.packet = std::move(packet);
+  entry.seq_num = seq_num;
+  entry.inserted_at = now;
+
+  expire(now);
+}
+
+RetransmissionBuffer::Entry* RetransmissionBuffer::find(uint16_t seq_num) {
+  Entry &entry = entries_[getIndex(seq_num)];
+  if (!entry.packet || entry.seq_num != seq_num) {
+    return nullptr;
+  }
+  return &entry;
+}
+
+std::shared_ptr<DataPacket> RetransmissionBuffer::get(uint16_t seq_num) {
+  Entry *entry = find(seq_num);
+  return entry ? entry->packet : nullptr;
+}
+
+duration RetransmissionBuffer::getAge(uint16_t seq_num) {
+  Entry *entry = find(seq_num);
+  return entry ? clock_->now() - entry->inserted_at : duration::zero();
+}
+
+void RetransmissionBuffer::setRetentionTime(duration retention_time) {
+  retention_time_ = retention_time;
+}
+
+bool RetransmissionBuffer::isRetained(const Entry &entry, time_point now) const {
+  return now - entry.inserted_at < retention_time_;
+}
+
+void RetransmissionBuffer::clear(Entry *entry) {
+  entry->packet.reset();
+  size_--;
+}
+
+void RetransmissionBuffer::grow() {
+  std::vector<Entry> old_entries(entries_.size() * 2);
+  old_entries.swap(entries_);
+  for (Entry &entry : old_entries) {
+    if (entry.packet) {
+      entries_[getIndex(entry.seq_num)] = std::move(entry);
+    }
+  }
+}
+
+void RetransmissionBuffer::expire(time_point now) {
+  if (static_cast<uint16_t>(newest_seq_num_ - oldest_seq_num_) >= entries_.size()) {
+    oldest_seq_num_ = newest_seq_num_ - entries_.size() + 1;
+  }
+  while (oldest_seq_num_ != newest_seq_num_) {
+    Entry *entry = find(oldest_seq_num_);
+    if (entry && isRetained(*entry, now)) {
+      break;
+    }
+    if (entry) {
+      clear(entry);
+    }
+    oldest_seq_num_++;
+  }
+}
+
+}  // namespace erizo
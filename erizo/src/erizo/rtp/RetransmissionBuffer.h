@@ -0,0 +1,58 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_RETRANSMISSIONBUFFER_H_
+#define ERIZO_SRC_ERIZO_RTP_RETRANSMISSIONBUFFER_H_
+
+#include <memory>
+#include <vector>
+
+#include "./MediaDefinitions.h"
+#include "lib/Clock.h"
+
+namespace erizo {
+
+static constexpr size_t kRetransmissionBufferMinCapacity = 32;
+static constexpr size_t kRetransmissionBufferMaxCapacity = 4096;
+
+// Sent packets of a single SSRC indexed by sequence number. Packets are kept while they are younger than the
+// retention time, so the buffer grows with the packet rate (up to a max capacity) and releases old packets
+// on slow streams.
+class RetransmissionBuffer {
+ public:
+  RetransmissionBuffer(std::shared_ptr<Clock> the_clock, duration retention_time);
+
+  void insert(std::shared_ptr<DataPacket> packet);
+  // Returns nullptr if the packet is not buffered anymore
+  std::shared_ptr<DataPacket> get(uint16_t seq_num);
+  duration getAge(uint16_t seq_num);
+
+  void setRetentionTime(duration retention_time);
+  duration getRetentionTime() const { return retention_time_; }
+  size_t capacity() const { return entries_.size(); }
+  size_t size() const { return size_; }
+
+ private:
+  struct Entry {
+    std::shared_ptr<DataPacket> packet;
+    uint16_t seq_num = 0;
+    time_point inserted_at;
+  };
+
+  Entry* find(uint16_t seq_num);
+  size_t getIndex(uint16_t seq_num) const { return seq_num & (entries_.size() - 1); }
+  bool isRetained(const Entry &entry, time_point now) const;
+  void clear(Entry *entry);
+  void grow();
+  void expire(time_point now);
+
+ private:
+  std::shared_ptr<Clock> clock_;
+  duration retention_time_;
+  std::vector<Entry> entries_;
+  size_t size_;
+  bool has_packets_;
+  uint16_t oldest_seq_num_;
+  uint16_t newest_seq_num_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_RETRANSMISSIONBUFFER_H_
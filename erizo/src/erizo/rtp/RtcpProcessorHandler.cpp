@@ -22,8 +22,11 @@ void RtcpProcessorHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet
       processor_->analyzeSr(chead);
     }
   } else {
-    if (stats_->getNode()["total"].hasChild("bitrateCalculated")) {
-       processor_->setPublisherBW(stats_->getNode()["total"]["bitrateCalculated"].value());
+    if (!publisher_bitrate_) {
+      publisher_bitrate_ = stats_->getNode()["total"].getStat("bitrateCalculated");
+    }
+    if (publisher_bitrate_) {
+       processor_->setPublisherBW(publisher_bitrate_->value());
     }
   }
   processor_->checkRtcpFb();
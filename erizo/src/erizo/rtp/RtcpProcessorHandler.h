@@ -33,6 +33,7 @@ class RtcpProcessorHandler: public Handler {
   MediaStream* stream_;
   std::shared_ptr<RtcpProcessor> processor_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<StatNode> publisher_bitrate_;
 };
 
 }  // namespace erizo
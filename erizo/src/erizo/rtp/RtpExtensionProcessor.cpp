@@ -12,7 +12,7 @@ namespace erizo {
 DEFINE_LOGGER(RtpExtensionProcessor, "rtp.RtpExtensionProcessor");
 
 RtpExtensionProcessor::RtpExtensionProcessor(const std::vector<erizo::ExtMap> ext_mappings) :
-    ext_mappings_{ext_mappings}, video_orientation_{kVideoRotation_0} {
+    ext_mappings_{ext_mappings}, video_orientation_{kVideoRotation_0}, transport_sequence_number_{0} {
   translationMap_["urn:ietf:params:rtp-hdrext:ssrc-audio-level"] = SSRC_AUDIO_LEVEL;
   translationMap_["http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"] = ABS_SEND_TIME;
   translationMap_["urn:ietf:params:rtp-hdrext:toffset"] = TOFFSET;
@@ -111,6 +111,67 @@ uint32_t RtpExtensionProcessor::processRtpExtensions(std::shared_ptr<DataPacket>
   return len;
 }
 
+char* RtpExtensionProcessor::findExtension(std::shared_ptr<DataPacket> p, RTPExtensions extension) {
+  switch (p->type) {
+    case VIDEO_PACKET:
+      return findExtension(p, ext_map_video_, extension);
+    case AUDIO_PACKET:
+      return findExtension(p, ext_map_audio_, extension);
+    default:
+      // Incoming packets are not classified yet, bundled media uses the same ids for both types
+      char *buf = findExtension(p, ext_map_video_, extension);
+      return buf != nullptr ? buf : findExtension(p, ext_map_audio_, extension);
+  }
+}
+
+char* RtpExtensionProcessor::findExtension(std::shared_ptr<DataPacket> p,
+                                           const std::array<RTPExtensions, 10> &ext_map, RTPExtensions extension) {
+  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(p->data);
+  if (!head->getExtension() || head->getExtId() != 0xBEDE) {
+    return nullptr;
+  }
+  uint16_t total_ext_length = head->getExtLength() * 4;
+  char* ext_buffer = (char*)&head->extensions;  // NOLINT
+  char* packet_end = p->data + p->length;
+  uint16_t current_place = 1;
+  while (current_place < total_ext_length && ext_buffer < packet_end) {
+    uint8_t ext_byte = static_cast<uint8_t>(*ext_buffer);
+    uint8_t ext_id = ext_byte >> 4;
+    uint8_t ext_length = ext_byte & 0x0F;
+    if (ext_id == 0) {
+      // Padding byte
+      ext_buffer++;
+      current_place++;
+      continue;
+    }
+    if (ext_id < ext_map.size() && ext_map[ext_id] == extension) {
+      return ext_buffer + ext_length + 2 <= packet_end ? ext_buffer : nullptr;
+    }
+    ext_buffer = ext_buffer + ext_length + 2;
+    current_place = current_place + ext_length + 2;
+  }
+  return nullptr;
+}
+
+bool RtpExtensionProcessor::stampTransportSequenceNumber(std::shared_ptr<DataPacket> p, uint16_t *sequence_number) {
+  TransportCCExtension *extension = reinterpret_cast<TransportCCExtension*>(findExtension(p, TRANSPORT_CC));
+  if (extension == nullptr || extension->getLength() != 1) {
+    return false;
+  }
+  *sequence_number = transport_sequence_number_++;
+  extension->setSeqNumber(*sequence_number);
+  return true;
+}
+
+bool RtpExtensionProcessor::getTransportSequenceNumber(std::shared_ptr<DataPacket> p, uint16_t *sequence_number) {
+  TransportCCExtension *extension = reinterpret_cast<TransportCCExtension*>(findExtension(p, TRANSPORT_CC));
+  if (extension == nullptr || extension->getLength() != 1) {
+    return false;
+  }
+  *sequence_number = extension->getSeqNumber();
+  return true;
+}
+
 VideoRotation RtpExtensionProcessor::getVideoRotation() {
   return video_orientation_;
 }
@@ -34,6 +34,10 @@ class RtpExtensionProcessor{
   uint32_t processRtpExtensions(std::shared_ptr<DataPacket> p);
   VideoRotation getVideoRotation();
 
+  // Writes the next transport-wide sequence number if the packet carries the transport-cc extension
+  bool stampTransportSequenceNumber(std::shared_ptr<DataPacket> p, uint16_t *sequence_number);
+  bool getTransportSequenceNumber(std::shared_ptr<DataPacket> p, uint16_t *sequence_number);
+
   std::array<RTPExtensions, 10> getVideoExtensionMap() {
     return ext_map_video_;
   }
@@ -50,6 +54,10 @@ class RtpExtensionProcessor{
   std::array<RTPExtensions, 10> ext_map_video_, ext_map_audio_;
   std::map<std::string, uint8_t> translationMap_;
   VideoRotation video_orientation_;
+  uint16_t transport_sequence_number_;
+  char* findExtension(std::shared_ptr<DataPacket> p, RTPExtensions extension);
+  char* findExtension(std::shared_ptr<DataPacket> p, const std::array<RTPExtensions, 10> &ext_map,
+                      RTPExtensions extension);
   uint32_t processAbsSendTime(char* buf);
   uint32_t processVideoOrientation(char* buf);
   uint32_t stripExtension(char* buf, int len);
@@ -31,14 +31,15 @@ RtpH264Parser::~RtpH264Parser() {
 // |F|NRI|  Type   |
 // +---------------+
 
-RTPPayloadH264* RtpH264Parser::parseH264(unsigned char* buf, int len) {
-  RTPPayloadH264* h264 = new RTPPayloadH264;
+RTPPayloadH264 RtpH264Parser::parseH264(const unsigned char* buf, int len) {
+  RTPPayloadH264 payload;
+  RTPPayloadH264* h264 = &payload;
   uint8_t nal;
   uint8_t type;
 
-  if (!len) {
+  if (len <= 0) {
     ELOG_ERROR("Empty H.264 RTP packet");
-    return h264;
+    return payload;
   }
 
   nal  = buf[0];
@@ -81,10 +82,10 @@ RTPPayloadH264* RtpH264Parser::parseH264(unsigned char* buf, int len) {
       break;
   }
 
-  return h264;
+  return payload;
 }
 
-int RtpH264Parser::parse_packet_fu_a(RTPPayloadH264* h264, unsigned char* buf, int len) const {
+int RtpH264Parser::parse_packet_fu_a(RTPPayloadH264* h264, const unsigned char* buf, int len) const {
   uint8_t fu_indicator, fu_header, start_bit, nal_type, nal, end_bit;
 
   if (len < 3) {
@@ -117,16 +118,37 @@ int RtpH264Parser::parse_packet_fu_a(RTPPayloadH264* h264, unsigned char* buf, i
   return 0;
 }
 
-int RtpH264Parser::parse_aggregated_packet(RTPPayloadH264* h264, unsigned char* buf, int len) const {
+int RtpH264Parser::parse_aggregated_packet(RTPPayloadH264* h264, const unsigned char* buf, int len) const {
   h264->nal_type = aggregated;
+  h264->data = buf;
+  h264->dataLength = len;
+
+  while (len > 2) {
+    uint16_t nal_size = AV_RB16(buf);
+    buf += 2;
+    len -= 2;
+    if (nal_size > len) {
+      ELOG_ERROR("NAL size exceeds length: %d %d\n", nal_size, len);
+      return -1;
+    }
+    if (nal_size > 0 && (buf[0] & 0x1f) == 5) {
+      h264->frameType = kH264IFrame;
+    }
+    buf += nal_size;
+    len -= nal_size;
+  }
+  return 0;
+}
+
+int RtpH264Parser::unpackAggregatedPacket(RTPPayloadH264* h264) const {
   unsigned char* dst = nullptr;
   int pass     = 0;
   int total_length = 0;
 
   // first we are going to figure out the total size
   for (pass = 0; pass < 2; pass++) {
-    const uint8_t *src = buf;
-    int src_len    = len;
+    const uint8_t *src = h264->data;
+    int src_len    = h264->dataLength;
 
     while (src_len > 2) {
       uint16_t nal_size = AV_RB16(src);
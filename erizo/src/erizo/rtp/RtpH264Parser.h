@@ -21,7 +21,7 @@ struct RTPPayloadH264 {
   static constexpr unsigned char start_sequence[] = { 0, 0, 0, 1 };
   H264FrameTypes frameType = kH264PFrame;
   NALTypes nal_type = single;
-  const unsigned char* data;
+  const unsigned char* data = nullptr;
   unsigned int dataLength = 0;
   unsigned char fragment_nal_header;
   int fragment_nal_header_len = 0;
@@ -36,10 +36,13 @@ class RtpH264Parser {
  public:
   RtpH264Parser();
   virtual ~RtpH264Parser();
-  erizo::RTPPayloadH264* parseH264(unsigned char* data, int datalength);
+  // Does not allocate, aggregated NALs stay in data until unpackAggregatedPacket() is called
+  erizo::RTPPayloadH264 parseH264(const unsigned char* data, int datalength);
+  // Copies the NALs of an aggregated packet, with start sequences, to unpacked_data
+  int unpackAggregatedPacket(RTPPayloadH264* h264) const;
  private:
-  int parse_packet_fu_a(RTPPayloadH264* h264, unsigned char* buf, int len) const;
-  int parse_aggregated_packet(RTPPayloadH264* h264, unsigned char* buf, int len) const;
+  int parse_packet_fu_a(RTPPayloadH264* h264, const unsigned char* buf, int len) const;
+  int parse_aggregated_packet(RTPPayloadH264* h264, const unsigned char* buf, int len) const;
 };
 }  // namespace erizo
 #endif  // ERIZO_SRC_ERIZO_RTP_RTPH264PARSER_H_
@@ -21,6 +21,7 @@ namespace erizo {
 #define RTCP_PLI_FMT           1
 #define RTCP_SLI_FMT           2
 #define RTCP_FIR_FMT           4
+#define RTCP_TRANSPORT_CC_FMT 15
 #define RTCP_AFB              15
 
 #define VP8_90000_PT        100  // VP8 Video Codec
@@ -233,6 +234,26 @@ class AbsSendTimeExtension {
   }
 };
 
+class TransportCCExtension {
+ public:
+  uint8_t ext_info;
+  uint8_t seq_high;
+  uint8_t seq_low;
+  inline uint8_t getId() {
+    return ext_info >> 4;
+  }
+  inline uint8_t getLength() {
+    return (ext_info & 0x0F);
+  }
+  inline uint16_t getSeqNumber() {
+    return (seq_high << 8) | seq_low;
+  }
+  inline void setSeqNumber(uint16_t seq_number) {
+    seq_high = seq_number >> 8;
+    seq_low = seq_number & 0xFF;
+  }
+};
+
 class RtpRtxHeader {
  public:
   RtpHeader rtpHeader;
@@ -414,6 +435,9 @@ class RtcpHeader {
   inline bool isREMB() {
     return packettype == RTCP_PS_Feedback_PT && blockcount == RTCP_AFB;
   }
+  inline bool isTransportFeedback() {
+    return packettype == RTCP_RTP_Feedback_PT && blockcount == RTCP_TRANSPORT_CC_FMT;
+  }
   inline bool isRtcp(void) {
     return (packettype >= RTCP_MIN_PT && packettype <= RTCP_MAX_PT);
   }
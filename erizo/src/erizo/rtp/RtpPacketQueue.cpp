@@ -11,7 +11,11 @@ namespace erizo {
 
 DEFINE_LOGGER(RtpPacketQueue, "rtp.RtpPacketQueue");
 
+constexpr size_t RtpPacketQueue::kInitialCapacity;
+constexpr size_t RtpPacketQueue::kMaxCapacity;
+
 RtpPacketQueue::RtpPacketQueue(double depthInSeconds, double maxDepthInSeconds) :
+  slots_(kInitialCapacity), oldestSequenceNumber_(0), span_(0), size_(0),
   lastSequenceNumberGiven_(-1), timebase_(0), depthInSeconds_(depthInSeconds), maxDepthInSeconds_(maxDepthInSeconds) {
   if (depthInSeconds_ >= maxDepthInSeconds_) {
       ELOG_WARN("invalid configuration, depth_: %f, max_: %f; reset to defaults",
@@ -22,19 +26,25 @@ RtpPacketQueue::RtpPacketQueue(double depthInSeconds, double maxDepthInSeconds)
 }
 
 RtpPacketQueue::~RtpPacketQueue(void) {
-  queue_.clear();
+  slots_.clear();
 }
 
 void RtpPacketQueue::pushPacket(const char *data, int length) {
   const RtpHeader *currentHeader = reinterpret_cast<const RtpHeader*>(data);
   uint16_t currentSequenceNumber = currentHeader->getSeqNumber();
 
+  std::shared_ptr<DataPacket> packet = std::make_shared<DataPacket>();
+  memcpy(packet->data, data, length);
+  packet->length = length;
+
+  boost::mutex::scoped_lock lock(queueMutex_);
   if (lastSequenceNumberGiven_ >= 0 &&
         (rtpSequenceLessThan(currentSequenceNumber, (uint16_t)lastSequenceNumberGiven_) ||
         currentSequenceNumber == lastSequenceNumberGiven_)) {
     // this sequence number is less than the stuff we've already handed out,
     // which means it's too late to be of any value.
-    ELOG_WARN("SSRC:%u, Payload: %u, discarding very late sample %d that is <= %d",
+    stats_.late++;
+    ELOG_DEBUG("SSRC:%u, Payload: %u, discarding very late sample %d that is <= %d",
               currentHeader->getSSRC(),
               currentHeader->getPayloadType(),
               currentSequenceNumber,
@@ -42,54 +52,84 @@ void RtpPacketQueue::pushPacket(const char *data, int length) {
     return;
   }
 
-  // TODO(pedro) this should be a secret of the DataPacket class.  It should maintain its own memory
-  // and copy stuff as necessary.
-  boost::shared_ptr<DataPacket> packet(new DataPacket());
-  memcpy(packet->data, data, length);
-  packet->length = length;
-
-  // let's insert this packet where it belongs in the queue.
-  boost::mutex::scoped_lock lock(queueMutex_);
-  std::list<boost::shared_ptr<DataPacket> >::iterator it;
-  for (it=queue_.begin(); it != queue_.end(); ++it) {
-    const RtpHeader *header = reinterpret_cast<const RtpHeader*>((*it)->data);
-    uint16_t sequenceNumber = header->getSeqNumber();
-
-    if (sequenceNumber == currentSequenceNumber) {
+  if (size_ == 0) {
+    oldestSequenceNumber_ = currentSequenceNumber;
+    span_ = 1;
+  } else {
+    int offset = static_cast<int16_t>(currentSequenceNumber - oldestSequenceNumber_);
+    if (offset < 0) {
+      // Older than anything queued, it becomes the oldest one.
+      size_t span = span_ - offset;
+      if (span > kMaxCapacity) {
+        stats_.late++;
+        ELOG_DEBUG("discarding sample %d, too far from the queued ones", currentSequenceNumber);
+        return;
+      }
+      growTo(span);
+      oldestSequenceNumber_ = currentSequenceNumber;
+      span_ = span;
+    } else if (static_cast<size_t>(offset) >= span_) {
+      // Newer than anything queued, offset < 0x8000 so it always fits.
+      growTo(offset + 1);
+      span_ = offset + 1;
+    } else if (slot(currentSequenceNumber)) {
       // We already have this sequence number in the queue.
-      ELOG_INFO("discarding duplicate sample %d", currentSequenceNumber);
-      break;
+      stats_.duplicate++;
+      ELOG_DEBUG("discarding duplicate sample %d", currentSequenceNumber);
+      return;
     }
+  }
+  slot(currentSequenceNumber) = std::move(packet);
+  size_++;
 
-    if (this->rtpSequenceLessThan(sequenceNumber, currentSequenceNumber)) {
-      queue_.insert(it, packet);
-      break;
-    }
+  // Enforce our max queue size.
+  while (getDepthInSeconds() > maxDepthInSeconds_) {
+    stats_.overflow++;
+    ELOG_DEBUG("RtpPacketQueue - Discarding a sample due to excessive queue depth");
+    popOldest();  // remove oldest samples.
   }
+}
 
-  if (it == queue_.end()) {
-    // something old, or queue is empty.
-    queue_.push_back(packet);
+void RtpPacketQueue::growTo(size_t span) {
+  if (span <= slots_.size()) {
+    return;
+  }
+  size_t capacity = slots_.size();
+  while (capacity < span) {
+    capacity *= 2;
+  }
+  std::vector<std::shared_ptr<DataPacket>> slots(capacity);
+  for (size_t i = 0; i < span_; i++) {
+    uint16_t sequence_number = static_cast<uint16_t>(oldestSequenceNumber_ + i);
+    slots[sequence_number & (capacity - 1)] = std::move(slot(sequence_number));
   }
+  slots_.swap(slots);
+}
 
-  // Enforce our max queue size.
-  while (getDepthInSeconds() > maxDepthInSeconds_) {
-    ELOG_WARN("RtpPacketQueue - Discarding a sample due to excessive queue depth");
-    queue_.pop_back();  // remove oldest samples.
+std::shared_ptr<DataPacket> RtpPacketQueue::popOldest() {
+  std::shared_ptr<DataPacket> packet = std::move(slot(oldestSequenceNumber_));
+  size_--;
+  if (size_ == 0) {
+    span_ = 0;
+    return packet;
   }
+  // Skip the sequence numbers we never received, the newest slot is always taken.
+  do {
+    oldestSequenceNumber_++;
+    span_--;
+  } while (!slot(oldestSequenceNumber_));
+  return packet;
 }
 
 // pops a packet off the queue, respecting the specified queue depth.
-boost::shared_ptr<DataPacket> RtpPacketQueue::popPacket(bool ignore_depth) {
-  boost::shared_ptr<DataPacket> packet;
+std::shared_ptr<DataPacket> RtpPacketQueue::popPacket(bool ignore_depth) {
+  std::shared_ptr<DataPacket> packet;
 
   boost::mutex::scoped_lock lock(queueMutex_);
-  if (queue_.size() > 0) {
+  if (size_ > 0) {
     if (ignore_depth || getDepthInSeconds() > depthInSeconds_) {
-      packet = queue_.back();
-      queue_.pop_back();
-      const RtpHeader *header = reinterpret_cast<const RtpHeader*>(packet->data);
-      lastSequenceNumberGiven_ = static_cast<int>(header->getSeqNumber());
+      lastSequenceNumberGiven_ = static_cast<int>(oldestSequenceNumber_);
+      packet = popOldest();
     }
   }
 
@@ -103,22 +143,32 @@ void RtpPacketQueue::setTimebase(unsigned int timebase) {
 
 int RtpPacketQueue::getSize() {
   boost::mutex::scoped_lock lock(queueMutex_);
-  return queue_.size();
+  return size_;
+}
+
+RtpPacketQueueStats RtpPacketQueue::getStats() {
+  boost::mutex::scoped_lock lock(queueMutex_);
+  return stats_;
 }
 
 double RtpPacketQueue::getDepthInSeconds() {
   // must be called while queueMutex_ is taken.  Private method.  Also, if no timebase has been set, this always
   // returns zero because we have no way of interpreting how much data is in the queue.
   double depth = 0.0;
-  if (timebase_ > 0 && queue_.size() > 1) {
-    const RtpHeader *oldest = reinterpret_cast<const RtpHeader*>(queue_.back()->data);
-    const RtpHeader *newest = reinterpret_cast<const RtpHeader*>(queue_.front()->data);
+  if (timebase_ > 0 && size_ > 1) {
+    const RtpHeader *oldest = reinterpret_cast<const RtpHeader*>(slot(oldestSequenceNumber_)->data);
+    const RtpHeader *newest = reinterpret_cast<const RtpHeader*>(slot(newestSequenceNumber())->data);
     depth = (static_cast<double>(newest->getTimestamp() - oldest->getTimestamp())) / static_cast<double>(timebase_);
   }
 
   return depth;
 }
 
+double RtpPacketQueue::getDepth() {
+  boost::mutex::scoped_lock lock(queueMutex_);
+  return getDepthInSeconds();
+}
+
 bool RtpPacketQueue::hasData() {
   boost::mutex::scoped_lock lock(queueMutex_);
   double currentDepth = getDepthInSeconds();
@@ -1,10 +1,10 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_RTPPACKETQUEUE_H_
 #define ERIZO_SRC_ERIZO_RTP_RTPPACKETQUEUE_H_
 
-#include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 
-#include <list>
+#include <memory>
+#include <vector>
 
 #include "./logger.h"
 
@@ -15,19 +15,26 @@ struct DataPacket;
 static const double DEFAULT_DEPTH = 3.0;
 static const double DEFAULT_MAX = 5.0;
 
+struct RtpPacketQueueStats {
+  uint64_t late = 0;  // sequence number already handed out through popPacket
+  uint64_t duplicate = 0;
+  uint64_t overflow = 0;  // discarded to respect the max depth
+};
+
 // This class implements a packet reordering queue. Here's what it does:
 //
-// 1. Receives incoming packets and pushes them into a queue based on sequence number
+// 1. Receives incoming packets and stores them in a circular buffer indexed by sequence number, so inserting,
+//    detecting duplicates and popping don't depend on how many packets are queued
 // 2. Rejects duplicate packets--duplicate sequence numbers are dropped on the floor
 // 3. Handles sequence number wrap (e.g. packet "1" is technically greater than "65535" because that
 //    is a sequence number wrap
 // 4. Handles out of order packets
 // 5. Handles late packets.  Packets with sequence number greater than the last sequence number
-//    handed out through popPacket are discarded.  There's a log message to help identify
-//    a sane value for their queue depth.
+//    handed out through popPacket are discarded.  Late, duplicate and overflowed packets are counted
+//    in getStats() to help identify a sane value for their queue depth.
 // 6. Is threadsafe.  All public methods lock to ensure the container isn't fouled by multithreaded
-//    access.  This also prevents a minimal amount of locking in calling classes, which prevents
-//    blocking of worker threads.
+//    access.  Packets are copied before locking and the locked sections take constant time, so
+//    the worker thread pushing packets barely blocks.
 // 7. Manages queue depth.  It won't return data until depth (which is % of seconds) is attained, and
 //    will prevent the queue from growing over max seconds.
 //
@@ -45,18 +52,39 @@ class RtpPacketQueue {
   ~RtpPacketQueue(void);
   void setTimebase(unsigned int timebase);
   void pushPacket(const char *data, int length);
-  boost::shared_ptr<DataPacket> popPacket(bool ignore_depth = false);
+  std::shared_ptr<DataPacket> popPacket(bool ignore_depth = false);
   int getSize();  // total size of all items in the queue
   bool hasData();  // whether or not current queue depth is >= depth_
+  double getDepth();  // seconds of media in the queue
+  RtpPacketQueueStats getStats();
+
+  static constexpr size_t kInitialCapacity = 1024;
+  // Half of the sequence number space, the largest span where the order of two packets is unambiguous
+  static constexpr size_t kMaxCapacity = 0x8000;
 
  private:
   // Only used internally; does the math to calculate our current depth based on the supplied timebase.
   // Must be called with queueMutex_ locked.
   double getDepthInSeconds();
 
+  // The following ones must be called with queueMutex_ locked too.
+  std::shared_ptr<DataPacket>& slot(uint16_t sequence_number) {
+    return slots_[sequence_number & (slots_.size() - 1)];
+  }
+  uint16_t newestSequenceNumber() const {
+    return static_cast<uint16_t>(oldestSequenceNumber_ + span_ - 1);
+  }
+  void growTo(size_t span);
+  std::shared_ptr<DataPacket> popOldest();
+
   boost::mutex queueMutex_;
-  std::list<boost::shared_ptr<DataPacket> > queue_;
+  // Power of two sized, packets from oldestSequenceNumber_ to newestSequenceNumber() with holes for the missing ones
+  std::vector<std::shared_ptr<DataPacket>> slots_;
+  uint16_t oldestSequenceNumber_;
+  size_t span_;
+  int size_;
   int lastSequenceNumberGiven_;
+  RtpPacketQueueStats stats_;
   bool rtpSequenceLessThan(uint16_t x, uint16_t y);
 
   // We use a timebase so we can understand how many seconds of data we have in our queue.
@@ -14,22 +14,15 @@ DEFINE_LOGGER(RtpPaddingGeneratorHandler, "rtp.RtpPaddingGeneratorHandler");
 
 constexpr duration kStatsPeriod = std::chrono::milliseconds(100);
 constexpr uint8_t kMaxPaddingSize = 255;
-constexpr uint64_t kMinMarkerRate = 3;
 constexpr uint64_t kInitialBitrate = 300000;
-constexpr uint8_t kMaxBurstPackets = 200;
-constexpr uint8_t kSlideShowBurstPackets = 20;
+constexpr uint16_t kMaxRtxProbePackets = 10;
 
 RtpPaddingGeneratorHandler::RtpPaddingGeneratorHandler(std::shared_ptr<erizo::Clock> the_clock) :
   clock_{the_clock}, stream_{nullptr}, max_video_bw_{0}, higher_sequence_number_{0},
-  video_sink_ssrc_{0}, audio_source_ssrc_{0},
-  number_of_full_padding_packets_{0}, last_padding_packet_size_{0},
+  video_sink_ssrc_{0}, audio_source_ssrc_{0}, target_padding_bitrate_{0},
   last_rate_calculation_time_{clock_->now()}, started_at_{clock_->now()},
   enabled_{false}, first_packet_received_{false},
-  slideshow_mode_active_ {false},
-  marker_rate_{std::chrono::milliseconds(100), 20, 1., clock_},
-  rtp_header_length_{12},
-  bucket_{kInitialBitrate, kSlideShowBurstPackets * kMaxPaddingSize, clock_},
-  scheduled_task_{std::make_shared<ScheduledTaskReference>()} {
+  rtp_header_length_{12} {
   }
 
 
@@ -47,7 +40,8 @@ void RtpPaddingGeneratorHandler::notifyUpdate() {
     video_sink_ssrc_ = stream_->getVideoSinkSSRC();
     audio_source_ssrc_ = stream_->getAudioSinkSSRC();
     stats_ = pipeline->getService<Stats>();
-    stats_->getNode()["total"].insertStat("paddingBitrate",
+    packet_buffer_ = pipeline->getService<PacketBufferService>();
+    padding_bitrate_ = stats_->getNode()["total"].insertStat("paddingBitrate",
         MovingIntervalRateStat{std::chrono::milliseconds(100), 30, 8., clock_});
   }
 
@@ -63,8 +57,13 @@ void RtpPaddingGeneratorHandler::notifyUpdate() {
   if (processor) {
     max_video_bw_ = processor->getMaxVideoBW();
   }
+}
 
-  slideshow_mode_active_ = stream_->isSlideShowModeEnabled();
+void RtpPaddingGeneratorHandler::notifyEvent(MediaEventPtr event) {
+  if (event->getType() == "PaddingRequestEvent") {
+    auto padding_request = std::static_pointer_cast<PaddingRequestEvent>(event);
+    onPaddingRequest(padding_request->bytes);
+  }
 }
 
 void RtpPaddingGeneratorHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
@@ -75,7 +74,6 @@ void RtpPaddingGeneratorHandler::write(Context *ctx, std::shared_ptr<DataPacket>
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
   bool is_higher_sequence_number = false;
   if (packet->type == VIDEO_PACKET && !chead->isRtcp()) {
-    stream_->getWorker()->unschedule(scheduled_task_);
     is_higher_sequence_number = isHigherSequenceNumber(packet);
     if (!first_packet_received_) {
       started_at_ = clock_->now();
@@ -90,41 +88,73 @@ void RtpPaddingGeneratorHandler::write(Context *ctx, std::shared_ptr<DataPacket>
   }
 }
 
-void RtpPaddingGeneratorHandler::sendPaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size) {
-  if (padding_size == 0) {
+void RtpPaddingGeneratorHandler::onPaddingRequest(uint32_t bytes) {
+  if (!enabled_ || !last_video_packet_) {
+    return;
+  }
+
+  recalculatePaddingRate();
+  if (target_padding_bitrate_ == 0) {
     return;
   }
 
-  if (!bucket_.consume(padding_size)) {
+  if (sendsRtxProbes()) {
+    sendRtxProbes(bytes);
+  } else {
+    sendPaddingPackets(bytes);
+  }
+}
+
+void RtpPaddingGeneratorHandler::sendPaddingPackets(uint32_t bytes) {
+  while (bytes > rtp_header_length_) {
+    uint8_t padding_size = std::min(bytes - rtp_header_length_, static_cast<uint32_t>(kMaxPaddingSize));
+    sendPaddingPacket(padding_size);
+    bytes -= std::min(bytes, padding_size + rtp_header_length_);
+  }
+}
+
+void RtpPaddingGeneratorHandler::sendPaddingPacket(uint8_t padding_size) {
+  if (padding_size == 0) {
     return;
   }
 
   SequenceNumber sequence_number = translator_.generate();
 
-  auto padding_packet = RtpUtils::makePaddingPacket(packet, padding_size);
+  auto padding_packet = RtpUtils::makePaddingPacket(last_video_packet_, padding_size);
 
   RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(padding_packet->data);
 
   rtp_header->setSeqNumber(sequence_number.output);
-  stats_->getNode()["total"]["paddingBitrate"] += padding_packet->length;
-  getContext()->fireWrite(std::move(padding_packet));
+  writePaddingPacket(std::move(padding_packet));
 }
 
-void RtpPaddingGeneratorHandler::onPacketWithMarkerSet(std::shared_ptr<DataPacket> packet) {
-  marker_rate_++;
-
-  for (uint i = 0; i < number_of_full_padding_packets_; i++) {
-    sendPaddingPacket(packet, kMaxPaddingSize);
-  }
+bool RtpPaddingGeneratorHandler::sendsRtxProbes() {
+  return packet_buffer_ && packet_buffer_->hasVideoRtx();
+}
 
-  sendPaddingPacket(packet, last_padding_packet_size_);
+void RtpPaddingGeneratorHandler::sendRtxProbes(uint32_t bytes) {
+  // Resend the latest packets over RTX instead of padding, so probing bytes are useful for the receiver
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(last_video_packet_->data);
+  uint16_t sequence_number = rtp_header->getSeqNumber();
 
-  std::weak_ptr<RtpPaddingGeneratorHandler> weak_this = shared_from_this();
-  scheduled_task_ = stream_->getWorker()->scheduleFromNow([packet, weak_this] {
-    if (auto this_ptr = weak_this.lock()) {
-      this_ptr->onPacketWithMarkerSet(packet);
+  for (uint16_t i = 0; i < kMaxRtxProbePackets && bytes > 0; i++) {
+    std::shared_ptr<DataPacket> buffered = packet_buffer_->getPacket(rtp_header->getSSRC(), sequence_number - i);
+    if (!buffered) {
+      return;
+    }
+    std::shared_ptr<DataPacket> probe = packet_buffer_->makeVideoRtxPacket(buffered);
+    if (!probe) {
+      return;
     }
-  }, std::chrono::milliseconds(1000 / kMinMarkerRate));
+    bytes -= std::min(bytes, static_cast<uint32_t>(probe->length));
+    writePaddingPacket(std::move(probe));
+  }
+}
+
+void RtpPaddingGeneratorHandler::writePaddingPacket(std::shared_ptr<DataPacket> packet) {
+  packet->is_padding = true;
+  *padding_bitrate_ += packet->length;
+  getContext()->fireWrite(std::move(packet));
 }
 
 bool RtpPaddingGeneratorHandler::isHigherSequenceNumber(std::shared_ptr<DataPacket> packet) {
@@ -141,16 +171,14 @@ bool RtpPaddingGeneratorHandler::isHigherSequenceNumber(std::shared_ptr<DataPack
 }
 
 void RtpPaddingGeneratorHandler::onVideoPacket(std::shared_ptr<DataPacket> packet) {
+  // Padding packets copy the header of the latest video packet
+  last_video_packet_ = std::move(packet);
+
   if (!enabled_) {
     return;
   }
 
   recalculatePaddingRate();
-
-  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
-  if (rtp_header->getMarker()) {
-    onPacketWithMarkerSet(std::move(packet));
-  }
 }
 
 uint64_t RtpPaddingGeneratorHandler::getStat(std::string stat_name) {
@@ -173,31 +201,22 @@ void RtpPaddingGeneratorHandler::recalculatePaddingRate() {
   last_rate_calculation_time_ = clock_->now();
 
   int64_t total_bitrate = getStat("bitrateCalculated");
-  int64_t padding_bitrate = stats_->getNode()["total"]["paddingBitrate"].value();
+  // RTX probes are sent with their own SSRC so they are not part of the video sink bitrate
+  int64_t padding_bitrate = sendsRtxProbes() ? 0 : padding_bitrate_->value();
   int64_t media_bitrate = std::max(total_bitrate - padding_bitrate, int64_t(0));
 
-  uint64_t target_bitrate = getTargetBitrate();
+  int64_t target_bitrate = getTargetBitrate();
 
-  int64_t target_padding_bitrate = target_bitrate - media_bitrate;
-  // TODO(pedro): figure out a burst size that makes sense here
-  bucket_.reset(std::max(target_padding_bitrate, int64_t(0)), getBurstSize());
+  setTargetPaddingBitrate(std::max(target_bitrate - media_bitrate, int64_t(0)));
+}
 
-  if (target_padding_bitrate <= 0) {
-    number_of_full_padding_packets_ = 0;
-    last_padding_packet_size_ = 0;
+void RtpPaddingGeneratorHandler::setTargetPaddingBitrate(uint64_t target_padding_bitrate) {
+  if (target_padding_bitrate == target_padding_bitrate_) {
     return;
   }
-
-  uint64_t marker_rate = marker_rate_.value(std::chrono::milliseconds(500));
-  marker_rate = std::max(marker_rate, kMinMarkerRate);
-  // TODO(javier): There are arithmetic exceptions in the line following this if clause, so I'm
-  // trying to figure out the cause. I'll remove this check if it happens in production and fix it.
-  if (marker_rate > std::numeric_limits<uint64_t>::max() / 8) {
-    ELOG_WARN("message: Marker Rate too high %" PRIu64, marker_rate);
-  }
-  uint64_t bytes_per_marker = target_padding_bitrate / (marker_rate * 8);
-  number_of_full_padding_packets_ = bytes_per_marker / (kMaxPaddingSize + rtp_header_length_);
-  last_padding_packet_size_ = bytes_per_marker % (kMaxPaddingSize + rtp_header_length_) - rtp_header_length_;
+  target_padding_bitrate_ = target_padding_bitrate;
+  // The Pacer requests padding from the stream while it has budget left for it
+  stream_->setTargetPaddingBitrate(target_padding_bitrate_);
 }
 
 uint64_t RtpPaddingGeneratorHandler::getTargetBitrate() {
@@ -213,23 +232,14 @@ uint64_t RtpPaddingGeneratorHandler::getTargetBitrate() {
   return target_bitrate;
 }
 
-uint64_t RtpPaddingGeneratorHandler::getBurstSize() {
-  uint64_t burstPackets = kSlideShowBurstPackets;
-  if (!slideshow_mode_active_) {
-    burstPackets = std::min((number_of_full_padding_packets_ + 1), (uint64_t)kMaxBurstPackets);
-  }
-  return burstPackets * kMaxPaddingSize;
-}
-
 void RtpPaddingGeneratorHandler::enablePadding() {
   enabled_ = true;
-  number_of_full_padding_packets_ = 0;
-  last_padding_packet_size_ = 0;
   last_rate_calculation_time_ = clock_->now();
 }
 
 void RtpPaddingGeneratorHandler::disablePadding() {
   enabled_ = false;
+  setTargetPaddingBitrate(0);
 }
 
 }  // namespace erizo
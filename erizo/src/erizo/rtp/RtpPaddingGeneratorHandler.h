@@ -6,13 +6,23 @@
 #include "./logger.h"
 #include "pipeline/Handler.h"
 #include "lib/Clock.h"
-#include "lib/TokenBucket.h"
-#include "thread/Worker.h"
 #include "rtp/SequenceNumberTranslator.h"
+#include "rtp/PacketBufferService.h"
 #include "./Stats.h"
 
 namespace erizo {
 
+// Sent by the Pacer of the connection when it has budget left for padding
+class PaddingRequestEvent : public MediaEvent {
+ public:
+  explicit PaddingRequestEvent(uint32_t bytes_) : bytes{bytes_} {}
+
+  std::string getType() const override {
+    return "PaddingRequestEvent";
+  }
+  uint32_t bytes;
+};
+
 class MediaStream;
 
 class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from_this<RtpPaddingGeneratorHandler> {
@@ -31,19 +41,24 @@ class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from
   void read(Context *ctx, std::shared_ptr<DataPacket> packet) override;
   void write(Context *ctx, std::shared_ptr<DataPacket> packet) override;
   void notifyUpdate() override;
+  void notifyEvent(MediaEventPtr event) override;
 
  private:
-  void sendPaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size);
-  void onPacketWithMarkerSet(std::shared_ptr<DataPacket> packet);
+  void onPaddingRequest(uint32_t bytes);
+  void sendPaddingPackets(uint32_t bytes);
+  void sendPaddingPacket(uint8_t padding_size);
+  bool sendsRtxProbes();
+  void sendRtxProbes(uint32_t bytes);
+  void writePaddingPacket(std::shared_ptr<DataPacket> packet);
   bool isHigherSequenceNumber(std::shared_ptr<DataPacket> packet);
   void onVideoPacket(std::shared_ptr<DataPacket> packet);
 
   uint64_t getStat(std::string stat_name);
   uint64_t getTargetBitrate();
-  uint64_t getBurstSize();
 
   bool isTimeToCalculateBitrate();
   void recalculatePaddingRate();
+  void setTargetPaddingBitrate(uint64_t target_padding_bitrate);
 
   void enablePadding();
   void disablePadding();
@@ -53,21 +68,19 @@ class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from
   SequenceNumberTranslator translator_;
   MediaStream* stream_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingIntervalRateStat> padding_bitrate_;
+  std::shared_ptr<PacketBufferService> packet_buffer_;
   uint64_t max_video_bw_;
   uint16_t higher_sequence_number_;
   uint32_t video_sink_ssrc_;
   uint32_t audio_source_ssrc_;
-  uint64_t number_of_full_padding_packets_;
-  uint8_t last_padding_packet_size_;
+  uint64_t target_padding_bitrate_;
   time_point last_rate_calculation_time_;
   time_point started_at_;
   bool enabled_;
   bool first_packet_received_;
-  bool slideshow_mode_active_;
-  MovingIntervalRateStat marker_rate_;
   uint32_t rtp_header_length_;
-  TokenBucket bucket_;
-  std::shared_ptr<ScheduledTaskReference> scheduled_task_;
+  std::shared_ptr<DataPacket> last_video_packet_;
 };
 
 }  // namespace erizo
@@ -40,11 +40,11 @@ void RtpRetransmissionHandler::notifyUpdate() {
 }
 
 MovingIntervalRateStat& RtpRetransmissionHandler::getRtxBitrateStat() {
-  if (!stats_->getNode()["total"].hasChild("rtxBitrate")) {
-    stats_->getNode()["total"].insertStat("rtxBitrate",
+  if (!rtx_bitrate_) {
+    rtx_bitrate_ = stats_->getNode()["total"].getOrInsertStat("rtxBitrate",
         MovingIntervalRateStat{std::chrono::milliseconds(100), 30, 8.});
   }
-  return static_cast<erizo::MovingIntervalRateStat&>(stats_->getNode()["total"]["rtxBitrate"]);
+  return *rtx_bitrate_;
 }
 
 uint64_t RtpRetransmissionHandler::getBitrateCalculated() {
@@ -59,9 +59,34 @@ void RtpRetransmissionHandler::calculateRtxBitrate() {
   if (now - last_bitrate_time_ > kTimeToUpdateBitrate) {
     last_bitrate_time_ = now;
     bucket_.reset(getBitrateCalculated() * kMarginRtxBitrate, kBurstSize);
+    updatePacketBufferStats();
   }
 }
 
+void RtpRetransmissionHandler::updatePacketBufferStats() {
+  StatNode &total = stats_->getNode()["total"];
+  if (!rtx_buffer_hits_) {
+    rtx_buffer_hits_ = total.getOrInsertStat("rtxBufferHits", CumulativeStat{0});
+    rtx_buffer_misses_ = total.getOrInsertStat("rtxBufferMisses", CumulativeStat{0});
+    rtx_buffer_avg_age_ms_ = total.getOrInsertStat("rtxBufferAvgAgeMs", GaugeStat{0});
+    rtx_buffer_max_age_ms_ = total.getOrInsertStat("rtxBufferMaxAgeMs", GaugeStat{0});
+    rtx_buffer_packets_ = total.getOrInsertStat("rtxBufferPackets", GaugeStat{0});
+  }
+  // Only there once the first receiver report arrives
+  if (!rtt_) {
+    rtt_ = total.getStat("rtt");
+  }
+  if (rtt_) {
+    packet_buffer_->setRtt(std::chrono::milliseconds(rtt_->value()));
+  }
+  PacketBufferStats buffer_stats = packet_buffer_->getStats();
+  *rtx_buffer_hits_ = buffer_stats.hits;
+  *rtx_buffer_misses_ = buffer_stats.misses;
+  *rtx_buffer_avg_age_ms_ = buffer_stats.getAverageAgeMs();
+  *rtx_buffer_max_age_ms_ = buffer_stats.max_age_ms;
+  *rtx_buffer_packets_ = buffer_stats.buffered_packets;
+}
+
 void RtpRetransmissionHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   if (!enabled_ || !initialized_) {
     return;
@@ -87,18 +112,23 @@ void RtpRetransmissionHandler::read(Context *ctx, std::shared_ptr<DataPacket> pa
           if (packet_nacked) {
           std::shared_ptr<DataPacket> recovered;
 
-          if (stream_->getVideoSinkSSRC() == chead->getSourceSSRC()) {
-            recovered = packet_buffer_->getVideoPacket(seq_num);
-          } else if (stream_->getAudioSinkSSRC() == chead->getSourceSSRC()) {
-            recovered = packet_buffer_->getAudioPacket(seq_num);
+          bool is_video = stream_->getVideoSinkSSRC() == chead->getSourceSSRC();
+          if (is_video || stream_->getAudioSinkSSRC() == chead->getSourceSSRC()) {
+            recovered = packet_buffer_->getPacketToRetransmit(chead->getSourceSSRC(), seq_num);
           }
 
           if (recovered.get()) {
             if (!bucket_.consume(recovered->length)) {
               continue;
             }
-            RtpHeader *recovered_head = reinterpret_cast<RtpHeader*> (recovered->data);
-            if (recovered_head->getSeqNumber() == seq_num) {
+            if (is_video && packet_buffer_->hasVideoRtx()) {
+              recovered = packet_buffer_->makeVideoRtxPacket(recovered);
+            } else {
+              // The buffered packet itself is not marked, it could be retransmitted again
+              recovered = recovered->share();
+            }
+            if (recovered.get()) {
+              recovered->is_retransmission = true;
               getRtxBitrateStat() += recovered->length;
               getContext()->fireWrite(recovered);
               continue;
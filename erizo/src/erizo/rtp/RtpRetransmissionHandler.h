@@ -10,7 +10,6 @@
 #include "Stats.h"
 #include "rtp/PacketBufferService.h"
 
-static constexpr uint kRetransmissionsBufferSize = 256;
 static constexpr int kNackBlpSize = 16;
 
 static constexpr erizo::duration kTimeToUpdateBitrate = std::chrono::milliseconds(500);
@@ -42,12 +41,20 @@ class RtpRetransmissionHandler : public Handler {
   MovingIntervalRateStat& getRtxBitrateStat();
   uint64_t getBitrateCalculated();
   void calculateRtxBitrate();
+  void updatePacketBufferStats();
 
  private:
   std::shared_ptr<erizo::Clock> clock_;
   MediaStream *stream_;
   bool initialized_, enabled_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingIntervalRateStat> rtx_bitrate_;
+  std::shared_ptr<StatNode> rtt_;
+  std::shared_ptr<CumulativeStat> rtx_buffer_hits_;
+  std::shared_ptr<CumulativeStat> rtx_buffer_misses_;
+  std::shared_ptr<GaugeStat> rtx_buffer_avg_age_ms_;
+  std::shared_ptr<GaugeStat> rtx_buffer_max_age_ms_;
+  std::shared_ptr<GaugeStat> rtx_buffer_packets_;
   std::shared_ptr<PacketBufferService> packet_buffer_;
   TokenBucket bucket_;
   erizo::time_point last_bitrate_time_;
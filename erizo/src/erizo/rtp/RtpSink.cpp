@@ -39,11 +39,13 @@ namespace erizo {
   }
 
   int RtpSink::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
+    video_packet->makeWritable();
     this->queueData(video_packet->data, video_packet->length, VIDEO_PACKET);
     return 0;
   }
 
   int RtpSink::deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) {
+    audio_packet->makeWritable();
     this->queueData(audio_packet->data, audio_packet->length, AUDIO_PACKET);
     return 0;
   }
@@ -94,10 +94,9 @@ void RtpSlideShowHandler::write(Context *ctx, std::shared_ptr<DataPacket> packet
 
   uint16_t packet_seq_num = rtp_header->getSeqNumber();
   bool is_keyframe = false;
-  RtpMap *codec = stream_->getRemoteSdpInfo()->getCodecByExternalPayloadType(rtp_header->getPayloadType());
-  if (codec && (codec->encoding_name == "VP8" || codec->encoding_name == "H264")) {
+  if (packet->codec == RtpCodec::VP8 || packet->codec == RtpCodec::H264) {
     is_keyframe = isVP8OrH264Keyframe(packet);
-  } else if (codec && codec->encoding_name == "VP9") {
+  } else if (packet->codec == RtpCodec::VP9) {
     is_keyframe = isVP9Keyframe(packet);
   }
   if (slideshow_is_active_) {
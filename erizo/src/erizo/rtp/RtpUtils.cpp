@@ -159,6 +159,51 @@ std::shared_ptr<DataPacket> RtpUtils::makePaddingPacket(std::shared_ptr<DataPack
   return std::make_shared<DataPacket>(packet->comp, packet_buffer, packet_length, packet->type);
 }
 
+std::shared_ptr<DataPacket> RtpUtils::makeRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t rtx_ssrc,
+                                                    uint8_t rtx_payload_type, uint16_t rtx_sequence_number) {
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  int payload_length = packet->length - header_length - getPaddingLength(packet);
+  int rtx_length = header_length + sizeof(uint16_t) + payload_length;
+  if (payload_length < 0 || rtx_length > kPacketBufferSize) {
+    return nullptr;
+  }
+  auto rtx_packet = std::make_shared<DataPacket>(packet->comp, packet->data, header_length, packet->type,
+                                                 packet->received_time_ms);
+  RtpHeader *rtx_header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  uint16_t original_sequence_number = htons(header->getSeqNumber());
+  memcpy(rtx_packet->data + header_length, &original_sequence_number, sizeof(uint16_t));
+  memcpy(rtx_packet->data + header_length + sizeof(uint16_t), packet->data + header_length, payload_length);
+  rtx_packet->length = rtx_length;
+  rtx_header->setPadding(false);
+  rtx_header->setSSRC(rtx_ssrc);
+  rtx_header->setPayloadType(rtx_payload_type);
+  rtx_header->setSeqNumber(rtx_sequence_number);
+  return rtx_packet;
+}
+
+std::shared_ptr<DataPacket> RtpUtils::makePacketFromRtx(std::shared_ptr<DataPacket> rtx_packet, uint32_t ssrc,
+                                                        uint8_t payload_type) {
+  RtpHeader *rtx_header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  int header_length = rtx_header->getHeaderLength();
+  int payload_length = rtx_packet->length - header_length - getPaddingLength(rtx_packet) - sizeof(uint16_t);
+  if (payload_length <= 0) {
+    return nullptr;
+  }
+  uint16_t original_sequence_number;
+  memcpy(&original_sequence_number, rtx_packet->data + header_length, sizeof(uint16_t));
+  auto packet = std::make_shared<DataPacket>(rtx_packet->comp, rtx_packet->data, header_length, rtx_packet->type,
+                                             rtx_packet->received_time_ms);
+  memcpy(packet->data + header_length, rtx_packet->data + header_length + sizeof(uint16_t), payload_length);
+  packet->length = header_length + payload_length;
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  header->setPadding(false);
+  header->setSSRC(ssrc);
+  header->setPayloadType(payload_type);
+  header->setSeqNumber(ntohs(original_sequence_number));
+  return packet;
+}
+
 std::shared_ptr<DataPacket> RtpUtils::makeVP8BlackKeyframePacket(std::shared_ptr<DataPacket> packet) {
   uint8_t vp8_keyframe[] = {
     (uint8_t) 0x90, (uint8_t) 0xe0, (uint8_t) 0x80, (uint8_t) 0x01,  // payload header 1
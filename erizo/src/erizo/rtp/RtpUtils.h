@@ -36,6 +36,13 @@ class RtpUtils {
 
   static std::shared_ptr<DataPacket> makePaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size);
   static std::shared_ptr<DataPacket> makeVP8BlackKeyframePacket(std::shared_ptr<DataPacket> packet);
+
+  // RFC 4588 encapsulation, returns nullptr if the RTX packet would not fit in a packet buffer
+  static std::shared_ptr<DataPacket> makeRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t rtx_ssrc,
+                                                   uint8_t rtx_payload_type, uint16_t rtx_sequence_number);
+  // Returns nullptr if the RTX packet carries no original packet (i.e. it is only padding)
+  static std::shared_ptr<DataPacket> makePacketFromRtx(std::shared_ptr<DataPacket> rtx_packet, uint32_t ssrc,
+                                                       uint8_t payload_type);
 };
 
 }  // namespace erizo
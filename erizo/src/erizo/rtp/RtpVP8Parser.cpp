@@ -345,10 +345,14 @@ int RtpVP8Parser::removeTIDAndKeyIdx(unsigned char* data, int data_length) {
   return previous_data_length;
 }
 
-RTPPayloadVP8* RtpVP8Parser::parseVP8(unsigned char* data, int dataLength) {
+RTPPayloadVP8 RtpVP8Parser::parseVP8(const unsigned char* data, int dataLength) {
   // ELOG_DEBUG("Parsing VP8 %d bytes", dataLength);
-  RTPPayloadVP8* vp8 = new RTPPayloadVP8;  // = &parsedPacket.info.VP8;
+  RTPPayloadVP8 payload;
+  RTPPayloadVP8* vp8 = &payload;
   const unsigned char* dataPtr = data;
+  if (dataLength <= 0) {
+    return payload;
+  }
 
   // Parse mandatory first byte of payload descriptor
   bool extension = (*dataPtr & 0x80) ? true : false;  // X bit
@@ -361,7 +365,7 @@ RTPPayloadVP8* RtpVP8Parser::parseVP8(unsigned char* data, int dataLength) {
 
   if (vp8->partitionID > 8) {
     // Weak check for corrupt data: PartID MUST NOT be larger than 8.
-    return vp8;
+    return payload;
   }
 
   // Advance dataPtr and decrease remaining payload size
@@ -371,7 +375,7 @@ RTPPayloadVP8* RtpVP8Parser::parseVP8(unsigned char* data, int dataLength) {
   if (extension) {
     const int parsedBytes = ParseVP8Extension(vp8, dataPtr, dataLength);
     if (parsedBytes < 0) {
-      return vp8;
+      return payload;
     }
     dataPtr += parsedBytes;
     dataLength -= parsedBytes;
@@ -380,7 +384,7 @@ RTPPayloadVP8* RtpVP8Parser::parseVP8(unsigned char* data, int dataLength) {
 
   if (dataLength <= 0) {
     ELOG_WARN("Error parsing VP8 payload descriptor; payload too short");
-    return vp8;
+    return payload;
   }
 
   // Read P bit from payload header (only at beginning of first partition)
@@ -398,6 +402,6 @@ RTPPayloadVP8* RtpVP8Parser::parseVP8(unsigned char* data, int dataLength) {
   vp8->data = dataPtr;
   vp8->dataLength = (unsigned int) dataLength;
 
-  return vp8;
+  return payload;
 }
 }  // namespace erizo
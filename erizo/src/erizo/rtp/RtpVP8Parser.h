@@ -27,8 +27,8 @@ typedef struct {
   int frameHeight = -1;
   VP8FrameTypes frameType = kVP8PFrame;
 
-  const unsigned char* data;
-  unsigned int dataLength;
+  const unsigned char* data = nullptr;
+  unsigned int dataLength = 0;
 } RTPPayloadVP8;
 
 class RtpVP8Parser {
@@ -41,7 +41,7 @@ class RtpVP8Parser {
   static int removePictureID(unsigned char* data, int data_length);
   static int removeTl0PicIdx(unsigned char* data, int data_length);
   static int removeTIDAndKeyIdx(unsigned char* data, int data_length);
-  erizo::RTPPayloadVP8* parseVP8(unsigned char* data, int datalength);
+  erizo::RTPPayloadVP8 parseVP8(const unsigned char* data, int datalength);
 };
 }  // namespace erizo
 #endif  // ERIZO_SRC_ERIZO_RTP_RTPVP8PARSER_H_
@@ -68,11 +68,15 @@ RtpVP9Parser::~RtpVP9Parser() {
 //      | ..            |
 //      +-+-+-+-+-+-+-+-+
 
-RTPPayloadVP9* RtpVP9Parser::parseVP9(unsigned char* data, int dataLength) {
+RTPPayloadVP9 RtpVP9Parser::parseVP9(const unsigned char* data, int dataLength) {
   // ELOG_DEBUG("Parsing VP9 %d bytes", dataLength);
-  RTPPayloadVP9* vp9 = new RTPPayloadVP9;  // = &parsedPacket.info.VP9;
+  RTPPayloadVP9 payload;
+  RTPPayloadVP9* vp9 = &payload;
   const unsigned char* dataPtr = data;
   int len = dataLength;
+  if (len <= 0) {
+    return payload;
+  }
 
   // Parse mandatory first byte of payload descriptor
   vp9->hasPictureID = (*dataPtr & 0x80) ? true : false;  // I bit
@@ -139,7 +143,7 @@ RTPPayloadVP9* RtpVP9Parser::parseVP9(unsigned char* data, int dataLength) {
         height = (height << 8) + (*dataPtr & 0xFF);
         dataPtr++;
         len--;
-        vp9->resolutions.push_back({width, height});
+        vp9->resolutions[vp9->resolutionsCount++] = {width, height};
       }
     }
     if (vp9->hasGof) {
@@ -162,7 +166,7 @@ RTPPayloadVP9* RtpVP9Parser::parseVP9(unsigned char* data, int dataLength) {
   vp9->data = dataPtr;
   vp9->dataLength = (unsigned int) len;
 
-  return vp9;
+  return payload;
 }
 
 }  // namespace erizo
@@ -1,7 +1,7 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_RTPVP9PARSER_H_
 #define ERIZO_SRC_ERIZO_RTP_RTPVP9PARSER_H_
 
-#include <vector>
+#include <array>
 
 #include "./logger.h"
 
@@ -12,6 +12,9 @@ struct VP9ResolutionLayer {
   int height;
 };
 
+// N_S in the scalability structure is 3 bits, so a stream has at most 8 spatial layers
+static constexpr int kMaxVP9SpatialLayers = 8;
+
 enum VP9FrameTypes {
   kVP9IFrame,  // key frame
   kVP9PFrame   // Delta frame
@@ -42,10 +45,11 @@ typedef struct {
 
   int numberOfFramesInGof = -1;
 
-  std::vector<VP9ResolutionLayer> resolutions;
+  std::array<VP9ResolutionLayer, kMaxVP9SpatialLayers> resolutions;
+  int resolutionsCount = 0;
 
-  const unsigned char* data;
-  unsigned int dataLength;
+  const unsigned char* data = nullptr;
+  unsigned int dataLength = 0;
   VP9FrameTypes frameType = kVP9PFrame;
 } RTPPayloadVP9;
 
@@ -54,7 +58,7 @@ class RtpVP9Parser {
  public:
   RtpVP9Parser();
   virtual ~RtpVP9Parser();
-  erizo::RTPPayloadVP9* parseVP9(unsigned char* data, int datalength);
+  erizo::RTPPayloadVP9 parseVP9(const unsigned char* data, int datalength);
 };
 }  // namespace erizo
 #endif  // ERIZO_SRC_ERIZO_RTP_RTPVP9PARSER_H_
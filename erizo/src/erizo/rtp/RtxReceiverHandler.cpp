@@ -0,0 +1,64 @@
+#include "rtp/RtxReceiverHandler.h"
+
+#include "./MediaDefinitions.h"
+#include "./MediaStream.h"
+#include "rtp/RtpUtils.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(RtxReceiverHandler, "rtp.RtxReceiverHandler");
+
+RtxReceiverHandler::RtxReceiverHandler() :
+    stream_{nullptr}, enabled_{true} {}
+
+void RtxReceiverHandler::enable() {
+  enabled_ = true;
+}
+
+void RtxReceiverHandler::disable() {
+  enabled_ = false;
+}
+
+void RtxReceiverHandler::notifyUpdate() {
+  auto pipeline = getContext()->getPipelineShared();
+  if (pipeline && !stream_) {
+    stream_ = pipeline->getService<MediaStream>().get();
+  }
+  if (!stream_) {
+    return;
+  }
+  rtx_ssrc_map_ = stream_->getVideoSourceRtxSSRCMap();
+  if (stream_->getRemoteSdpInfo()) {
+    rtx_payload_types_ = stream_->getRemoteSdpInfo()->getRtxAssociatedPTs(VIDEO_TYPE);
+  }
+}
+
+void RtxReceiverHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (!enabled_ || rtx_ssrc_map_.empty() || chead->isRtcp()) {
+    ctx->fireRead(std::move(packet));
+    return;
+  }
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  auto media_ssrc = rtx_ssrc_map_.find(rtp_header->getSSRC());
+  if (media_ssrc == rtx_ssrc_map_.end()) {
+    ctx->fireRead(std::move(packet));
+    return;
+  }
+  auto payload_type = rtx_payload_types_.find(rtp_header->getPayloadType());
+  if (payload_type == rtx_payload_types_.end()) {
+    ELOG_DEBUG("message: RTX packet with unknown payload type, ssrc: %u, PT: %u",
+               rtp_header->getSSRC(), rtp_header->getPayloadType());
+    return;
+  }
+  std::shared_ptr<DataPacket> recovered = RtpUtils::makePacketFromRtx(packet, media_ssrc->second,
+                                                                      payload_type->second);
+  // Padding-only RTX packets are bandwidth probes, they don't carry any media
+  if (!recovered) {
+    return;
+  }
+  recovered->type = VIDEO_PACKET;
+  ctx->fireRead(std::move(recovered));
+}
+
+}  // namespace erizo
@@ -0,0 +1,40 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_RTXRECEIVERHANDLER_H_
+#define ERIZO_SRC_ERIZO_RTP_RTXRECEIVERHANDLER_H_
+
+#include <map>
+#include <string>
+
+#include "./logger.h"
+#include "pipeline/Handler.h"
+
+namespace erizo {
+
+class MediaStream;
+
+// Restores the original packets from RTX (RFC 4588) streams sent by publishers
+class RtxReceiverHandler: public InboundHandler {
+  DECLARE_LOGGER();
+
+ public:
+  RtxReceiverHandler();
+
+  void enable() override;
+  void disable() override;
+
+  std::string getName() override {
+    return "rtx-receiver";
+  }
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override;
+  void notifyUpdate() override;
+
+ private:
+  MediaStream *stream_;
+  bool enabled_;
+  std::map<uint32_t, uint32_t> rtx_ssrc_map_;
+  std::map<unsigned int, unsigned int> rtx_payload_types_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_RTXRECEIVERHANDLER_H_
@@ -97,9 +97,17 @@ void SenderBandwidthEstimationHandler::read(Context *ctx, std::shared_ptr<DataPa
                 [last_sr](const std::shared_ptr<SrDelayData> sr_info) {
                 return sr_info->sr_ntp == last_sr;
                 });
+            uint32_t delay = 0;
+            if (value != sr_delay_data_.end()) {
+              // A receiver reporting a longer delay than the time since the SR would wrap the unsigned rtt
+              delay = std::max<int64_t>(now_ms - (*value)->sr_send_time - delay_since_last_ms, 0);
+              if (!rtt_) {
+                rtt_ = stats_->getNode()["total"].getOrInsertStat("rtt", GaugeStat{delay});
+              }
+              *rtt_ = delay;
+            }
             // TODO(pedro) Implement alternative when there are no REMBs
             if (received_remb_ && value != sr_delay_data_.end()) {
-                uint32_t delay = now_ms - (*value)->sr_send_time - delay_since_last_ms;
                 ELOG_DEBUG("%s message: Updating Estimate with RR, fraction_lost: %u, "
                     "delay: %u, period_packets_sent_: %u",
                     stream_->toLog(), chead->getFractionLost(), delay, period_packets_sent_);
@@ -171,10 +179,15 @@ void SenderBandwidthEstimationHandler::analyzeSr(RtcpHeader* chead) {
 void SenderBandwidthEstimationHandler::updateEstimate() {
   sender_bwe_->CurrentEstimate(&estimated_bitrate_, &estimated_loss_,
       &estimated_rtt_);
-  stats_->getNode()["total"].insertStat("senderBitrateEstimation",
-      CumulativeStat{static_cast<uint64_t>(estimated_bitrate_)});
+  if (!sender_bitrate_estimation_) {
+    sender_bitrate_estimation_ = stats_->getNode()["total"].getOrInsertStat("senderBitrateEstimation",
+        CumulativeStat{0});
+  }
+  *sender_bitrate_estimation_ = static_cast<uint64_t>(estimated_bitrate_);
   ELOG_DEBUG("%s message: estimated bitrate %d, loss %u, rtt %ld",
       stream_->toLog(), estimated_bitrate_, estimated_loss_, estimated_rtt_);
+  // The connection paces its packets at the sum of the estimates of its streams
+  stream_->setSenderBandwidthEstimate(estimated_bitrate_);
   if (bwe_listener_) {
     bwe_listener_->onBandwidthEstimate(estimated_bitrate_, estimated_loss_, estimated_rtt_);
   }
@@ -66,6 +66,8 @@ class SenderBandwidthEstimationHandler : public Handler,
   std::shared_ptr<SendSideBandwidthEstimation> sender_bwe_;
   std::list<std::shared_ptr<SrDelayData>> sr_delay_data_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<GaugeStat> rtt_;
+  std::shared_ptr<CumulativeStat> sender_bitrate_estimation_;
 
   void updateEstimate();
 };
@@ -2,6 +2,7 @@
 #define ERIZO_SRC_ERIZO_RTP_STATSHANDLER_H_
 
 #include <string>
+#include <unordered_map>
 
 #include "./logger.h"
 #include "pipeline/Handler.h"
@@ -33,13 +34,22 @@ class StatsCalculator {
   }
 
  private:
+  struct SsrcStats {
+    std::shared_ptr<MovingIntervalRateStat> bitrate;
+    std::shared_ptr<CumulativeStat> key_frames;
+  };
+
   void processRtpPacket(std::shared_ptr<DataPacket> packet);
   void processRtcpPacket(std::shared_ptr<DataPacket> packet);
-  void incrStat(uint32_t ssrc, std::string stat);
+  SsrcStats& getSsrcStats(uint32_t ssrc);
+  void incrStat(uint32_t ssrc, const std::string &stat);
+  void setStat(uint32_t ssrc, const std::string &stat, uint64_t value);
 
  private:
   MediaStream* stream_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingIntervalRateStat> total_bitrate_;
+  std::unordered_map<uint32_t, SsrcStats> ssrc_stats_;
 };
 
 class IncomingStatsHandler: public InboundHandler, public StatsCalculator {
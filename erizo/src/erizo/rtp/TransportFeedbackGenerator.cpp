@@ -0,0 +1,85 @@
+#include "rtp/TransportFeedbackGenerator.h"
+
+#include <algorithm>
+
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(TransportFeedbackGenerator, "rtp.TransportFeedbackGenerator");
+
+constexpr duration TransportFeedbackGenerator::kFeedbackInterval;
+constexpr size_t TransportFeedbackGenerator::kMaxPendingPackets;
+constexpr size_t TransportFeedbackGenerator::kMaxPacketsPerFeedback;
+
+TransportFeedbackGenerator::TransportFeedbackGenerator(std::shared_ptr<Clock> the_clock)
+    : clock_{the_clock}, next_sequence_number_{-1}, feedback_sequence_{0}, media_ssrc_{0}, sender_ssrc_{0} {
+  pending_packets_.reserve(kMaxPendingPackets);
+}
+
+void TransportFeedbackGenerator::onPacketReceived(uint16_t sequence_number, uint32_t media_ssrc,
+                                                  uint32_t sender_ssrc) {
+  int64_t unwrapped_sequence_number = unwrapper_.Unwrap(sequence_number);
+  if (unwrapped_sequence_number < next_sequence_number_) {
+    // Already reported as lost
+    return;
+  }
+  if (pending_packets_.size() >= kMaxPendingPackets) {
+    ELOG_DEBUG("message: Too many packets pending feedback, dropping sequence number %u", sequence_number);
+    return;
+  }
+  media_ssrc_ = media_ssrc;
+  sender_ssrc_ = sender_ssrc;
+  int64_t arrival_time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+    clock_->now().time_since_epoch()).count();
+  pending_packets_.push_back(ReceivedPacket{unwrapped_sequence_number, arrival_time_us});
+}
+
+std::shared_ptr<DataPacket> TransportFeedbackGenerator::generateFeedback() {
+  if (pending_packets_.empty()) {
+    return nullptr;
+  }
+  std::sort(pending_packets_.begin(), pending_packets_.end(),
+    [](const ReceivedPacket &first, const ReceivedPacket &second) {
+      return first.sequence_number < second.sequence_number;
+    });
+
+  webrtc::rtcp::TransportFeedback feedback;
+  feedback.SetSenderSsrc(sender_ssrc_);
+  feedback.SetMediaSsrc(media_ssrc_);
+  feedback.SetFeedbackSequenceNumber(feedback_sequence_++);
+  const ReceivedPacket &first_packet = pending_packets_.front();
+  int64_t base_sequence_number = std::max(next_sequence_number_, first_packet.sequence_number);
+  feedback.SetBase(static_cast<uint16_t>(base_sequence_number & 0xFFFF), first_packet.arrival_time_us);
+
+  auto packet_iterator = pending_packets_.begin();
+  int64_t last_sequence_number = -1;
+  size_t reported_packets = 0;
+  for (; packet_iterator != pending_packets_.end() && reported_packets < kMaxPacketsPerFeedback;
+       ++packet_iterator) {
+    if (packet_iterator->sequence_number == last_sequence_number) {
+      continue;
+    }
+    if (!feedback.AddReceivedPacket(static_cast<uint16_t>(packet_iterator->sequence_number & 0xFFFF),
+                                    packet_iterator->arrival_time_us)) {
+      break;
+    }
+    last_sequence_number = packet_iterator->sequence_number;
+    reported_packets++;
+  }
+  pending_packets_.erase(pending_packets_.begin(), packet_iterator);
+  if (last_sequence_number < 0) {
+    return nullptr;
+  }
+  next_sequence_number_ = last_sequence_number + 1;
+
+  rtc::Buffer buffer = feedback.Build();
+  if (buffer.size() > static_cast<size_t>(kPacketBufferSize)) {
+    ELOG_WARN("message: Transport feedback does not fit in a packet, size: %zu", buffer.size());
+    return nullptr;
+  }
+  return std::make_shared<DataPacket>(0, reinterpret_cast<const char*>(buffer.data()), buffer.size(),
+                                      OTHER_PACKET);
+}
+
+}  // namespace erizo
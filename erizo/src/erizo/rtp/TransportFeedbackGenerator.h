@@ -0,0 +1,52 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKGENERATOR_H_
+#define ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKGENERATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "./logger.h"
+#include "./MediaDefinitions.h"
+#include "lib/Clock.h"
+
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace erizo {
+
+// Receive side of transport-wide congestion control. It records the arrival time of every packet carrying a
+// transport-wide sequence number and reports them back to the sender in RTCP transport feedback packets.
+class TransportFeedbackGenerator {
+  DECLARE_LOGGER();
+
+ public:
+  static constexpr duration kFeedbackInterval = std::chrono::milliseconds(100);
+  static constexpr size_t kMaxPendingPackets = 1000;
+  // Keeps the worst case feedback (two byte deltas) well below the packet buffer size
+  static constexpr size_t kMaxPacketsPerFeedback = 300;
+
+  explicit TransportFeedbackGenerator(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+
+  void onPacketReceived(uint16_t sequence_number, uint32_t media_ssrc, uint32_t sender_ssrc);
+
+  // Returns nullptr if there is nothing to report. Packets that don't fit in one feedback are kept for the next
+  std::shared_ptr<DataPacket> generateFeedback();
+
+  bool hasPendingPackets() { return !pending_packets_.empty(); }
+
+ private:
+  struct ReceivedPacket {
+    int64_t sequence_number;
+    int64_t arrival_time_us;
+  };
+
+  std::shared_ptr<Clock> clock_;
+  webrtc::SequenceNumberUnwrapper unwrapper_;
+  std::vector<ReceivedPacket> pending_packets_;
+  int64_t next_sequence_number_;
+  uint8_t feedback_sequence_;
+  uint32_t media_ssrc_;
+  uint32_t sender_ssrc_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKGENERATOR_H_
@@ -13,11 +13,12 @@ namespace erizo {
 
 typedef std::map<std::string, std::shared_ptr<StatNode>> NodeMap;
 
-StatNode& StatNode::operator[](std::string key) {
-  if (!hasChild(key)) {
-    node_map_[key] = std::make_shared<StatNode>();
+StatNode& StatNode::operator[](const std::string &key) {
+  std::shared_ptr<StatNode> &node = node_map_[key];
+  if (!node) {
+    node = std::make_shared<StatNode>();
   }
-  return *node_map_[key];
+  return *node;
 }
 
 std::string StatNode::toString() {
@@ -35,6 +36,22 @@ std::string StatNode::toString() {
   return text.str();
 }
 
+void StatNode::collectValues(std::string *path, std::vector<StatValue> *values) {
+  if (isNumeric()) {
+    values->push_back(StatValue{*path, value()});
+    return;
+  }
+  size_t path_length = path->size();
+  for (auto &child : node_map_) {
+    if (path_length > 0) {
+      path->push_back('.');
+    }
+    path->append(child.first);
+    child.second->collectValues(path, values);
+    path->resize(path_length);
+  }
+}
+
 StatNode& StringStat::operator=(std::string text) {
   text_ = text;
   return *this;
@@ -51,6 +68,11 @@ StatNode& CumulativeStat::operator=(uint64_t initial) {
   return *this;
 }
 
+StatNode& GaugeStat::operator=(uint64_t value) {
+  value_ = value;
+  return *this;
+}
+
 StatNode CumulativeStat::operator++(int value) {
   CumulativeStat node{total_};
   total_++;
@@ -10,25 +10,54 @@
 
 namespace erizo {
 
+struct StatValue {
+  std::string path;
+  uint64_t value;
+};
+
 class StatNode {
  public:
   StatNode() {}
   virtual ~StatNode() {}
 
-  virtual StatNode& operator[](std::string key);
+  virtual StatNode& operator[](const std::string &key);
 
   virtual StatNode& operator[](uint64_t key) { return (*this)[std::to_string(key)]; }
 
+  // Handles returned by insertStat, getOrInsertStat and getStat can be updated in the packet path without
+  // walking the tree again. Inserting a stat of the same type again updates the existing node in place.
   template <typename Node>
-  void insertStat(std::string key, Node&& stat) {  // NOLINT
+  std::shared_ptr<Node> insertStat(const std::string &key, Node&& stat) {  // NOLINT
+    auto node_iterator = node_map_.find(key);
+    if (node_iterator != node_map_.end()) {
+      if (auto node = std::dynamic_pointer_cast<Node>(node_iterator->second)) {
+        *node = std::forward<Node>(stat);
+        return node;
+      }
+    }
     // forward ensures that Node type is passed to make_shared(). It would otherwise pass StatNode.
-    if (node_map_.find(key) != node_map_.end()) {
-      node_map_.erase(key);
+    auto node = std::make_shared<Node>(std::forward<Node>(stat));
+    node_map_[key] = node;
+    return node;
+  }
+
+  template <typename Node>
+  std::shared_ptr<Node> getOrInsertStat(const std::string &key, Node&& stat) {  // NOLINT
+    auto node_iterator = node_map_.find(key);
+    if (node_iterator != node_map_.end()) {
+      if (auto node = std::dynamic_pointer_cast<Node>(node_iterator->second)) {
+        return node;
+      }
     }
-    node_map_.insert(std::make_pair(key, std::make_shared<Node>(std::forward<Node>(stat))));
+    return insertStat(key, std::forward<Node>(stat));
   }
 
-  virtual bool hasChild(std::string name) { return node_map_.find(name) != node_map_.end(); }
+  std::shared_ptr<StatNode> getStat(const std::string &key) {
+    auto node_iterator = node_map_.find(key);
+    return node_iterator != node_map_.end() ? node_iterator->second : std::shared_ptr<StatNode>();
+  }
+
+  virtual bool hasChild(const std::string &name) { return node_map_.find(name) != node_map_.end(); }
 
   virtual bool hasChild(uint64_t value) { return hasChild(std::to_string(value)); }
 
@@ -42,6 +71,12 @@ class StatNode {
 
   virtual std::string toString();
 
+  virtual bool isNumeric() { return false; }
+
+  // Appends the numeric stats below this node with their dotted paths. Path is used as a scratch buffer, it is
+  // restored before returning
+  void collectValues(std::string *path, std::vector<StatValue> *values);
+
  private:
   std::map<std::string, std::shared_ptr<StatNode>> node_map_;
 };
@@ -83,10 +118,31 @@ class CumulativeStat : public StatNode {
 
   uint64_t value() override { return total_; }
 
+  bool isNumeric() override { return true; }
+
  private:
   uint64_t total_;
 };
 
+// Current value of a measure that can also go down, like a size or an age
+class GaugeStat : public StatNode {
+ public:
+  GaugeStat() : value_{0} {}
+  explicit GaugeStat(uint64_t value) : value_{value} {}
+  virtual ~GaugeStat() {}
+
+  StatNode& operator=(uint64_t value);
+
+  std::string toString() override { return std::to_string(value_); }
+
+  uint64_t value() override { return value_; }
+
+  bool isNumeric() override { return true; }
+
+ private:
+  uint64_t value_;
+};
+
 class RateStat : public StatNode {
  public:
   RateStat(duration period, double scale,
@@ -99,6 +155,8 @@ class RateStat : public StatNode {
 
   uint64_t value() override;
 
+  bool isNumeric() override { return true; }
+
   std::string toString() override;
 
  private:
@@ -127,6 +185,8 @@ class MovingIntervalRateStat : public StatNode {
   StatNode& operator+=(uint64_t value) override;
 
   uint64_t value() override;
+
+  bool isNumeric() override { return true; }
   uint64_t value(duration stat_interval);
 
   std::string toString() override;
@@ -164,6 +224,8 @@ class MovingAverageStat : public StatNode {
 
   uint64_t value() override;
 
+  bool isNumeric() override { return true; }
+
   uint64_t value(uint32_t sample_number);
 
   std::string toString() override;
@@ -0,0 +1,160 @@
+#include "stats/StatsBatcher.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "./MediaStream.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(StatsBatcher, "stats.StatsBatcher");
+
+namespace {
+
+// Owned by the pending collection tasks, the callback runs when the last of them is done or dropped
+class StatsBatch {
+ public:
+  StatsBatch(std::shared_ptr<StatsConsumer> consumer, std::set<std::string> stream_ids,
+      StatsBatcher::BatchCallback callback)
+    : consumer_{std::move(consumer)}, stream_ids_{std::move(stream_ids)}, callback_{std::move(callback)} {}
+
+  ~StatsBatch() {
+    consumer_->keepStreams(stream_ids_);
+    callback_(std::move(deltas_));
+  }
+
+  void add(const std::string &stream_id, const std::vector<StatValue> &values) {
+    StatsDelta delta = consumer_->update(stream_id, values);
+    if (delta.counters.empty()) {
+      return;
+    }
+    boost::mutex::scoped_lock lock(mutex_);
+    deltas_.push_back(std::move(delta));
+  }
+
+ private:
+  std::shared_ptr<StatsConsumer> consumer_;
+  std::set<std::string> stream_ids_;
+  StatsBatcher::BatchCallback callback_;
+  boost::mutex mutex_;
+  std::vector<StatsDelta> deltas_;
+};
+
+template <typename T>
+void append(T value, std::string *buffer) {
+  for (size_t byte = 0; byte < sizeof(T); byte++) {
+    buffer->push_back(static_cast<char>((value >> (8 * byte)) & 0xff));
+  }
+}
+
+void appendString(const std::string &text, std::string *buffer) {
+  uint16_t length = static_cast<uint16_t>(std::min(text.size(),
+    static_cast<size_t>(std::numeric_limits<uint16_t>::max())));
+  append(length, buffer);
+  buffer->append(text, 0, length);
+}
+
+}  // namespace
+
+StatsConsumer::StatsConsumer() : next_key_id_{1} {
+}
+
+StatsDelta StatsConsumer::update(const std::string &stream_id, const std::vector<StatValue> &values) {
+  StatsDelta delta;
+  delta.stream_id = stream_id;
+  boost::mutex::scoped_lock lock(mutex_);
+  std::map<std::string, ReportedStat> &reported_stats = streams_[stream_id];
+  for (const StatValue &stat : values) {
+    auto reported = reported_stats.find(stat.path);
+    if (reported == reported_stats.end()) {
+      reported = reported_stats.emplace(stat.path, ReportedStat{next_key_id_++, stat.value}).first;
+      delta.new_keys.push_back(StatsKey{reported->second.id, stat.path});
+    } else if (reported->second.value == stat.value) {
+      continue;
+    }
+    reported->second.value = stat.value;
+    delta.counters.push_back(StatsCounter{reported->second.id, stat.value});
+  }
+  return delta;
+}
+
+void StatsConsumer::keepStreams(const std::set<std::string> &stream_ids) {
+  boost::mutex::scoped_lock lock(mutex_);
+  for (auto stream = streams_.begin(); stream != streams_.end();) {
+    if (stream_ids.count(stream->first) == 0) {
+      stream = streams_.erase(stream);
+    } else {
+      ++stream;
+    }
+  }
+}
+
+StatsBatcher::StatsBatcher() {
+}
+
+void StatsBatcher::addStream(std::weak_ptr<MediaStream> stream) {
+  boost::mutex::scoped_lock lock(mutex_);
+  streams_.push_back(stream);
+}
+
+size_t StatsBatcher::getStreamCount() {
+  boost::mutex::scoped_lock lock(mutex_);
+  return streams_.size();
+}
+
+void StatsBatcher::collect(std::shared_ptr<StatsConsumer> consumer, BatchCallback callback) {
+  std::vector<std::shared_ptr<MediaStream>> streams;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    streams.reserve(streams_.size());
+    streams_.erase(std::remove_if(streams_.begin(), streams_.end(),
+      [&streams](const std::weak_ptr<MediaStream> &weak_stream) {
+        if (auto stream = weak_stream.lock()) {
+          streams.push_back(stream);
+          return false;
+        }
+        return true;
+      }), streams_.end());
+  }
+  std::set<std::string> stream_ids;
+  for (const std::shared_ptr<MediaStream> &stream : streams) {
+    stream_ids.insert(stream->getId());
+  }
+  auto batch = std::make_shared<StatsBatch>(std::move(consumer), std::move(stream_ids), std::move(callback));
+  for (const std::shared_ptr<MediaStream> &stream : streams) {
+    std::string stream_id = stream->getId();
+    stream->getStatValues([batch, stream_id] (std::vector<StatValue> values) {
+      batch->add(stream_id, values);
+    });
+  }
+}
+
+void StatsBatcher::serialize(const std::vector<StatsDelta> &deltas, std::string *buffer) {
+  size_t size = sizeof(uint32_t);
+  for (const StatsDelta &delta : deltas) {
+    size += sizeof(uint16_t) + delta.stream_id.size() + 2 * sizeof(uint32_t) +
+      delta.counters.size() * (sizeof(uint32_t) + sizeof(uint64_t));
+    for (const StatsKey &key : delta.new_keys) {
+      size += sizeof(uint32_t) + sizeof(uint16_t) + key.path.size();
+    }
+  }
+  buffer->reserve(buffer->size() + size);
+
+  append(static_cast<uint32_t>(deltas.size()), buffer);
+  for (const StatsDelta &delta : deltas) {
+    appendString(delta.stream_id, buffer);
+    append(static_cast<uint32_t>(delta.new_keys.size()), buffer);
+    for (const StatsKey &key : delta.new_keys) {
+      append(key.id, buffer);
+      appendString(key.path, buffer);
+    }
+    append(static_cast<uint32_t>(delta.counters.size()), buffer);
+    for (const StatsCounter &counter : delta.counters) {
+      append(counter.id, buffer);
+      append(counter.value, buffer);
+    }
+  }
+}
+
+}  // namespace erizo
@@ -0,0 +1,89 @@
+#ifndef ERIZO_SRC_ERIZO_STATS_STATSBATCHER_H_
+#define ERIZO_SRC_ERIZO_STATS_STATSBATCHER_H_
+
+#include <boost/thread/mutex.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "./logger.h"
+#include "stats/StatNode.h"
+
+namespace erizo {
+
+class MediaStream;
+
+struct StatsKey {
+  uint32_t id;
+  std::string path;
+};
+
+struct StatsCounter {
+  uint32_t id;
+  uint64_t value;
+};
+
+// Numeric stats of a stream that changed since the previous delta sent to the same consumer. Paths are only
+// sent with the first delta that reports a stat, the following ones refer to it by id.
+struct StatsDelta {
+  std::string stream_id;
+  std::vector<StatsKey> new_keys;
+  std::vector<StatsCounter> counters;
+};
+
+// Key ids and last values of the stats already sent to one consumer, every consumer gets its own so all of them
+// receive the path of every stat
+class StatsConsumer {
+ public:
+  StatsConsumer();
+
+  // Turns the current values of a stream into the changes since the previous call for that stream
+  StatsDelta update(const std::string &stream_id, const std::vector<StatValue> &values);
+  // Forgets the stats of the streams that are not in stream_ids
+  void keepStreams(const std::set<std::string> &stream_ids);
+
+ private:
+  struct ReportedStat {
+    uint32_t id;
+    uint64_t value;
+  };
+
+  boost::mutex mutex_;
+  uint32_t next_key_id_;
+  std::map<std::string, std::map<std::string, ReportedStat>> streams_;
+};
+
+// Collects the stats deltas of every registered stream into a single batch, so periodic stats can be exported
+// with one callback per interval instead of one JSON message per stream.
+class StatsBatcher {
+  DECLARE_LOGGER();
+
+ public:
+  typedef std::function<void(std::vector<StatsDelta>)> BatchCallback;
+
+  StatsBatcher();
+
+  void addStream(std::weak_ptr<MediaStream> stream);
+  size_t getStreamCount();
+
+  // Callback is called once with the streams that had changes for consumer, from the worker that completes the
+  // batch or right away if there are no streams. Streams closed before answering are left out.
+  void collect(std::shared_ptr<StatsConsumer> consumer, BatchCallback callback);
+
+  // Little endian: u32 number of deltas, and for each one the stream id (u16 length + bytes),
+  // u32 number of new keys followed by (u32 id, u16 length + path bytes),
+  // u32 number of counters followed by (u32 id, u64 value)
+  static void serialize(const std::vector<StatsDelta> &deltas, std::string *buffer);
+
+ private:
+  boost::mutex mutex_;
+  std::vector<std::weak_ptr<MediaStream>> streams_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_STATS_STATSBATCHER_H_
@@ -19,14 +19,34 @@ IOThreadPool::~IOThreadPool() {
 
 std::shared_ptr<IOWorker> IOThreadPool::getLessUsedIOWorker() {
   std::shared_ptr<IOWorker> chosen_io_worker = io_workers_.front();
+  erizo::WorkerLoad chosen_load = chosen_io_worker->getLoad();
   for (auto io_worker : io_workers_) {
-    if (chosen_io_worker.use_count() > io_worker.use_count()) {
+    erizo::WorkerLoad load = io_worker->getLoad();
+    int comparison = load.compare(chosen_load);
+    if (comparison < 0 || (comparison == 0 && chosen_io_worker.use_count() > io_worker.use_count())) {
       chosen_io_worker = io_worker;
+      chosen_load = load;
     }
   }
   return chosen_io_worker;
 }
 
+std::vector<erizo::WorkerLoad> IOThreadPool::getWorkerLoads() {
+  std::vector<erizo::WorkerLoad> loads;
+  for (auto io_worker : io_workers_) {
+    loads.push_back(io_worker->getLoad());
+  }
+  return loads;
+}
+
+std::vector<erizo::PacketBufferPoolStats> IOThreadPool::getPacketBufferPoolStats() {
+  std::vector<erizo::PacketBufferPoolStats> stats;
+  for (auto io_worker : io_workers_) {
+    stats.push_back(io_worker->getPacketBufferPoolStats());
+  }
+  return stats;
+}
+
 void IOThreadPool::start() {
   std::vector<std::shared_ptr<std::promise<void>>> promises(io_workers_.size());
   int index = 0;
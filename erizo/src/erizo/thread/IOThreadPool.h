@@ -5,7 +5,6 @@
 #include <vector>
 
 #include "thread/IOWorker.h"
-#include "thread/Scheduler.h"
 
 namespace erizo {
 
@@ -15,6 +14,8 @@ class IOThreadPool {
   ~IOThreadPool();
 
   std::shared_ptr<IOWorker> getLessUsedIOWorker();
+  std::vector<PacketBufferPoolStats> getPacketBufferPoolStats();
+  std::vector<WorkerLoad> getWorkerLoads();
   void start();
   void close();
 
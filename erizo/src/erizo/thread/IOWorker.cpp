@@ -1,20 +1,44 @@
 #include "thread/IOWorker.h"
 
+#include <fcntl.h>
+#include <glib.h>
+#include <unistd.h>
+
 extern "C" {
 #include <r_errors.h>
 #include <async_wait.h>
 #include <async_timer.h>
 }
 
+#include <algorithm>
 #include <chrono>  // NOLINT
 
 using erizo::IOWorker;
+using erizo::WorkerLoad;
+
+static constexpr int kMaxWaitMs = 100;
+static constexpr int kGlibReadEvents = G_IO_IN | G_IO_PRI | G_IO_HUP | G_IO_ERR;
 
-IOWorker::IOWorker() : started_{false}, closed_{false} {
+IOWorker::IOWorker() : started_{false}, closed_{false},
+    packet_buffer_pool_{std::make_shared<erizo::PacketBufferPool>()},
+    glib_context_{g_main_context_new()}, glib_context_users_{0}, glib_max_priority_{0}, wakeup_fds_{-1, -1},
+    wakeup_pending_{false},
+    clock_{std::make_shared<erizo::SteadyClock>()}, load_tracker_{clock_} {
+  if (pipe(wakeup_fds_) == 0) {
+    fcntl(wakeup_fds_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeup_fds_[1], F_SETFL, O_NONBLOCK);
+  } else {
+    wakeup_fds_[0] = wakeup_fds_[1] = -1;
+  }
 }
 
 IOWorker::~IOWorker() {
   close();
+  g_main_context_unref(glib_context_);
+  if (wakeup_fds_[0] != -1) {
+    ::close(wakeup_fds_[0]);
+    ::close(wakeup_fds_[1]);
+  }
 }
 
 void IOWorker::start() {
@@ -28,36 +52,182 @@ void IOWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
   }
 
   thread_ = std::unique_ptr<std::thread>(new std::thread([this, start_promise] {
+    erizo::PacketBufferPool::setCurrent(packet_buffer_pool_);
+    thread_id_ = std::this_thread::get_id();
+    g_main_context_push_thread_default(glib_context_);
+    g_main_context_acquire(glib_context_);
+    armWakeUp();
     start_promise->set_value();
     while (!closed_) {
       int events;
-      struct timeval towait = {0, 100000};
+      bool glib_active = glib_context_users_ > 0;
+      int timeout_ms = std::min(getNextTimeoutMs(), kMaxWaitMs);
+      if (glib_active) {
+        int glib_timeout_ms = prepareGlibSources();
+        if (glib_timeout_ms >= 0) {
+          timeout_ms = std::min(timeout_ms, glib_timeout_ms);
+        }
+      }
+      struct timeval towait = {0, timeout_ms * 1000};
       struct timeval tv;
       int r = NR_async_event_wait2(&events, &towait);
-      if (r == R_EOD) {
+      if (glib_active) {
+        dispatchGlibSources();
+      } else if (r == R_EOD) {
+        // Nothing registered in nicer, only happens when the wake up pipe could not be created
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
       }
       gettimeofday(&tv, 0);
       NR_async_timer_update_time(&tv);
+      wakeup_pending_ = false;
       std::vector<Task> tasks;
       {
         std::unique_lock<std::mutex> lock(task_mutex_);
         tasks.swap(tasks_);
       }
+      if (tasks.empty()) {
+        continue;
+      }
+      erizo::time_point start = clock_->now();
       for (Task &task : tasks) {
         task();
       }
+      load_tracker_.addTasks(tasks.size());
+      load_tracker_.addBusyTime(clock_->now() - start);
     }
+    if (wakeup_fds_[0] != -1) {
+      NR_ASYNC_CANCEL(wakeup_fds_[0], NR_ASYNC_WAIT_READ);
+    }
+    g_main_context_release(glib_context_);
+    g_main_context_pop_thread_default(glib_context_);
   }));
 }
 
+void IOWorker::armWakeUp() {
+  if (wakeup_fds_[0] != -1) {
+    NR_ASYNC_WAIT(wakeup_fds_[0], NR_ASYNC_WAIT_READ, &IOWorker::onWakeUp, this);
+  }
+}
+
+void IOWorker::onWakeUp(int fd, int how, void *arg) {
+  IOWorker *worker = reinterpret_cast<IOWorker*>(arg);
+  char buffer[64];
+  while (read(fd, buffer, sizeof(buffer)) > 0) {
+  }
+  // nicer callbacks are one shot
+  worker->armWakeUp();
+}
+
+void IOWorker::wakeUp() {
+  if (wakeup_fds_[1] != -1 && !wakeup_pending_.exchange(true)) {
+    char signal = 1;
+    ssize_t written = write(wakeup_fds_[1], &signal, sizeof(signal));
+    (void) written;
+  }
+}
+
+int IOWorker::prepareGlibSources() {
+  int timeout_ms = -1;
+  bool ready = g_main_context_prepare(glib_context_, &glib_max_priority_);
+  int fd_count;
+  while ((fd_count = g_main_context_query(glib_context_, glib_max_priority_, &timeout_ms,
+                                          glib_fds_.data(), glib_fds_.size())) > static_cast<int>(glib_fds_.size())) {
+    glib_fds_.resize(fd_count);
+  }
+  glib_fds_.resize(fd_count);
+  for (GPollFD &poll_fd : glib_fds_) {
+    poll_fd.revents = 0;
+    if (poll_fd.events & kGlibReadEvents) {
+      NR_ASYNC_WAIT(poll_fd.fd, NR_ASYNC_WAIT_READ, &IOWorker::onGlibFdReady, this);
+    }
+    if (poll_fd.events & G_IO_OUT) {
+      NR_ASYNC_WAIT(poll_fd.fd, NR_ASYNC_WAIT_WRITE, &IOWorker::onGlibFdReady, this);
+    }
+  }
+  return ready ? 0 : timeout_ms;
+}
+
+void IOWorker::onGlibFdReady(int fd, int how, void *arg) {
+  IOWorker *worker = reinterpret_cast<IOWorker*>(arg);
+  int ready_events = how == NR_ASYNC_WAIT_READ ? kGlibReadEvents : G_IO_OUT;
+  // Several sources can poll the same fd, nicer keeps a single callback for it
+  for (GPollFD &poll_fd : worker->glib_fds_) {
+    if (poll_fd.fd == fd) {
+      poll_fd.revents |= poll_fd.events & ready_events;
+    }
+  }
+}
+
+void IOWorker::dispatchGlibSources() {
+  for (GPollFD &poll_fd : glib_fds_) {
+    if (poll_fd.events & kGlibReadEvents) {
+      NR_ASYNC_CANCEL(poll_fd.fd, NR_ASYNC_WAIT_READ);
+    }
+    if (poll_fd.events & G_IO_OUT) {
+      NR_ASYNC_CANCEL(poll_fd.fd, NR_ASYNC_WAIT_WRITE);
+    }
+  }
+  if (g_main_context_check(glib_context_, glib_max_priority_, glib_fds_.data(), glib_fds_.size())) {
+    g_main_context_dispatch(glib_context_);
+  }
+}
+
+int IOWorker::getNextTimeoutMs() {
+  int delta_ms;
+  if (NR_async_timer_next_timeout(&delta_ms) != 0) {
+    return kMaxWaitMs;
+  }
+  return std::max(delta_ms, 0);
+}
+
 void IOWorker::task(Task f) {
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    tasks_.push_back(f);
+  }
+  wakeUp();
+}
+
+void IOWorker::taskSync(Task f) {
+  if (!started_ || closed_ || std::this_thread::get_id() == thread_id_) {
+    f();
+    return;
+  }
+  auto done = std::make_shared<std::promise<void>>();
+  task([f, done] {
+    f();
+    done->set_value();
+  });
+  done->get_future().wait();
+}
+
+GMainContext* IOWorker::acquireGlibContext() {
+  glib_context_users_++;
+  // The loop only waits for libnice sources from its next iteration on
+  wakeUp();
+  return glib_context_;
+}
+
+void IOWorker::releaseGlibContext() {
+  glib_context_users_--;
+}
+
+erizo::PacketBufferPoolStats IOWorker::getPacketBufferPoolStats() {
+  return packet_buffer_pool_->getStats();
+}
+
+erizo::WorkerLoad IOWorker::getLoad() {
+  load_tracker_.update();
+  WorkerLoad load = load_tracker_.getLoad();
   std::unique_lock<std::mutex> lock(task_mutex_);
-  tasks_.push_back(f);
+  load.queue_depth = tasks_.size();
+  return load;
 }
 
 void IOWorker::close() {
   if (!closed_.exchange(true)) {
+    g_main_context_wakeup(glib_context_);
+    wakeUp();
     if (thread_ != nullptr) {
       thread_->join();
     }
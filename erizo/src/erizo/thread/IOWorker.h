@@ -8,6 +8,12 @@
 #include <thread>  // NOLINT
 #include <vector>
 
+#include "lib/PacketBufferPool.h"
+#include "thread/LoadTracker.h"
+
+typedef struct _GMainContext GMainContext;
+typedef struct _GPollFD GPollFD;
+
 namespace erizo {
 
 class IOWorker : public std::enable_shared_from_this<IOWorker> {
@@ -21,13 +27,48 @@ class IOWorker : public std::enable_shared_from_this<IOWorker> {
   virtual void close();
 
   virtual void task(Task f);
+  // Runs f in the IO thread and waits for it. f runs right away when called from the IO thread or when the
+  // worker is not running.
+  void taskSync(Task f);
+
+  // GLib context shared by every libnice connection in this worker, while there are connections using it its
+  // fds are waited for in the nicer event loop, so a single blocking wait serves both
+  GMainContext* acquireGlibContext();
+  void releaseGlibContext();
+
+  PacketBufferPoolStats getPacketBufferPoolStats();
+
+  void addPackets(uint64_t count) { load_tracker_.addPackets(count); }
+  // Busy time only accounts for queued tasks, ICE callbacks run inside the event wait
+  WorkerLoad getLoad();
+
+ private:
+  void wakeUp();
+  void armWakeUp();
+  static void onWakeUp(int fd, int how, void *arg);
+  int getNextTimeoutMs();
+  // Registers the fds GLib polls in nicer and returns the GLib timeout, -1 if it has none
+  int prepareGlibSources();
+  static void onGlibFdReady(int fd, int how, void *arg);
+  void dispatchGlibSources();
 
  private:
   std::atomic<bool> started_;
   std::atomic<bool> closed_;
+  std::shared_ptr<PacketBufferPool> packet_buffer_pool_;
   std::unique_ptr<std::thread> thread_;
+  std::thread::id thread_id_;
+  GMainContext* glib_context_;
+  std::atomic<int> glib_context_users_;
+  int glib_max_priority_;
+  std::vector<GPollFD> glib_fds_;
+  // Self-pipe registered in the nicer event loop, task() writes to it so the loop doesn't wait for its timeout
+  int wakeup_fds_[2];
+  std::atomic<bool> wakeup_pending_;
   std::vector<Task> tasks_;
   mutable std::mutex task_mutex_;
+  std::shared_ptr<Clock> clock_;
+  LoadTracker load_tracker_;
 };
 }  // namespace erizo
 
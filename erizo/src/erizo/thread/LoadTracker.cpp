@@ -0,0 +1,63 @@
+#include "thread/LoadTracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+using erizo::LoadTracker;
+using erizo::WorkerLoad;
+
+constexpr double kBusyFractionTolerance = 0.05;
+constexpr double kPacketRateTolerance = 0.1;
+constexpr double kMinPacketRateDifference = 100.;
+
+int WorkerLoad::compare(const WorkerLoad &other) const {
+  if (std::abs(busy_fraction - other.busy_fraction) > kBusyFractionTolerance) {
+    return busy_fraction < other.busy_fraction ? -1 : 1;
+  }
+  double packet_rate_difference = std::abs(packets_per_second - other.packets_per_second);
+  if (packet_rate_difference > kMinPacketRateDifference &&
+      packet_rate_difference > kPacketRateTolerance * std::max(packets_per_second, other.packets_per_second)) {
+    return packets_per_second < other.packets_per_second ? -1 : 1;
+  }
+  if (queue_depth != other.queue_depth) {
+    return queue_depth < other.queue_depth ? -1 : 1;
+  }
+  return 0;
+}
+
+LoadTracker::LoadTracker(std::shared_ptr<Clock> the_clock)
+    : clock_{the_clock}, busy_time_us_{0}, tasks_{0}, packets_{0}, window_start_{clock_->now()} {
+}
+
+void LoadTracker::addBusyTime(duration busy_time) {
+  busy_time_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(busy_time).count(),
+                          std::memory_order_relaxed);
+}
+
+void LoadTracker::addTasks(uint64_t count) {
+  tasks_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void LoadTracker::addPackets(uint64_t count) {
+  packets_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void LoadTracker::update() {
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  time_point now = clock_->now();
+  duration elapsed = now - window_start_;
+  if (elapsed < kLoadWindow) {
+    return;
+  }
+  double elapsed_s = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+  double busy_s = busy_time_us_.exchange(0, std::memory_order_relaxed) / 1000000.;
+  load_.busy_fraction = std::min(1., busy_s / elapsed_s);
+  load_.tasks_per_second = tasks_.exchange(0, std::memory_order_relaxed) / elapsed_s;
+  load_.packets_per_second = packets_.exchange(0, std::memory_order_relaxed) / elapsed_s;
+  window_start_ = now;
+}
+
+WorkerLoad LoadTracker::getLoad() const {
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  return load_;
+}
@@ -0,0 +1,51 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_LOADTRACKER_H_
+#define ERIZO_SRC_ERIZO_THREAD_LOADTRACKER_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+
+#include "lib/Clock.h"
+
+namespace erizo {
+
+constexpr duration kLoadWindow = std::chrono::seconds(1);
+
+struct WorkerLoad {
+  double tasks_per_second = 0.;
+  double packets_per_second = 0.;
+  double busy_fraction = 0.;
+  uint64_t queue_depth = 0;
+
+  // Busy time is what saturates a worker, packet rate and queue depth only break ties between workers that
+  // are similarly busy. Returns 0 when there is no meaningful difference.
+  int compare(const WorkerLoad &other) const;
+};
+
+// Turns busy time, task and packet counters into rates over kLoadWindow. Counters can be updated from any
+// thread, rates are only recomputed when update() is called after the window has elapsed.
+class LoadTracker {
+ public:
+  explicit LoadTracker(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+
+  void addBusyTime(duration busy_time);
+  void addTasks(uint64_t count);
+  void addPackets(uint64_t count);
+
+  void update();
+  WorkerLoad getLoad() const;
+
+ private:
+  std::shared_ptr<Clock> clock_;
+  std::atomic<uint64_t> busy_time_us_;
+  std::atomic<uint64_t> tasks_;
+  std::atomic<uint64_t> packets_;
+  mutable std::mutex load_mutex_;
+  time_point window_start_;
+  WorkerLoad load_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_LOADTRACKER_H_
@@ -0,0 +1,59 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
+#define ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
+
+#include <atomic>
+
+namespace erizo {
+
+// Intrusive multi producer, single consumer queue (Vyukov). Nodes must be default constructible and have a
+// std::atomic<Node*> next member. push() can be called from any thread, pop() only from the consumer.
+template <typename Node>
+class MpscQueue {
+ public:
+  MpscQueue() : head_{&stub_}, tail_{&stub_} {
+    stub_.next.store(nullptr, std::memory_order_relaxed);
+  }
+
+  void push(Node *node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Returns nullptr when the queue is empty and also while a producer is in the middle of a push
+  Node* pop() {
+    Node *tail = tail_;
+    Node *next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+ private:
+  std::atomic<Node*> head_;
+  Node *tail_;
+  Node stub_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
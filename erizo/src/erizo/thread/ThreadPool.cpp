@@ -2,15 +2,13 @@
 
 #include <memory>
 
-constexpr int kNumThreadsPerScheduler = 2;
-
 using erizo::ThreadPool;
 using erizo::Worker;
 
 ThreadPool::ThreadPool(unsigned int num_workers)
-    : workers_{}, scheduler_{std::make_shared<Scheduler>(kNumThreadsPerScheduler)} {
+    : workers_{} {
   for (unsigned int index = 0; index < num_workers; index++) {
-    workers_.push_back(std::make_shared<Worker>(scheduler_));
+    workers_.push_back(std::make_shared<Worker>());
   }
 }
 
@@ -20,14 +18,43 @@ ThreadPool::~ThreadPool() {
 
 std::shared_ptr<Worker> ThreadPool::getLessUsedWorker() {
   std::shared_ptr<Worker> chosen_worker = workers_.front();
+  erizo::WorkerLoad chosen_load = chosen_worker->getLoad();
   for (auto worker : workers_) {
-    if (chosen_worker.use_count() > worker.use_count()) {
+    erizo::WorkerLoad load = worker->getLoad();
+    int comparison = load.compare(chosen_load);
+    // References only tell apart workers with a similar load, i.e. the ones that just got new streams
+    if (comparison < 0 || (comparison == 0 && chosen_worker.use_count() > worker.use_count())) {
       chosen_worker = worker;
+      chosen_load = load;
     }
   }
   return chosen_worker;
 }
 
+std::vector<erizo::WorkerLoad> ThreadPool::getWorkerLoads() {
+  std::vector<erizo::WorkerLoad> loads;
+  for (auto worker : workers_) {
+    loads.push_back(worker->getLoad());
+  }
+  return loads;
+}
+
+std::vector<erizo::PacketBufferPoolStats> ThreadPool::getPacketBufferPoolStats() {
+  std::vector<erizo::PacketBufferPoolStats> stats;
+  for (auto worker : workers_) {
+    stats.push_back(worker->getPacketBufferPoolStats());
+  }
+  return stats;
+}
+
+std::vector<erizo::WorkerStats> ThreadPool::getWorkerStats() {
+  std::vector<erizo::WorkerStats> stats;
+  for (auto worker : workers_) {
+    stats.push_back(worker->getStats());
+  }
+  return stats;
+}
+
 void ThreadPool::start() {
   std::vector<std::shared_ptr<std::promise<void>>> promises(workers_.size());
   int index = 0;
@@ -44,5 +71,4 @@ void ThreadPool::close() {
   for (auto worker : workers_) {
     worker->close();
   }
-  scheduler_->stop(true);
 }
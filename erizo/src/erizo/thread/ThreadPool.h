@@ -5,7 +5,6 @@
 #include <vector>
 
 #include "thread/Worker.h"
-#include "thread/Scheduler.h"
 
 namespace erizo {
 
@@ -15,12 +14,14 @@ class ThreadPool {
   ~ThreadPool();
 
   std::shared_ptr<Worker> getLessUsedWorker();
+  std::vector<PacketBufferPoolStats> getPacketBufferPoolStats();
+  std::vector<WorkerStats> getWorkerStats();
+  std::vector<WorkerLoad> getWorkerLoads();
   void start();
   void close();
 
  private:
   std::vector<std::shared_ptr<Worker>> workers_;
-  std::shared_ptr<Scheduler> scheduler_;
 };
 }  // namespace erizo
 
@@ -0,0 +1,199 @@
+#include "thread/TimerWheel.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using erizo::TimerWheel;
+using erizo::TimerWheelStats;
+
+static constexpr uint64_t kSlotMask = TimerWheel::kSlots - 1;
+
+static uint64_t levelSpan(int level) {
+  return uint64_t(1) << (TimerWheel::kSlotBits * level);
+}
+
+TimerWheel::TimerWheel(time_point start)
+    : start_{start}, current_tick_{0}, running_{false}, size_{0}, level_sizes_{}, slots_{} {
+}
+
+TimerWheel::~TimerWheel() {
+  for (auto &level : slots_) {
+    for (Slot &slot : level) {
+      deleteTimers(&slot);
+    }
+  }
+}
+
+void TimerWheel::deleteTimers(Slot *slot) {
+  Timer *timer = slot->head;
+  while (timer != nullptr) {
+    Timer *next = timer->next;
+    delete timer;
+    timer = next;
+  }
+  slot->head = slot->tail = nullptr;
+}
+
+uint64_t TimerWheel::toDeadlineTick(time_point deadline) const {
+  if (deadline <= start_) {
+    return 0;
+  }
+  duration elapsed = deadline - start_;
+  auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+  // Timers never run before their deadline
+  return elapsed_ms.count() + (elapsed_ms < elapsed ? 1 : 0);
+}
+
+erizo::time_point TimerWheel::toTime(uint64_t tick) const {
+  return start_ + std::chrono::milliseconds(tick);
+}
+
+TimerWheel::Timer* TimerWheel::schedule(Task f, time_point deadline) {
+  Timer *timer = new Timer();
+  timer->f = std::move(f);
+  timer->deadline = deadline;
+  // Timers added while running the current tick wait for the next one, so they can't starve advance()
+  timer->expiry = std::max(toDeadlineTick(deadline), running_ ? current_tick_ + 1 : current_tick_);
+  insert(timer);
+  size_++;
+  return timer;
+}
+
+void TimerWheel::cancel(Timer *timer) {
+  unlink(timer);
+  size_--;
+  stats_.cancelled_timers++;
+  delete timer;
+}
+
+void TimerWheel::insert(Timer *timer) {
+  uint64_t delta = timer->expiry - current_tick_;
+  int level = 0;
+  while (level < kLevels - 1 && delta >= levelSpan(level + 1)) {
+    level++;
+  }
+  uint64_t slot_tick = timer->expiry;
+  if (delta >= levelSpan(kLevels)) {
+    // Out of range, it will be placed again with its real expiry when the last slot is cascaded
+    slot_tick = current_tick_ + levelSpan(kLevels) - 1;
+  }
+  Slot *slot = &slots_[level][(slot_tick >> (kSlotBits * level)) & kSlotMask];
+  timer->level = level;
+  timer->slot = slot;
+  timer->next = nullptr;
+  timer->prev = slot->tail;
+  if (slot->tail != nullptr) {
+    slot->tail->next = timer;
+  } else {
+    slot->head = timer;
+  }
+  slot->tail = timer;
+  level_sizes_[level]++;
+}
+
+void TimerWheel::unlink(Timer *timer) {
+  Slot *slot = timer->slot;
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    slot->head = timer->next;
+  }
+  if (timer->next != nullptr) {
+    timer->next->prev = timer->prev;
+  } else {
+    slot->tail = timer->prev;
+  }
+  timer->prev = timer->next = nullptr;
+  timer->slot = nullptr;
+  level_sizes_[timer->level]--;
+}
+
+void TimerWheel::cascade(int level) {
+  Slot &slot = slots_[level][(current_tick_ >> (kSlotBits * level)) & kSlotMask];
+  Timer *timer = slot.head;
+  slot.head = slot.tail = nullptr;
+  while (timer != nullptr) {
+    Timer *next = timer->next;
+    level_sizes_[level]--;
+    insert(timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::runSlot(uint64_t tick, time_point now) {
+  Slot &slot = slots_[0][tick & kSlotMask];
+  while (slot.head != nullptr) {
+    Timer *timer = slot.head;
+    unlink(timer);
+    size_--;
+    uint64_t lateness_us = now > timer->deadline ?
+      std::chrono::duration_cast<std::chrono::microseconds>(now - timer->deadline).count() : 0;
+    stats_.fired_timers++;
+    stats_.total_lateness_us += lateness_us;
+    stats_.max_lateness_us = std::max(stats_.max_lateness_us, lateness_us);
+    Task f = std::move(timer->f);
+    delete timer;
+    f();
+  }
+}
+
+void TimerWheel::advance(time_point now) {
+  if (running_ || now < start_) {
+    return;
+  }
+  uint64_t now_tick = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_).count();
+  running_ = true;
+  while (current_tick_ <= now_tick) {
+    if (size_ == 0) {
+      current_tick_ = now_tick + 1;
+      break;
+    }
+    for (int level = 1; level < kLevels && (current_tick_ & (levelSpan(level) - 1)) == 0; level++) {
+      cascade(level);
+    }
+    runSlot(current_tick_, now);
+    current_tick_++;
+    // Jump over ticks with nothing to run or cascade
+    uint64_t step = 1;
+    for (int level = 0; level < kLevels - 1 && level_sizes_[level] == 0; level++) {
+      step = levelSpan(level + 1);
+    }
+    if (step > 1) {
+      uint64_t next_tick = (current_tick_ + step - 1) & ~(step - 1);
+      current_tick_ = std::min(next_tick, now_tick + 1);
+    }
+  }
+  running_ = false;
+}
+
+erizo::time_point TimerWheel::getNextWakeUp() const {
+  if (size_ == 0) {
+    return time_point::max();
+  }
+  uint64_t next_tick = std::numeric_limits<uint64_t>::max();
+  for (int level = 0; level < kLevels; level++) {
+    if (level_sizes_[level] == 0) {
+      continue;
+    }
+    // Level 0 slots run at their tick, upper levels are cascaded when the lower level wraps
+    int shift = kSlotBits * level;
+    for (uint64_t index = 0; index <= kSlots; index++) {
+      uint64_t tick = ((current_tick_ >> shift) + index) << shift;
+      if (tick < current_tick_) {
+        continue;
+      }
+      if (slots_[level][(tick >> shift) & kSlotMask].head != nullptr) {
+        next_tick = std::min(next_tick, tick);
+        break;
+      }
+    }
+  }
+  return next_tick == std::numeric_limits<uint64_t>::max() ? time_point::max() : toTime(next_tick);
+}
+
+TimerWheelStats TimerWheel::getStats() const {
+  TimerWheelStats stats = stats_;
+  stats.pending_timers = size_;
+  return stats;
+}
@@ -0,0 +1,91 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
+#define ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include "lib/Clock.h"
+
+namespace erizo {
+
+struct TimerWheelStats {
+  uint64_t pending_timers = 0;
+  uint64_t fired_timers = 0;
+  uint64_t cancelled_timers = 0;
+  uint64_t max_lateness_us = 0;
+  uint64_t total_lateness_us = 0;
+
+  double getAverageLatenessUs() const {
+    return fired_timers == 0 ? 0. : static_cast<double>(total_lateness_us) / fired_timers;
+  }
+};
+
+// Hierarchical timer wheel (4 levels of 64 slots, 1ms ticks) with O(1) schedule and cancel.
+// It is not thread safe, the owner drives it by calling advance() from a single thread.
+class TimerWheel {
+ private:
+  struct Slot;
+
+ public:
+  typedef std::function<void()> Task;
+
+  class Timer {
+   private:
+    friend class TimerWheel;
+    Task f;
+    time_point deadline;
+    uint64_t expiry = 0;
+    int level = 0;
+    Slot *slot = nullptr;
+    Timer *prev = nullptr;
+    Timer *next = nullptr;
+  };
+
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+
+  explicit TimerWheel(time_point start);
+  ~TimerWheel();
+
+  // The returned timer is owned by the wheel, it is valid until it runs or it is cancelled
+  Timer* schedule(Task f, time_point deadline);
+  void cancel(Timer *timer);
+
+  // Runs every timer whose deadline is not after now
+  void advance(time_point now);
+
+  // Earliest time advance() needs to be called, it can be a cascade point with nothing to run yet
+  time_point getNextWakeUp() const;
+
+  bool empty() const { return size_ == 0; }
+  TimerWheelStats getStats() const;
+
+ private:
+  struct Slot {
+    Timer *head = nullptr;
+    Timer *tail = nullptr;
+  };
+
+  uint64_t toDeadlineTick(time_point deadline) const;
+  time_point toTime(uint64_t tick) const;
+  void insert(Timer *timer);
+  void unlink(Timer *timer);
+  void cascade(int level);
+  void runSlot(uint64_t tick, time_point now);
+  void deleteTimers(Slot *slot);
+
+ private:
+  time_point start_;
+  uint64_t current_tick_;
+  bool running_;
+  uint64_t size_;
+  std::array<uint64_t, kLevels> level_sizes_;
+  std::array<std::array<Slot, kSlots>, kLevels> slots_;
+  TimerWheelStats stats_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
@@ -5,14 +5,17 @@
 
 #include <algorithm>
 #include <memory>
+#include <thread>  // NOLINT
 
 #include "lib/ClockUtils.h"
 
 using erizo::Worker;
 using erizo::SimulatedWorker;
 using erizo::ScheduledTaskReference;
+using erizo::PacketBufferPool;
+using erizo::WorkerStats;
 
-ScheduledTaskReference::ScheduledTaskReference() : cancelled{false} {
+ScheduledTaskReference::ScheduledTaskReference() : cancelled{false}, timer_{nullptr} {
 }
 
 bool ScheduledTaskReference::isCancelled() {
@@ -22,19 +25,80 @@ void ScheduledTaskReference::cancel() {
   cancelled = true;
 }
 
-Worker::Worker(std::weak_ptr<Scheduler> scheduler, std::shared_ptr<Clock> the_clock)
-    : scheduler_{scheduler},
+void ScheduledTaskReference::setWorker(std::shared_ptr<Worker> worker) {
+  std::unique_lock<std::mutex> lock(worker_mutex_);
+  worker_ = worker;
+}
+
+std::shared_ptr<Worker> ScheduledTaskReference::getWorker() {
+  std::unique_lock<std::mutex> lock(worker_mutex_);
+  return worker_.lock();
+}
+
+Worker::Worker(std::shared_ptr<Clock> the_clock)
+    : timers_{the_clock->now()},
       clock_{the_clock},
+      packet_buffer_pool_{std::make_shared<PacketBufferPool>()},
       service_{},
       service_worker_{new asio_worker::element_type(service_)},
-      closed_{false} {
+      timer_{service_},
+      armed_wake_up_{time_point::max()},
+      closed_{false},
+      queued_tasks_{0},
+      max_queue_depth_{0},
+      executed_tasks_{0},
+      max_task_latency_us_{0},
+      total_task_latency_us_{0},
+      load_tracker_{the_clock} {
 }
 
 Worker::~Worker() {
+  while (TaskNode *node = tasks_.pop()) {
+    delete node;
+  }
 }
 
 void Worker::task(Task f) {
-  service_.post(f);
+  TaskNode *node = new TaskNode();
+  node->f = std::move(f);
+  node->enqueued_at = clock_->now();
+  tasks_.push(node);
+  uint64_t depth = queued_tasks_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  uint64_t max_depth = max_queue_depth_.load(std::memory_order_relaxed);
+  while (depth > max_depth && !max_queue_depth_.compare_exchange_weak(max_depth, depth)) {}
+  if (depth == 1) {
+    service_.post([this] { runQueuedTasks(); });
+  }
+}
+
+void Worker::runQueuedTasks() {
+  time_point start = clock_->now();
+  uint64_t pending = queued_tasks_.load(std::memory_order_acquire);
+  uint64_t executed = 0;
+  while (executed < pending) {
+    TaskNode *node = tasks_.pop();
+    if (node == nullptr) {
+      // A producer has not finished linking its node yet
+      std::this_thread::yield();
+      continue;
+    }
+    uint64_t latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      clock_->now() - node->enqueued_at).count();
+    total_task_latency_us_.fetch_add(latency_us, std::memory_order_relaxed);
+    if (latency_us > max_task_latency_us_.load(std::memory_order_relaxed)) {
+      max_task_latency_us_.store(latency_us, std::memory_order_relaxed);
+    }
+    executed_tasks_.fetch_add(1, std::memory_order_relaxed);
+    node->f();
+    delete node;
+    executed++;
+  }
+  load_tracker_.addTasks(executed);
+  load_tracker_.addBusyTime(clock_->now() - start);
+  // Tasks queued while we were running them will be executed in the next handler
+  if (queued_tasks_.fetch_sub(executed, std::memory_order_acq_rel) != executed) {
+    service_.post([this] { runQueuedTasks(); });
+  }
 }
 
 void Worker::start() {
@@ -45,6 +109,8 @@ void Worker::start() {
 void Worker::start(std::shared_ptr<std::promise<void>> start_promise) {
   auto this_ptr = shared_from_this();
   auto worker = [this_ptr, start_promise] {
+    PacketBufferPool::setCurrent(this_ptr->packet_buffer_pool_);
+    this_ptr->thread_id_ = std::this_thread::get_id();
     start_promise->set_value();
     if (!this_ptr->closed_) {
       return this_ptr->service_.run();
@@ -56,29 +122,94 @@ void Worker::start(std::shared_ptr<std::promise<void>> start_promise) {
 
 void Worker::close() {
   closed_ = true;
+  // A pending wait would keep io_service running until the next timer
+  service_.post([this] {
+    boost::system::error_code error;
+    timer_.cancel(error);
+  });
   service_worker_.reset();
   group_.join_all();
   service_.stop();
 }
 
 std::shared_ptr<ScheduledTaskReference> Worker::scheduleFromNow(Task f, duration delta) {
-  auto delta_ms = std::chrono::duration_cast<std::chrono::milliseconds>(delta);
   auto id = std::make_shared<ScheduledTaskReference>();
-  if (auto scheduler = scheduler_.lock()) {
-    scheduler->scheduleFromNow(safeTask([f, id](std::shared_ptr<Worker> this_ptr) {
-      this_ptr->task(this_ptr->safeTask([f, id](std::shared_ptr<Worker> this_ptr) {
-        {
-          if (id->isCancelled()) {
-            return;
-          }
-        }
-        f();
-      }));
-    }), delta_ms);
-  }
+  scheduleFromNow(f, delta, id);
   return id;
 }
 
+void Worker::scheduleFromNow(Task f, duration delta, std::shared_ptr<ScheduledTaskReference> id) {
+  time_point deadline = clock_->now() + delta;
+  id->setWorker(shared_from_this());
+  runInWorkerThread(safeTask([f, deadline, id](std::shared_ptr<Worker> this_ptr) {
+    this_ptr->addTimer(f, deadline, id);
+    this_ptr->armTimer();
+  }));
+}
+
+void Worker::runInWorkerThread(Task f) {
+  if (std::this_thread::get_id() == thread_id_) {
+    f();
+  } else {
+    task(f);
+  }
+}
+
+void Worker::addTimer(Task f, time_point deadline, std::shared_ptr<ScheduledTaskReference> id) {
+  if (id->isCancelled()) {
+    return;
+  }
+  id->timer_ = timers_.schedule([f, id] {
+    id->timer_ = nullptr;
+    if (!id->isCancelled()) {
+      f();
+    }
+  }, deadline);
+  publishTimerStats();
+}
+
+void Worker::removeTimer(std::shared_ptr<ScheduledTaskReference> id) {
+  if (id->timer_ != nullptr) {
+    timers_.cancel(id->timer_);
+    id->timer_ = nullptr;
+    publishTimerStats();
+  }
+}
+
+void Worker::armTimer() {
+  // Simulated workers have no thread, their timers run in executePastScheduledTasks()
+  if (closed_ || timers_.empty() || thread_id_ == std::thread::id()) {
+    return;
+  }
+  time_point wake_up = timers_.getNextWakeUp();
+  if (wake_up >= armed_wake_up_) {
+    return;
+  }
+  armed_wake_up_ = wake_up;
+  timer_.expires_at(wake_up);
+  std::weak_ptr<Worker> weak_this = shared_from_this();
+  timer_.async_wait([weak_this](const boost::system::error_code &error) {
+    if (error == boost::asio::error::operation_aborted) {
+      return;
+    }
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->onTimer();
+    }
+  });
+}
+
+void Worker::onTimer() {
+  armed_wake_up_ = time_point::max();
+  timers_.advance(clock_->now());
+  publishTimerStats();
+  armTimer();
+}
+
+void Worker::publishTimerStats() {
+  std::unique_lock<std::mutex> lock(timer_stats_mutex_);
+  timer_stats_ = timers_.getStats();
+}
+
 void Worker::scheduleEvery(ScheduledTask f, duration period) {
   scheduleEvery(f, period, period);
 }
@@ -96,8 +227,45 @@ void Worker::scheduleEvery(ScheduledTask f, duration period, duration next_delay
   }), std::max(next_delay, duration{0}));
 }
 
+erizo::PacketBufferPoolStats Worker::getPacketBufferPoolStats() {
+  return packet_buffer_pool_->getStats();
+}
+
+void Worker::handOverTo(std::shared_ptr<Worker> new_worker, Task f) {
+  task([new_worker, f] {
+    new_worker->task(f);
+  });
+}
+
+erizo::WorkerLoad Worker::getLoad() {
+  load_tracker_.update();
+  WorkerLoad load = load_tracker_.getLoad();
+  load.queue_depth = queued_tasks_.load(std::memory_order_relaxed);
+  return load;
+}
+
+WorkerStats Worker::getStats() {
+  WorkerStats stats;
+  stats.queue_depth = queued_tasks_.load(std::memory_order_relaxed);
+  stats.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+  stats.executed_tasks = executed_tasks_.load(std::memory_order_relaxed);
+  stats.max_task_latency_us = max_task_latency_us_.load(std::memory_order_relaxed);
+  stats.total_task_latency_us = total_task_latency_us_.load(std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lock(timer_stats_mutex_);
+  stats.pending_timers = timer_stats_.pending_timers;
+  stats.fired_timers = timer_stats_.fired_timers;
+  stats.max_timer_lateness_us = timer_stats_.max_lateness_us;
+  stats.total_timer_lateness_us = timer_stats_.total_lateness_us;
+  return stats;
+}
+
 void Worker::unschedule(std::shared_ptr<ScheduledTaskReference> id) {
   id->cancel();
+  if (auto owner = id->getWorker()) {
+    owner->runInWorkerThread([owner, id] {
+      owner->removeTimer(id);
+    });
+  }
 }
 
 std::function<void()> Worker::safeTask(std::function<void(std::shared_ptr<Worker>)> f) {
@@ -110,7 +278,7 @@ std::function<void()> Worker::safeTask(std::function<void(std::shared_ptr<Worker
 }
 
 SimulatedWorker::SimulatedWorker(std::shared_ptr<SimulatedClock> the_clock)
-    : Worker(std::make_shared<Scheduler>(1), the_clock), clock_{the_clock} {
+    : Worker(the_clock), clock_{the_clock}, closed_{false} {
 }
 
 void SimulatedWorker::task(Task f) {
@@ -124,19 +292,12 @@ void SimulatedWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
 }
 
 void SimulatedWorker::close() {
-  scheduled_tasks_.clear();
+  closed_ = true;
   tasks_.clear();
 }
 
-std::shared_ptr<ScheduledTaskReference> SimulatedWorker::scheduleFromNow(Task f, duration delta) {
-  auto id = std::make_shared<ScheduledTaskReference>();
-  scheduled_tasks_[clock_->now() + delta] =  [f, id] {
-      if (id->isCancelled()) {
-        return;
-      }
-      f();
-    };
-  return id;
+void SimulatedWorker::runInWorkerThread(Task f) {
+  f();
 }
 
 void SimulatedWorker::executeTasks() {
@@ -147,13 +308,8 @@ void SimulatedWorker::executeTasks() {
 }
 
 void SimulatedWorker::executePastScheduledTasks() {
-  time_point now = clock_->now();
-  for (auto iter = scheduled_tasks_.begin(), last_iter = scheduled_tasks_.end(); iter != last_iter; ) {
-    if (iter->first <= now) {
-      iter->second();
-      iter = scheduled_tasks_.erase(iter);
-    } else {
-      ++iter;
-    }
+  if (closed_) {
+    return;
   }
+  timers_.advance(clock_->now());
 }
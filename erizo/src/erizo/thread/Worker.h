@@ -2,6 +2,7 @@
 #define ERIZO_SRC_ERIZO_THREAD_WORKER_H_
 
 #include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/thread.hpp>
 
 #include <algorithm>
@@ -9,21 +10,57 @@
 #include <map>
 #include <memory>
 #include <future>  // NOLINT
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "lib/Clock.h"
+#include "lib/PacketBufferPool.h"
 
-#include "thread/Scheduler.h"
+#include "thread/LoadTracker.h"
+#include "thread/MpscQueue.h"
+#include "thread/TimerWheel.h"
 
 namespace erizo {
 
+class Worker;
+
 class ScheduledTaskReference {
  public:
   ScheduledTaskReference();
   bool isCancelled();
   void cancel();
  private:
+  friend class Worker;
+  void setWorker(std::shared_ptr<Worker> worker);
+  std::shared_ptr<Worker> getWorker();
+
   std::atomic<bool> cancelled;
+  // Set when the task is (re)scheduled and read when it is unscheduled, from any thread
+  std::mutex worker_mutex_;
+  std::weak_ptr<Worker> worker_;
+  // Only accessed from the thread of the worker whose timer wheel holds the task
+  TimerWheel::Timer *timer_;
+};
+
+struct WorkerStats {
+  uint64_t queue_depth = 0;
+  uint64_t max_queue_depth = 0;
+  uint64_t executed_tasks = 0;
+  uint64_t max_task_latency_us = 0;
+  uint64_t total_task_latency_us = 0;
+  uint64_t pending_timers = 0;
+  uint64_t fired_timers = 0;
+  uint64_t max_timer_lateness_us = 0;
+  uint64_t total_timer_lateness_us = 0;
+
+  double getAverageTaskLatencyUs() const {
+    return executed_tasks == 0 ? 0. : static_cast<double>(total_task_latency_us) / executed_tasks;
+  }
+
+  double getAverageTimerLatenessUs() const {
+    return fired_timers == 0 ? 0. : static_cast<double>(total_timer_lateness_us) / fired_timers;
+  }
 };
 
 class Worker : public std::enable_shared_from_this<Worker> {
@@ -32,35 +69,87 @@ class Worker : public std::enable_shared_from_this<Worker> {
   typedef std::function<void()> Task;
   typedef std::function<bool()> ScheduledTask;
 
-  explicit Worker(std::weak_ptr<Scheduler> scheduler,
-                  std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+  explicit Worker(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
   virtual ~Worker();
 
   virtual void task(Task f);
 
+  // Runs f for every item, in order, within a single task
+  template <typename T>
+  void taskBatch(std::vector<T> items, std::function<void(T&)> f) {
+    auto batch = std::make_shared<std::vector<T>>(std::move(items));
+    task([batch, f] {
+      for (T &item : *batch) {
+        f(item);
+      }
+    });
+  }
+
   virtual void start();
   virtual void start(std::shared_ptr<std::promise<void>> start_promise);
   virtual void close();
 
-  virtual std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta);
+  std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta);
+  // Schedules f under an existing reference, unschedule(id) cancels it even if it is called on another worker
+  void scheduleFromNow(Task f, duration delta, std::shared_ptr<ScheduledTaskReference> id);
+  // The task is released right away, there is no need to wait until its deadline
   virtual void unschedule(std::shared_ptr<ScheduledTaskReference> id);
 
   virtual void scheduleEvery(ScheduledTask f, duration period);
 
+  // Queues f in new_worker once every task already queued in this worker has run, neither of them waits
+  void handOverTo(std::shared_ptr<Worker> new_worker, Task f);
+
+  PacketBufferPoolStats getPacketBufferPoolStats();
+  WorkerStats getStats();
+
+  void addPackets(uint64_t count) { load_tracker_.addPackets(count); }
+  // Rates cover the time since the previous window was closed, with a minimum of kLoadWindow
+  WorkerLoad getLoad();
+
  private:
+  struct TaskNode {
+    std::atomic<TaskNode*> next;
+    Task f;
+    time_point enqueued_at;
+  };
+
   void scheduleEvery(ScheduledTask f, duration period, duration next_delay);
   std::function<void()> safeTask(std::function<void(std::shared_ptr<Worker>)> f);
+  void runQueuedTasks();
+  void addTimer(Task f, time_point deadline, std::shared_ptr<ScheduledTaskReference> id);
+  void removeTimer(std::shared_ptr<ScheduledTaskReference> id);
+  void armTimer();
+  void onTimer();
+  void publishTimerStats();
 
  protected:
+  // Runs f now when called from this worker's thread, otherwise it is queued
+  virtual void runInWorkerThread(Task f);
+
   int next_scheduled_ = 0;
+  TimerWheel timers_;
 
  private:
-  std::weak_ptr<Scheduler> scheduler_;
   std::shared_ptr<Clock> clock_;
+  std::shared_ptr<PacketBufferPool> packet_buffer_pool_;
   boost::asio::io_service service_;
   asio_worker service_worker_;
+  boost::asio::steady_timer timer_;
+  time_point armed_wake_up_;
   boost::thread_group group_;
+  std::thread::id thread_id_;
   std::atomic<bool> closed_;
+  // Tasks are queued here and io_service only gets a handler when the queue goes from empty to non empty
+  MpscQueue<TaskNode> tasks_;
+  std::atomic<uint64_t> queued_tasks_;
+  std::atomic<uint64_t> max_queue_depth_;
+  std::atomic<uint64_t> executed_tasks_;
+  std::atomic<uint64_t> max_task_latency_us_;
+  std::atomic<uint64_t> total_task_latency_us_;
+  LoadTracker load_tracker_;
+  std::mutex timer_stats_mutex_;
+  TimerWheelStats timer_stats_;
 };
 
 class SimulatedWorker : public Worker {
@@ -70,15 +159,17 @@ class SimulatedWorker : public Worker {
   void start() override;
   void start(std::shared_ptr<std::promise<void>> start_promise) override;
   void close() override;
-  std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta) override;
 
   void executeTasks();
   void executePastScheduledTasks();
 
+ protected:
+  void runInWorkerThread(Task f) override;
+
  private:
   std::shared_ptr<SimulatedClock> clock_;
   std::vector<Task> tasks_;
-  std::map<time_point, Task> scheduled_tasks_;
+  bool closed_;
 };
 }  // namespace erizo
 
@@ -0,0 +1,68 @@
+#include "thread/WorkerReference.h"
+
+#include <utility>
+
+namespace erizo {
+
+WorkerReference::WorkerReference(std::shared_ptr<Worker> worker) : worker_{std::move(worker)}, holding_{false} {
+}
+
+std::shared_ptr<Worker> WorkerReference::get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return worker_;
+}
+
+void WorkerReference::task(Worker::Task f) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (holding_) {
+    held_tasks_.push_back(std::move(f));
+    return;
+  }
+  worker_->task(std::move(f));
+}
+
+void WorkerReference::runOrTask(Worker *worker, Worker::Task f) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (holding_) {
+    held_tasks_.push_back(std::move(f));
+    return;
+  }
+  if (worker_.get() != worker) {
+    worker_->task(std::move(f));
+    return;
+  }
+  lock.unlock();
+  // A move started meanwhile hands over from this worker, so it waits for f anyway
+  f();
+}
+
+void WorkerReference::moveTo(std::shared_ptr<Worker> new_worker) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (new_worker == worker_) {
+    return;
+  }
+  std::shared_ptr<Worker> old_worker = worker_;
+  worker_ = new_worker;
+  if (holding_) {
+    // Nothing was queued in the intermediate worker, the pending hand over releases the tasks to the last one
+    return;
+  }
+  holding_ = true;
+  std::weak_ptr<WorkerReference> weak_this = shared_from_this();
+  old_worker->handOverTo(new_worker, [weak_this] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->releaseHeldTasks();
+    }
+  });
+}
+
+void WorkerReference::releaseHeldTasks() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Worker::Task &f : held_tasks_) {
+    worker_->task(std::move(f));
+  }
+  held_tasks_.clear();
+  holding_ = false;
+}
+
+}  // namespace erizo
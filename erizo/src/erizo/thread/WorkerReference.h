@@ -0,0 +1,40 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_WORKERREFERENCE_H_
+#define ERIZO_SRC_ERIZO_THREAD_WORKERREFERENCE_H_
+
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "thread/Worker.h"
+
+namespace erizo {
+
+/**
+ * The worker an object runs its tasks in, which can be changed while the object is running. Tasks keep their
+ * order without blocking any worker: while the old worker still has tasks of the object queued, new ones are
+ * held here and queued in the new worker once the old one has run them.
+ */
+class WorkerReference : public std::enable_shared_from_this<WorkerReference> {
+ public:
+  explicit WorkerReference(std::shared_ptr<Worker> worker);
+
+  // The worker new tasks will run in
+  std::shared_ptr<Worker> get();
+  void task(Worker::Task f);
+  // For tasks already running in worker: runs f right away if nothing would run before it, otherwise queues it
+  void runOrTask(Worker *worker, Worker::Task f);
+  void moveTo(std::shared_ptr<Worker> new_worker);
+
+ private:
+  void releaseHeldTasks();
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<Worker> worker_;
+  bool holding_;
+  std::vector<Worker::Task> held_tasks_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_WORKERREFERENCE_H_
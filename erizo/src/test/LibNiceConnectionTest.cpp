@@ -64,6 +64,7 @@ class MockLibNiceConnectionListener: public erizo::IceConnectionListener {
 class LibNiceConnectionStartTest : public ::testing::Test {
  protected:
   virtual void SetUp() {
+    io_worker = std::make_shared<erizo::IOWorker>();
     libnice = new MockLibNice;
     libnice_pointer.reset(libnice);
     nice_listener = std::make_shared<MockLibNiceConnectionListener>();
@@ -73,6 +74,7 @@ class LibNiceConnectionStartTest : public ::testing::Test {
     delete ice_config;
   }
 
+  std::shared_ptr<erizo::IOWorker> io_worker;
   boost::shared_ptr<erizo::LibNiceInterface> libnice_pointer;
   MockLibNice* libnice;
   std::shared_ptr<MockLibNiceConnectionListener> nice_listener;
@@ -88,6 +90,7 @@ class LibNiceConnectionTest : public ::testing::Test {
     const std::string kArbitraryTransportName = "video";
     const std::string kArbitraryDataPacket = "test";
 
+    io_worker = std::make_shared<erizo::IOWorker>();
     libnice = new MockLibNice;
     libnice_pointer.reset(libnice);
     nice_listener = std::make_shared<MockLibNiceConnectionListener>();
@@ -111,7 +114,7 @@ class LibNiceConnectionTest : public ::testing::Test {
     EXPECT_CALL(*libnice, NiceAgentSetPortRange(_, _, _, _, _)).Times(0);
     EXPECT_CALL(*libnice, NiceAgentSetRelayInfo(_, _, _, _, _, _, _)).Times(0);
 
-    nice_connection = new erizo::LibNiceConnection(libnice_pointer,
+    nice_connection = new erizo::LibNiceConnection(io_worker, libnice_pointer,
         *ice_config);
     nice_connection->setIceListener(nice_listener);
     nice_connection->start();
@@ -123,6 +126,7 @@ class LibNiceConnectionTest : public ::testing::Test {
     free(test_packet);
   }
 
+  std::shared_ptr<erizo::IOWorker> io_worker;
   boost::shared_ptr<erizo::LibNiceInterface> libnice_pointer;
   MockLibNice* libnice;
   std::shared_ptr<MockLibNiceConnectionListener> nice_listener;
@@ -139,6 +143,7 @@ class LibNiceConnectionTwoComponentsTest : public ::testing::Test {
     const std::string kArbitraryConnectionId = "a_connection_id";
     const std::string kArbitraryTransportName = "video";
 
+    io_worker = std::make_shared<erizo::IOWorker>();
     libnice = new MockLibNice;
     libnice_pointer.reset(libnice);
     nice_listener = std::make_shared<MockLibNiceConnectionListener>();
@@ -160,7 +165,7 @@ class LibNiceConnectionTwoComponentsTest : public ::testing::Test {
     EXPECT_CALL(*libnice, NiceAgentSetPortRange(_, _, _, _, _)).Times(0);
     EXPECT_CALL(*libnice, NiceAgentSetRelayInfo(_, _, _, _, _, _, _)).Times(0);
 
-    nice_connection = new erizo::LibNiceConnection(libnice_pointer,
+    nice_connection = new erizo::LibNiceConnection(io_worker, libnice_pointer,
         *ice_config);
     nice_connection->setIceListener(nice_listener);
     nice_connection->start();
@@ -171,6 +176,7 @@ class LibNiceConnectionTwoComponentsTest : public ::testing::Test {
     delete ice_config;
   }
 
+  std::shared_ptr<erizo::IOWorker> io_worker;
   boost::shared_ptr<erizo::LibNiceInterface> libnice_pointer;
   MockLibNice* libnice;
   std::shared_ptr<MockLibNiceConnectionListener> nice_listener;
@@ -2,17 +2,25 @@
 #include <gtest/gtest.h>
 
 #include <rtp/RtpHeaders.h>
+#include <rtp/RtpUtils.h>
 #include <MediaDefinitions.h>
 #include <OneToManyProcessor.h>
+#include <chrono>  // NOLINT
+#include <iostream>
 #include <string>
+#include <vector>
 
 using testing::_;
 using testing::Return;
 using testing::Eq;
+using testing::Ne;
+using testing::SaveArg;
+using testing::DoAll;
 using erizo::DataPacket;
 using erizo::MediaEventPtr;
 
 static const char kArbitraryPeerId[] = "111";
+static const char kArbitraryPeerId2[] = "222";
 
 class MockPublisher: public erizo::MediaSource, public erizo::FeedbackSink {
  public:
@@ -106,6 +114,41 @@ TEST_F(OneToManyProcessorTest, deliverFeedback_CallsPublisher_WhenCalled) {
                       sizeof(erizo::RtpHeader), erizo::VIDEO_PACKET));
 }
 
+TEST_F(OneToManyProcessorTest, deliverFeedback_TranslatesSourceSSRC_WhenItIsFromAnAudioSubscriber) {
+  subscriber->setAudioSinkSSRC(3000);
+  otm.addSubscriber(subscriber, kArbitraryPeerId);
+  std::shared_ptr<DataPacket> feedback;
+
+  EXPECT_CALL(*publisher.get(), internalDeliverFeedback_(_)).WillOnce(DoAll(SaveArg<0>(&feedback), Return(0)));
+  otm.deliverFeedback(erizo::RtpUtils::createPLI(3000, 3000));
+
+  EXPECT_THAT(reinterpret_cast<erizo::RtcpHeader*>(feedback->data)->getSourceSSRC(),
+              Eq(publisher->getAudioSourceSSRC()));
+}
+
+TEST_F(OneToManyProcessorTest, deliverFeedback_TranslatesSourceSSRC_WhenItIsFromAVideoSubscriber) {
+  subscriber->setAudioSinkSSRC(3000);
+  otm.addSubscriber(subscriber, kArbitraryPeerId);
+  std::shared_ptr<DataPacket> feedback;
+
+  EXPECT_CALL(*publisher.get(), internalDeliverFeedback_(_)).WillOnce(DoAll(SaveArg<0>(&feedback), Return(0)));
+  otm.deliverFeedback(erizo::RtpUtils::createPLI(4000, 3000));
+
+  EXPECT_THAT(reinterpret_cast<erizo::RtcpHeader*>(feedback->data)->getSourceSSRC(),
+              Eq(publisher->getVideoSourceSSRC()));
+}
+
+TEST_F(OneToManyProcessorTest, deliverVideoData_DoesNotCallSubscriber_WhenItHasBeenRemoved) {
+  erizo::RtpHeader header;
+  header.setSeqNumber(12);
+
+  otm.removeSubscriber(kArbitraryPeerId);
+
+  EXPECT_CALL(*subscriber, internalDeliverVideoData_(_)).Times(0);
+  otm.deliverVideoData(std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
+                       sizeof(erizo::RtpHeader), erizo::VIDEO_PACKET));
+}
+
 TEST_F(OneToManyProcessorTest, deliverVideoData_CallsSubscriber_whenCalled) {
   erizo::RtpHeader header;
   header.setSeqNumber(12);
@@ -123,3 +166,117 @@ TEST_F(OneToManyProcessorTest, deliverAudioData_CallsSubscriber_whenCalled) {
   otm.deliverAudioData(std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
                        sizeof(erizo::RtpHeader), erizo::AUDIO_PACKET));
 }
+
+TEST_F(OneToManyProcessorTest, deliverVideoData_RewritesSSRCPerSubscriber_WithoutModifyingPublisherPacket) {
+  auto second_subscriber = std::make_shared<MockSubscriber>();
+  subscriber->setVideoSinkSSRC(1000);
+  second_subscriber->setVideoSinkSSRC(2000);
+  otm.addSubscriber(second_subscriber, kArbitraryPeerId2);
+
+  erizo::RtpHeader header;
+  header.setSeqNumber(12);
+  header.setSSRC(1);
+  auto packet = std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
+                                             sizeof(erizo::RtpHeader), erizo::VIDEO_PACKET);
+  std::shared_ptr<DataPacket> first_packet, second_packet;
+  EXPECT_CALL(*subscriber, internalDeliverVideoData_(_)).WillOnce(DoAll(SaveArg<0>(&first_packet), Return(0)));
+  EXPECT_CALL(*second_subscriber, internalDeliverVideoData_(_)).WillOnce(DoAll(SaveArg<0>(&second_packet), Return(0)));
+
+  otm.deliverVideoData(packet);
+
+  EXPECT_THAT(first_packet->data, Eq(packet->data));
+  EXPECT_THAT(second_packet->data, Eq(packet->data));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(packet->data)->getSSRC(), Eq(1u));
+
+  first_packet->makeWritable();
+  second_packet->makeWritable();
+  EXPECT_THAT(first_packet->data, Ne(packet->data));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(first_packet->data)->getSSRC(), Eq(1000u));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(second_packet->data)->getSSRC(), Eq(2000u));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(second_packet->data)->getSeqNumber(), Eq(12));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(packet->data)->getSSRC(), Eq(1u));
+}
+
+TEST_F(OneToManyProcessorTest, deliverAudioData_RewritesSSRCPerSubscriber_WithoutModifyingPublisherPacket) {
+  subscriber->setAudioSinkSSRC(3000);
+
+  erizo::RtpHeader header;
+  header.setSSRC(2);
+  auto packet = std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
+                                             sizeof(erizo::RtpHeader), erizo::AUDIO_PACKET);
+  std::shared_ptr<DataPacket> subscriber_packet;
+  EXPECT_CALL(*subscriber, internalDeliverAudioData_(_)).WillOnce(DoAll(SaveArg<0>(&subscriber_packet), Return(0)));
+
+  otm.deliverAudioData(packet);
+
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(subscriber_packet->header())->getSSRC(), Eq(3000u));
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(packet->data)->getSSRC(), Eq(2u));
+}
+
+// Compares the legacy fan-out (rewrite the shared header and deep copy for every subscriber) with the
+// shared payload fan-out. Run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+class OneToManyProcessorBenchmark : public OneToManyProcessorTest {
+ protected:
+  static constexpr int kSubscribers = 500;
+  static constexpr int kPackets = 1000;
+  static constexpr int kPacketSize = 1200;
+
+  std::shared_ptr<DataPacket> createPacket() {
+    char buffer[kPacketSize] = {};
+    erizo::RtpHeader* header = reinterpret_cast<erizo::RtpHeader*>(buffer);
+    header->setVersion(2);
+    header->setSSRC(1);
+    header->setPayloadType(100);
+    return std::make_shared<DataPacket>(0, buffer, kPacketSize, erizo::VIDEO_PACKET);
+  }
+
+  template <typename F>
+  double measureNsPerPacketPerSubscriber(F fan_out) {
+    auto packet = createPacket();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kPackets; i++) {
+      fan_out(packet);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / (kPackets * kSubscribers);
+  }
+};
+
+TEST_F(OneToManyProcessorBenchmark, DISABLED_fanOut_NsPerPacketPerSubscriber) {
+  std::vector<std::shared_ptr<DataPacket>> delivered(kSubscribers);
+
+  double legacy = measureNsPerPacketPerSubscriber([&delivered](std::shared_ptr<DataPacket> packet) {
+    erizo::RtpHeader* head = reinterpret_cast<erizo::RtpHeader*>(packet->data);
+    for (int i = 0; i < kSubscribers; i++) {
+      head->setSSRC(1000 + i);
+      delivered[i] = std::make_shared<DataPacket>(*packet);
+    }
+    delivered.assign(kSubscribers, nullptr);
+  });
+
+  double shared = measureNsPerPacketPerSubscriber([&delivered](std::shared_ptr<DataPacket> packet) {
+    for (int i = 0; i < kSubscribers; i++) {
+      std::shared_ptr<DataPacket> subscriber_packet = packet->shareWithPrivateHeader();
+      reinterpret_cast<erizo::RtpHeader*>(subscriber_packet->header())->setSSRC(1000 + i);
+      delivered[i] = subscriber_packet;
+    }
+    for (int i = 0; i < kSubscribers; i++) {
+      delivered[i]->makeWritable();
+    }
+    delivered.assign(kSubscribers, nullptr);
+  });
+
+  double shared_fan_out_only = measureNsPerPacketPerSubscriber([&delivered](std::shared_ptr<DataPacket> packet) {
+    for (int i = 0; i < kSubscribers; i++) {
+      std::shared_ptr<DataPacket> subscriber_packet = packet->shareWithPrivateHeader();
+      reinterpret_cast<erizo::RtpHeader*>(subscriber_packet->header())->setSSRC(1000 + i);
+      delivered[i] = subscriber_packet;
+    }
+    delivered.assign(kSubscribers, nullptr);
+  });
+
+  std::cout << "Fan-out to " << kSubscribers << " subscribers, ns/packet/subscriber:" << std::endl
+            << "  copy per subscriber:             " << legacy << std::endl
+            << "  shared payload (materialized):   " << shared << std::endl
+            << "  shared payload (publisher side): " << shared_fan_out_only << std::endl;
+}
@@ -27,7 +27,7 @@ TEST(erizoPacket, rtpPacketQueueBasicBehavior) {
     ASSERT_EQ(queue.hasData(), false);
 
     // If we try to pop this packet, we should get back a null shared_ptr object.
-    boost::shared_ptr<erizo::DataPacket> packet = queue.popPacket();
+    std::shared_ptr<erizo::DataPacket> packet = queue.popPacket();
     ASSERT_THAT(packet.get(), IsNull());
     ASSERT_EQ(queue.getSize(), 1);
     ASSERT_EQ(queue.hasData(), false);
@@ -53,7 +53,7 @@ TEST(erizoPacket, rtpPacketQueueCorrectlyReordersSamples) {
 
     for (int x = 1; x <=10; x++) {
         // override our default pop behavior so we can validate these are ordered
-        boost::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
+        std::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
         const erizo::RtpHeader *poppedHeader = reinterpret_cast<const erizo::RtpHeader*>(packet->data);
         ASSERT_EQ(poppedHeader->getSeqNumber(), x);
     }
@@ -74,7 +74,7 @@ TEST(erizoPacket, rtpPacketQueueCorrectlyHandlesSequenceNumberRollover) {
     x = 65530;
     while (x != 5) {
         // override our default pop behavior so we can validate these are ordered
-        boost::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
+        std::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
         const erizo::RtpHeader *poppedHeader = reinterpret_cast<const erizo::RtpHeader*>(packet->data);
         ASSERT_EQ(poppedHeader->getSeqNumber(), x);
         x += 1;
@@ -97,7 +97,7 @@ TEST(erizoPacket, rtpPacketQueueCorrectlyHandlesSequenceNumberRolloverBackwards)
     x = 65530;
     while (x != 5) {
         // override our default pop behavior so we can validate these are ordered
-        boost::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
+        std::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
         const erizo::RtpHeader *poppedHeader = reinterpret_cast<const erizo::RtpHeader*>(packet->data);
         ASSERT_EQ(poppedHeader->getSeqNumber(), x);
         x += 1;
@@ -237,3 +237,70 @@ TEST(erizoPacket, depthCalculationHandlesTimestampWrap) {
     ASSERT_EQ(queue.getSize(), (max + 1));
     ASSERT_EQ(queue.hasData(), true);
 }
+
+TEST(erizoPacket, layerSetShouldTestMembershipWithoutAllocating) {
+    erizo::LayerSet layers{2};
+    layers.addRange(4, 5);
+
+    ASSERT_TRUE(layers.contains(2));
+    ASSERT_FALSE(layers.contains(3));
+    ASSERT_TRUE(layers.contains(5));
+    ASSERT_EQ(layers.lowest(), 2);
+
+    std::vector<int> members;
+    for (int layer : layers) {
+        members.push_back(layer);
+    }
+    ASSERT_EQ(members, (std::vector<int>{2, 4, 5}));
+}
+
+TEST(erizoPacket, layerSetShouldIgnoreLayersOutOfRange) {
+    erizo::LayerSet layers{-1, erizo::LayerSet::kMaxLayers};
+
+    ASSERT_TRUE(layers.empty());
+    ASSERT_EQ(layers.lowest(), -1);
+    ASSERT_FALSE(layers.contains(-1));
+}
+
+TEST(erizoPacket, rtpPacketQueueCountsDiscardedPackets) {
+    int max = 10, depth = 5;
+    erizo::RtpPacketQueue queue(depth, max);  // max and depth.
+    queue.setTimebase(1);   // dummy timebase.
+
+    for (uint16_t x = 0; x < 20; x++) {
+        erizo::RtpHeader header;
+        header.setSeqNumber(x);
+        header.setTimestamp(x);
+        queue.pushPacket((const char *)&header, sizeof(erizo::RtpHeader));
+    }
+    erizo::RtpHeader header;
+    header.setSeqNumber(15);
+    queue.pushPacket((const char *)&header, sizeof(erizo::RtpHeader));
+    queue.popPacket();
+    header.setSeqNumber(2);
+    queue.pushPacket((const char *)&header, sizeof(erizo::RtpHeader));
+
+    erizo::RtpPacketQueueStats stats = queue.getStats();
+    ASSERT_EQ(stats.overflow, 9u);
+    ASSERT_EQ(stats.duplicate, 1u);
+    ASSERT_EQ(stats.late, 1u);
+}
+
+TEST(erizoPacket, rtpPacketQueueReordersAcrossGapsLargerThanItsInitialCapacity) {
+    erizo::RtpPacketQueue queue;
+    const uint16_t gap = erizo::RtpPacketQueue::kInitialCapacity * 4;
+    uint16_t sequence_numbers[] = {100, static_cast<uint16_t>(100 + gap), 101, static_cast<uint16_t>(100 - gap)};
+    for (uint16_t sequence_number : sequence_numbers) {
+        erizo::RtpHeader header;
+        header.setSeqNumber(sequence_number);
+        queue.pushPacket((const char *)&header, sizeof(erizo::RtpHeader));
+    }
+
+    ASSERT_EQ(queue.getSize(), 4);
+    uint16_t expected[] = {static_cast<uint16_t>(100 - gap), 100, 101, static_cast<uint16_t>(100 + gap)};
+    for (uint16_t sequence_number : expected) {
+        std::shared_ptr<erizo::DataPacket> packet = queue.popPacket(true);
+        const erizo::RtpHeader *poppedHeader = reinterpret_cast<const erizo::RtpHeader*>(packet->data);
+        ASSERT_EQ(poppedHeader->getSeqNumber(), sequence_number);
+    }
+}
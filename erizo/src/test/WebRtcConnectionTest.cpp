@@ -20,6 +20,7 @@ using testing::AtLeast;
 using erizo::DataPacket;
 using erizo::ExtMap;
 using erizo::IceConfig;
+using erizo::PacketLengthIs;
 using erizo::RtpMap;
 using erizo::RtpUtils;
 using erizo::WebRtcConnection;
@@ -148,6 +149,51 @@ TEST_P(WebRtcConnectionTest, forwardRembToStreams_When_StreamTheyExist) {
   onRembReceived();
 }
 
+TEST_P(WebRtcConnectionTest, forwardRtcpOnlyToTheStreamWithItsSsrc) {
+  size_t last = streams.size() - 1;
+  for (size_t index = 0; index < streams.size(); index++) {
+    EXPECT_CALL(*streams[index], onTransportData(_, _)).Times(index == last ? 1 : 0);
+  }
+
+  uint32_t video_source_ssrc = getSsrcFromIndex(last) + 2;
+  connection->onTransportData(RtpUtils::createPLI(video_source_ssrc, 1), transport.get());
+}
+
+TEST_P(WebRtcConnectionTest, forwardOnlyItsBlocksOfCompoundRtcpToEachStream) {
+  size_t last = streams.size() - 1;
+  char buffer[1] = {0};
+  auto compound = std::make_shared<DataPacket>(0, buffer, 0, erizo::OTHER_PACKET);
+  auto appendPli = [compound] (uint32_t source_ssrc) {
+    auto pli = RtpUtils::createPLI(source_ssrc, 1);
+    memcpy(compound->data + compound->length, pli->data, pli->length);
+    compound->length += pli->length;
+    return pli->length;
+  };
+  int pli_length = 0;
+  for (size_t index = 0; index < streams.size(); index++) {
+    pli_length = appendPli(getSsrcFromIndex(index) + 2);
+  }
+  appendPli(getSsrcFromIndex(last) + 2);
+
+  for (size_t index = 0; index < streams.size(); index++) {
+    int expected_length = index == last ? 2 * pli_length : pli_length;
+    EXPECT_CALL(*streams[index], onTransportData(_, _)).With(Args<0>(PacketLengthIs(expected_length))).Times(1);
+  }
+
+  connection->onTransportData(compound, transport.get());
+}
+
+TEST_P(WebRtcConnectionTest, stopForwardingToStreams_When_TheyAreRemoved) {
+  for (auto &stream : streams) {
+    EXPECT_CALL(*stream, onTransportData(_, _)).Times(0);
+  }
+
+  uint32_t video_source_ssrc = getSsrcFromIndex(0) + 2;
+  connection->removeMediaStream(streams[0]->getId());
+  simulated_worker->executeTasks();
+  connection->onTransportData(RtpUtils::createPLI(video_source_ssrc, 1), transport.get());
+}
+
 INSTANTIATE_TEST_CASE_P(
   REMB_values, WebRtcConnectionTest, testing::Values(
     std::make_tuple(MaxList{300},      100, EnabledList{1},    ExpectedList{100}),
@@ -0,0 +1,124 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <dtls/DtlsSocket.h>
+
+#include <chrono>  // NOLINT
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using testing::Eq;
+using testing::Ne;
+using dtls::DtlsHandshakeStats;
+using dtls::DtlsReceiver;
+using dtls::DtlsSocketContext;
+
+class DtlsEndpoint : public DtlsReceiver {
+ public:
+  explicit DtlsEndpoint(bool is_server) : context{new DtlsSocketContext()} {
+    if (is_server) {
+      context->createServer();
+    } else {
+      context->createClient();
+    }
+    context->setDtlsReceiver(this);
+  }
+
+  void onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override {
+    outgoing.emplace_back(data, data + len);
+  }
+
+  void onHandshakeCompleted(DtlsSocketContext *ctx, std::string client_key, std::string server_key,
+                            std::string srtp_profile) override {
+    completed = true;
+    this->client_key = client_key;
+    this->server_key = server_key;
+    profile = srtp_profile;
+  }
+
+  void onHandshakeFailed(DtlsSocketContext *ctx, const std::string& error) override {
+    failed = true;
+  }
+
+  // Packets are delivered outside of the callbacks, sockets don't expect to be reentered
+  void deliverTo(DtlsEndpoint *peer) {
+    while (!outgoing.empty()) {
+      std::vector<unsigned char> packet = std::move(outgoing.front());
+      outgoing.pop_front();
+      peer->context->read(packet.data(), packet.size());
+    }
+  }
+
+  std::unique_ptr<DtlsSocketContext> context;
+  std::deque<std::vector<unsigned char>> outgoing;
+  bool completed = false;
+  bool failed = false;
+  std::string client_key;
+  std::string server_key;
+  std::string profile;
+};
+
+static bool handshake(DtlsEndpoint *client, DtlsEndpoint *server) {
+  client->context->start();
+  for (int flight = 0; flight < 10 && !(client->completed && server->completed); flight++) {
+    client->deliverTo(server);
+    server->deliverTo(client);
+  }
+  return client->completed && server->completed;
+}
+
+TEST(DtlsSocketContextTest, shouldCompleteHandshakeAndAgreeOnKeys) {
+  DtlsEndpoint client{false};
+  DtlsEndpoint server{true};
+
+  ASSERT_TRUE(handshake(&client, &server));
+
+  EXPECT_FALSE(client.failed || server.failed);
+  EXPECT_THAT(client.client_key, Eq(server.client_key));
+  EXPECT_THAT(client.server_key, Eq(server.server_key));
+  EXPECT_THAT(client.profile, Eq(server.profile));
+}
+
+TEST(DtlsSocketContextTest, shouldShareTheSslContextAndCertificate) {
+  DtlsEndpoint first{true};
+  DtlsEndpoint second{true};
+
+  EXPECT_THAT(first.context->getSSLContext(), Eq(second.context->getSSLContext()));
+  EXPECT_THAT(first.context->getFingerprint(), Eq(second.context->getFingerprint()));
+  EXPECT_THAT(first.context->getFingerprint(), Ne(std::string()));
+}
+
+TEST(DtlsSocketContextTest, shouldCountCompletedHandshakes) {
+  DtlsHandshakeStats before = DtlsSocketContext::getHandshakeStats();
+  DtlsEndpoint client{false};
+  DtlsEndpoint server{true};
+
+  ASSERT_TRUE(handshake(&client, &server));
+
+  EXPECT_THAT(DtlsSocketContext::getHandshakeStats().completed, Eq(before.completed + 2));
+}
+
+// Handshakes run one after the other in a single thread, so the result is the rate a core sustains.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(DtlsSocketContextBenchmark, DISABLED_handshakesPerSecondPerCore) {
+  constexpr int kHandshakes = 200;
+  DtlsSocketContext::Init();
+
+  auto start = std::chrono::steady_clock::now();
+  int completed = 0;
+  for (int i = 0; i < kHandshakes; i++) {
+    DtlsEndpoint client{false};
+    DtlsEndpoint server{true};
+    if (handshake(&client, &server)) {
+      completed++;
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+  EXPECT_THAT(completed, Eq(kHandshakes));
+  double handshakes_per_second = completed * 1e6 / elapsed.count();
+  std::cout << "DTLS handshakes per second per core: " << handshakes_per_second << std::endl;
+}
@@ -0,0 +1,139 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lib/PacketBufferPool.h>
+#include <MediaDefinitions.h>
+
+#include <memory>
+#include <thread>  // NOLINT
+
+using ::testing::Eq;
+using ::testing::Ne;
+using erizo::DataPacket;
+using erizo::PacketBuffer;
+using erizo::PacketBufferPool;
+using erizo::PacketBufferPtr;
+
+constexpr size_t kMaxCachedBuffers = 2;
+
+class PacketBufferPoolTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    pool = std::make_shared<PacketBufferPool>(kMaxCachedBuffers);
+    PacketBufferPool::setCurrent(pool);
+  }
+
+  virtual void TearDown() {
+    PacketBufferPool::setCurrent(nullptr);
+  }
+
+  std::shared_ptr<PacketBufferPool> pool;
+};
+
+TEST_F(PacketBufferPoolTest, shouldAllocateFromHeapWhenEmpty) {
+  PacketBufferPtr buffer = pool->allocate();
+
+  EXPECT_THAT(pool->getStats().allocations, Eq(1u));
+  EXPECT_THAT(pool->getStats().heap_allocations, Eq(1u));
+  EXPECT_THAT(pool->getStats().pool_hits, Eq(0u));
+  EXPECT_THAT(pool->getStats().in_use, Eq(1u));
+}
+
+TEST_F(PacketBufferPoolTest, shouldReuseReleasedBuffers) {
+  PacketBuffer *first_buffer;
+  {
+    PacketBufferPtr buffer = pool->allocate();
+    first_buffer = buffer.get();
+  }
+  EXPECT_THAT(pool->getStats().cached, Eq(1u));
+
+  PacketBufferPtr buffer = pool->allocate();
+
+  EXPECT_THAT(buffer.get(), Eq(first_buffer));
+  EXPECT_THAT(pool->getStats().pool_hits, Eq(1u));
+  EXPECT_THAT(pool->getStats().getHitRate(), Eq(0.5));
+}
+
+TEST_F(PacketBufferPoolTest, shouldNotCacheMoreThanMaxBuffers) {
+  {
+    PacketBufferPtr buffer1 = pool->allocate();
+    PacketBufferPtr buffer2 = pool->allocate();
+    PacketBufferPtr buffer3 = pool->allocate();
+  }
+
+  EXPECT_THAT(pool->getStats().cached, Eq(kMaxCachedBuffers));
+  EXPECT_THAT(pool->getStats().in_use, Eq(0u));
+}
+
+TEST_F(PacketBufferPoolTest, shouldReturnBuffersToTheirOwnPool) {
+  PacketBufferPtr buffer = pool->allocate();
+  std::thread other_thread([&buffer] {
+    PacketBufferPtr released = std::move(buffer);
+  });
+  other_thread.join();
+
+  EXPECT_THAT(pool->getStats().cached, Eq(1u));
+}
+
+TEST_F(PacketBufferPoolTest, shouldKeepBuffersValidAfterPoolIsReleased) {
+  PacketBufferPtr buffer = pool->allocate();
+  PacketBufferPool::setCurrent(nullptr);
+  pool.reset();
+
+  buffer->data()[0] = 1;
+  EXPECT_THAT(buffer->data()[0], Eq(1));
+}
+
+TEST_F(PacketBufferPoolTest, dataPacketCopiesShouldNotShareBuffers) {
+  char payload[] = {1, 2, 3, 4};
+  DataPacket packet{0, payload, sizeof(payload), erizo::VIDEO_PACKET};
+
+  DataPacket copy{packet};
+  copy.data[0] = 5;
+
+  EXPECT_THAT(copy.length, Eq(packet.length));
+  EXPECT_THAT(packet.data[0], Eq(1));
+  EXPECT_THAT(copy.data, Ne(packet.data));
+}
+
+TEST_F(PacketBufferPoolTest, sharedDataPacketsShouldCopyOnWrite) {
+  char payload[] = {1, 2, 3, 4};
+  DataPacket packet{0, payload, sizeof(payload), erizo::VIDEO_PACKET};
+
+  std::shared_ptr<DataPacket> shared = packet.share();
+  EXPECT_THAT(shared->data, Eq(packet.data));
+  EXPECT_TRUE(packet.isShared());
+
+  shared->makeWritable();
+  shared->data[0] = 5;
+
+  EXPECT_THAT(shared->data, Ne(packet.data));
+  EXPECT_THAT(packet.data[0], Eq(1));
+  EXPECT_THAT(shared->data[3], Eq(4));
+  EXPECT_FALSE(packet.isShared());
+}
+
+TEST_F(PacketBufferPoolTest, tailroomShouldAccountForTheDataOffset) {
+  char payload[] = {1, 2, 3, 4};
+  DataPacket packet{0, payload, sizeof(payload), erizo::VIDEO_PACKET};
+  EXPECT_THAT(packet.tailroom(), Eq(erizo::kPacketBufferSize - 4));
+
+  std::shared_ptr<DataPacket> slice = packet.slice(2, 1);
+  EXPECT_THAT(slice->data[0], Eq(3));
+  EXPECT_THAT(slice->tailroom(), Eq(erizo::kPacketBufferSize - 3));
+}
+
+TEST_F(PacketBufferPoolTest, sharedSlicesShouldKeepTheirOffset) {
+  char payload[] = {1, 2, 3, 4, 5, 6};
+  DataPacket packet{0, payload, sizeof(payload), erizo::VIDEO_PACKET};
+  std::shared_ptr<DataPacket> slice = packet.slice(2, 2);
+
+  std::shared_ptr<DataPacket> shared = slice->share();
+  EXPECT_THAT(shared->data, Eq(slice->data));
+
+  shared->makeWritable();
+  EXPECT_THAT(shared->data, Ne(slice->data));
+  EXPECT_THAT(shared->length, Eq(2));
+  EXPECT_THAT(shared->data[0], Eq(3));
+  EXPECT_THAT(shared->data[1], Eq(4));
+}
@@ -0,0 +1,289 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <media/ExternalOutput.h>
+#include <rtp/RtpHeaders.h>
+#include <thread/Worker.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>  // NOLINT
+#include <memory>
+#include <string>
+#include <vector>
+
+using testing::Eq;
+using testing::Gt;
+using testing::HasSubstr;
+using erizo::DataPacket;
+using erizo::ExternalOutput;
+using erizo::RecordingSegmentation;
+using erizo::RtpHeader;
+using erizo::RtpMap;
+using erizo::Worker;
+
+static constexpr unsigned int kVideoPayloadType = 101;
+static constexpr unsigned int kVideoClockRate = 90000;
+static constexpr int kPacketSize = 200;
+static constexpr unsigned int kVp8PayloadType = 96;
+static constexpr uint32_t kFrameDuration = 3000;
+
+// Counts every task queued in it, so tests can tell how many writes an output schedules
+class CountingWorker : public Worker {
+ public:
+  CountingWorker() : queued_tasks{0} {}
+
+  void task(Task f) override {
+    queued_tasks++;
+    Worker::task(f);
+  }
+
+  std::atomic<int> queued_tasks;
+};
+
+class ExternalOutputWriteTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    media_worker = std::make_shared<Worker>();
+    muxer_worker = std::make_shared<CountingWorker>();
+    media_worker->start();
+    muxer_worker->start();
+    // Not a codec the output muxes, so packets are only queued and counted
+    std::vector<RtpMap> rtp_maps{RtpMap{kVideoPayloadType, "VP9", kVideoClockRate, erizo::VIDEO_TYPE, 1}};
+    output = std::make_shared<ExternalOutput>(media_worker, "/tmp/external_output_test.mkv", rtp_maps,
+                                              std::vector<erizo::ExtMap>(), muxer_worker);
+    output->init();
+  }
+
+  virtual void TearDown() {
+    output->close();
+    runInWorker(media_worker);
+    runInWorker(muxer_worker);
+    media_worker->close();
+    muxer_worker->close();
+  }
+
+  std::shared_ptr<DataPacket> createVideoPacket(uint16_t sequence_number, uint32_t timestamp,
+                                                bool is_keyframe = false) {
+    char buffer[kPacketSize] = {0};
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(buffer);
+    head->setVersion(2);
+    head->setPayloadType(kVideoPayloadType);
+    head->setSeqNumber(sequence_number);
+    head->setTimestamp(timestamp);
+    head->setSSRC(1234);
+    auto packet = std::make_shared<DataPacket>(0, buffer, kPacketSize, erizo::VIDEO_PACKET);
+    packet->codec = erizo::RtpCodec::VP8;
+    packet->is_keyframe = is_keyframe;
+    return packet;
+  }
+
+  // Keeps the worker busy until the returned promise is set, like a slow disk would
+  std::shared_ptr<std::promise<void>> blockWorker(std::shared_ptr<Worker> worker) {
+    auto unblock = std::make_shared<std::promise<void>>();
+    std::shared_future<void> unblocked = unblock->get_future().share();
+    worker->task([unblocked] {
+      unblocked.wait();
+    });
+    return unblock;
+  }
+
+  std::shared_future<void> queueMarker(std::shared_ptr<Worker> worker) {
+    auto done = std::make_shared<std::promise<void>>();
+    worker->task([done] {
+      done->set_value();
+    });
+    return done->get_future().share();
+  }
+
+  // Returns once the tasks already queued in the worker have run
+  void runInWorker(std::shared_ptr<Worker> worker) {
+    queueMarker(worker).wait();
+  }
+
+  uint64_t getDroppedVideoPackets() {
+    return output->getStats().dropped_video_packets;
+  }
+
+  std::shared_ptr<Worker> media_worker;
+  std::shared_ptr<CountingWorker> muxer_worker;
+  std::shared_ptr<ExternalOutput> output;
+};
+
+TEST(ExternalOutputTest, shouldNumberSegmentsBeforeTheExtension) {
+  EXPECT_THAT(ExternalOutput::getSegmentUrl("/tmp/recording.mkv", 0), Eq("/tmp/recording_00000.mkv"));
+  EXPECT_THAT(ExternalOutput::getSegmentUrl("/tmp/recording.mp4", 12), Eq("/tmp/recording_00012.mp4"));
+  EXPECT_THAT(ExternalOutput::getSegmentUrl("/tmp.dir/recording", 1), Eq("/tmp.dir/recording_00001"));
+}
+
+TEST(ExternalOutputTest, shouldWriteTheIndexNextToTheSegments) {
+  EXPECT_THAT(ExternalOutput::getIndexUrl("/tmp/recording.mkv"), Eq("/tmp/recording.index"));
+  EXPECT_THAT(ExternalOutput::getIndexUrl("/tmp.dir/recording"), Eq("/tmp.dir/recording.index"));
+}
+
+TEST(ExternalOutputTest, shouldOnlySegmentWhenALimitIsSet) {
+  RecordingSegmentation segmentation;
+  EXPECT_FALSE(segmentation.isEnabled());
+
+  segmentation.max_duration = std::chrono::seconds(60);
+  EXPECT_TRUE(segmentation.isEnabled());
+
+  segmentation = RecordingSegmentation();
+  segmentation.max_bytes = 1024;
+  EXPECT_TRUE(segmentation.isEnabled());
+}
+
+TEST_F(ExternalOutputWriteTest, shouldDropVideoUntilTheNextKeyframe_WhenTheMuxerFallsBehind) {
+  auto unblock = blockWorker(muxer_worker);
+  output->write(createVideoPacket(1, 0, true));
+  output->write(createVideoPacket(2, 8 * kVideoClockRate));
+
+  output->write(createVideoPacket(3, 8 * kVideoClockRate + 3000));
+  output->write(createVideoPacket(4, 8 * kVideoClockRate + 6000, true));
+  EXPECT_THAT(getDroppedVideoPackets(), Eq(2u));
+
+  unblock->set_value();
+  runInWorker(muxer_worker);
+  output->write(createVideoPacket(5, 8 * kVideoClockRate + 9000));
+  EXPECT_THAT(getDroppedVideoPackets(), Eq(3u));
+
+  output->write(createVideoPacket(6, 8 * kVideoClockRate + 12000, true));
+  output->write(createVideoPacket(7, 8 * kVideoClockRate + 15000));
+  EXPECT_THAT(getDroppedVideoPackets(), Eq(3u));
+}
+
+TEST_F(ExternalOutputWriteTest, shouldScheduleASingleWrite_WhileOneIsPending) {
+  auto unblock = blockWorker(muxer_worker);
+  int queued_tasks = muxer_worker->queued_tasks;
+
+  for (uint16_t packet = 0; packet < 15; packet++) {
+    output->write(createVideoPacket(packet, packet * kVideoClockRate / 2));
+  }
+
+  EXPECT_THAT(muxer_worker->queued_tasks - queued_tasks, Eq(1));
+  unblock->set_value();
+}
+
+TEST_F(ExternalOutputWriteTest, shouldYieldTheMuxerWorker_AfterAFullBatch) {
+  auto unblock = blockWorker(muxer_worker);
+  const int packets = 1200;
+  for (int packet = 0; packet < packets; packet++) {
+    output->write(createVideoPacket(packet, packet * 7 * kVideoClockRate / packets));
+  }
+  // Queued behind the first batch, before the rest of the packets are written
+  std::shared_future<void> after_first_batch = queueMarker(muxer_worker);
+
+  unblock->set_value();
+  after_first_batch.wait();
+  EXPECT_THAT(output->getStats().written_packets, Eq(static_cast<uint64_t>(ExternalOutput::kMaxWriteBatchSize)));
+
+  runInWorker(muxer_worker);
+  EXPECT_THAT(output->getStats().written_packets, Gt(static_cast<uint64_t>(ExternalOutput::kMaxWriteBatchSize)));
+}
+
+class ExternalOutputSegmentationTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    removeFiles();
+    media_worker = std::make_shared<Worker>();
+    muxer_worker = std::make_shared<Worker>();
+    media_worker->start();
+    muxer_worker->start();
+    std::vector<RtpMap> rtp_maps{RtpMap{kVp8PayloadType, "VP8", kVideoClockRate, erizo::VIDEO_TYPE, 1}};
+    output = std::make_shared<ExternalOutput>(media_worker, kOutputUrl, rtp_maps, std::vector<erizo::ExtMap>(),
+                                              muxer_worker);
+    RecordingSegmentation segmentation;
+    segmentation.max_duration = std::chrono::seconds(1);
+    output->setSegmentation(segmentation);
+    output->init();
+  }
+
+  virtual void TearDown() {
+    media_worker->close();
+    muxer_worker->close();
+    removeFiles();
+  }
+
+  void removeFiles() {
+    std::remove(ExternalOutput::getSegmentUrl(kOutputUrl, 0).c_str());
+    std::remove(ExternalOutput::getSegmentUrl(kOutputUrl, 1).c_str());
+    std::remove(ExternalOutput::getIndexUrl(kOutputUrl).c_str());
+  }
+
+  // Single packet VP8 frame, with the start of partition bit and the marker set
+  std::shared_ptr<DataPacket> createFrame(uint16_t sequence_number, bool is_keyframe) {
+    char buffer[kPacketSize] = {0};
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(buffer);
+    head->setVersion(2);
+    head->setPayloadType(kVp8PayloadType);
+    head->setSeqNumber(sequence_number);
+    head->setTimestamp(sequence_number * kFrameDuration);
+    head->setSSRC(1234);
+    head->setMarker(true);
+    buffer[head->getHeaderLength()] = 0x10;
+    buffer[head->getHeaderLength() + 1] = is_keyframe ? 0x00 : 0x01;
+    auto packet = std::make_shared<DataPacket>(0, buffer, kPacketSize, erizo::VIDEO_PACKET);
+    packet->codec = erizo::RtpCodec::VP8;
+    packet->is_keyframe = is_keyframe;
+    return packet;
+  }
+
+  // Queued frames are written when the output is closed
+  void closeOutput() {
+    output->close();
+    for (std::shared_ptr<Worker> worker : {media_worker, muxer_worker}) {
+      auto done = std::make_shared<std::promise<void>>();
+      worker->task([done] {
+        done->set_value();
+      });
+      done->get_future().wait();
+    }
+  }
+
+  bool exists(const std::string &file) {
+    return std::ifstream(file).good();
+  }
+
+  std::vector<std::string> readIndex() {
+    std::ifstream index(ExternalOutput::getIndexUrl(kOutputUrl));
+    std::vector<std::string> entries;
+    std::string entry;
+    while (std::getline(index, entry)) {
+      entries.push_back(entry);
+    }
+    return entries;
+  }
+
+  const std::string kOutputUrl = "/tmp/external_output_segmentation_test.mkv";
+  std::shared_ptr<Worker> media_worker;
+  std::shared_ptr<Worker> muxer_worker;
+  std::shared_ptr<ExternalOutput> output;
+};
+
+TEST_F(ExternalOutputSegmentationTest, shouldStartANewSegmentOnTheFirstKeyframeAfterTheMaxDuration) {
+  // 1.3s of video before the second keyframe
+  output->write(createFrame(0, true));
+  for (uint16_t frame = 1; frame < 40; frame++) {
+    output->write(createFrame(frame, false));
+  }
+  output->write(createFrame(40, true));
+  for (uint16_t frame = 41; frame < 45; frame++) {
+    output->write(createFrame(frame, false));
+  }
+
+  closeOutput();
+
+  EXPECT_TRUE(exists(ExternalOutput::getSegmentUrl(kOutputUrl, 0)));
+  EXPECT_TRUE(exists(ExternalOutput::getSegmentUrl(kOutputUrl, 1)));
+  std::vector<std::string> entries = readIndex();
+  ASSERT_THAT(entries.size(), Eq(2u));
+  EXPECT_THAT(entries[0], HasSubstr("\"file\":\"external_output_segmentation_test_00000.mkv\""));
+  EXPECT_THAT(entries[0], HasSubstr("\"segment\":0,"));
+  EXPECT_THAT(entries[0], HasSubstr("\"last\":false"));
+  EXPECT_THAT(entries[1], HasSubstr("\"file\":\"external_output_segmentation_test_00001.mkv\""));
+  EXPECT_THAT(entries[1], HasSubstr("\"segment\":1,"));
+  EXPECT_THAT(entries[1], HasSubstr("\"last\":true"));
+}
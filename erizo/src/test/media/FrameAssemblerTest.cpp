@@ -0,0 +1,171 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <media/FrameAssembler.h>
+#include <rtp/RtpHeaders.h>
+
+#include <memory>
+#include <vector>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+
+using testing::Eq;
+using testing::Gt;
+using erizo::AssembledFrame;
+using erizo::DataPacket;
+using erizo::FrameAssembler;
+using erizo::FrameBufferPool;
+using erizo::PacketTools;
+
+static constexpr uint16_t kStartSequenceNumber = 65534;
+static constexpr uint32_t kFrameDuration = 3000;
+static constexpr uint32_t kReorderWindow = 90 * FrameAssembler::kMaxReorderDelayMs;
+
+class FrameAssemblerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    pool = std::make_shared<FrameBufferPool>();
+    createAssembler(std::unique_ptr<erizo::Depacketizer>(new erizo::Vp8Depacketizer()));
+  }
+
+  void createAssembler(std::unique_ptr<erizo::Depacketizer> depacketizer) {
+    assembler.reset(new FrameAssembler(std::move(depacketizer), 90000, [this] (const AssembledFrame& frame) {
+      frames.push_back(frame);
+    }, pool));
+  }
+
+  // VP8 packets of a frame, only the first one has the start of partition bit
+  std::vector<std::shared_ptr<DataPacket>> createVP8Frame(int sequence_number, uint32_t timestamp,
+                                                          bool is_keyframe, int packets) {
+    std::vector<std::shared_ptr<DataPacket>> frame_packets;
+    for (int i = 0; i < packets; i++) {
+      auto packet = PacketTools::createVP8Packet(static_cast<uint16_t>(sequence_number + i), timestamp,
+                                                 is_keyframe, i == packets - 1);
+      if (i > 0) {
+        const erizo::RtpHeader* head = reinterpret_cast<const erizo::RtpHeader*>(packet->data);
+        packet->data[head->getHeaderLength()] = 0;
+      }
+      frame_packets.push_back(packet);
+    }
+    return frame_packets;
+  }
+
+  void addPackets(const std::vector<std::shared_ptr<DataPacket>>& packets) {
+    for (const auto& packet : packets) {
+      assembler->addPacket(packet);
+    }
+  }
+
+  std::shared_ptr<FrameBufferPool> pool;
+  std::unique_ptr<FrameAssembler> assembler;
+  std::vector<AssembledFrame> frames;
+};
+
+TEST_F(FrameAssemblerTest, shouldEmitSinglePacketKeyframes) {
+  addPackets(createVP8Frame(kStartSequenceNumber, 0, true, 1));
+
+  ASSERT_THAT(frames.size(), Eq(1u));
+  EXPECT_TRUE(frames[0].is_keyframe);
+  EXPECT_TRUE(frames[0].is_complete);
+  EXPECT_TRUE(frames[0].is_decodable);
+  EXPECT_THAT(frames[0].size(), Gt(0));
+}
+
+TEST_F(FrameAssemblerTest, shouldAssembleReorderedPackets) {
+  auto packets = createVP8Frame(kStartSequenceNumber, 0, true, 3);
+  auto single_packet = createVP8Frame(kStartSequenceNumber, 0, true, 1);
+  assembler->addPacket(packets[2]);
+  assembler->addPacket(packets[0]);
+  EXPECT_THAT(frames.size(), Eq(0u));
+
+  assembler->addPacket(packets[1]);
+
+  ASSERT_THAT(frames.size(), Eq(1u));
+  EXPECT_TRUE(frames[0].is_complete);
+  EXPECT_TRUE(frames[0].is_keyframe);
+  const erizo::RtpHeader* head = reinterpret_cast<const erizo::RtpHeader*>(single_packet[0]->data);
+  int payload_size = single_packet[0]->length - head->getHeaderLength() - 1;  // 1 = vp8 payload descriptor
+  EXPECT_THAT(frames[0].size(), Eq(3 * payload_size));
+}
+
+TEST_F(FrameAssemblerTest, shouldEmitFramesInTimestampOrder) {
+  auto first = createVP8Frame(kStartSequenceNumber, 0, true, 2);
+  auto second = createVP8Frame(kStartSequenceNumber + 2, kFrameDuration, false, 1);
+  assembler->addPacket(first[0]);
+  addPackets(second);
+  EXPECT_THAT(frames.size(), Eq(0u));
+
+  assembler->addPacket(first[1]);
+
+  ASSERT_THAT(frames.size(), Eq(2u));
+  EXPECT_THAT(frames[0].timestamp, Eq(0u));
+  EXPECT_THAT(frames[1].timestamp, Eq(kFrameDuration));
+  EXPECT_TRUE(frames[1].is_decodable);
+}
+
+TEST_F(FrameAssemblerTest, shouldNotDecodeUntilNextKeyframeAfterLosingPackets) {
+  addPackets(createVP8Frame(kStartSequenceNumber, 0, true, 1));
+  auto lost = createVP8Frame(kStartSequenceNumber + 1, kFrameDuration, false, 2);
+  assembler->addPacket(lost[1]);
+  addPackets(createVP8Frame(kStartSequenceNumber + 3, kFrameDuration + kReorderWindow + 1, false, 1));
+  addPackets(createVP8Frame(kStartSequenceNumber + 4, kFrameDuration + kReorderWindow + 2, true, 1));
+
+  ASSERT_THAT(frames.size(), Eq(3u));
+  EXPECT_FALSE(frames[1].is_decodable);
+  EXPECT_TRUE(frames[1].is_complete);
+  EXPECT_TRUE(frames[2].is_decodable);
+  EXPECT_THAT(assembler->getStats().incomplete_frames, Eq(1u));
+  EXPECT_FALSE(assembler->isWaitingForKeyframe());
+}
+
+TEST_F(FrameAssemblerTest, shouldNotDecodeUntilNextKeyframeAfterLosingWholeFrames) {
+  addPackets(createVP8Frame(kStartSequenceNumber, 0, true, 1));
+  addPackets(createVP8Frame(kStartSequenceNumber + 2, 2 * kFrameDuration, false, 1));
+  addPackets(createVP8Frame(kStartSequenceNumber + 3, 3 * kFrameDuration, true, 1));
+
+  ASSERT_THAT(frames.size(), Eq(3u));
+  EXPECT_TRUE(frames[1].is_complete);
+  EXPECT_FALSE(frames[1].is_decodable);
+  EXPECT_TRUE(frames[2].is_decodable);
+}
+
+TEST_F(FrameAssemblerTest, shouldDiscardLateAndDuplicatePackets) {
+  auto first = createVP8Frame(kStartSequenceNumber, 0, true, 1);
+  addPackets(first);
+  addPackets(first);
+
+  EXPECT_THAT(frames.size(), Eq(1u));
+  EXPECT_THAT(assembler->getStats().late_packets, Eq(1u));
+}
+
+TEST_F(FrameAssemblerTest, shouldStartH264FramesAfterThePreviousMarker) {
+  createAssembler(std::unique_ptr<erizo::Depacketizer>(new erizo::H264Depacketizer()));
+  uint16_t sequence_number = kStartSequenceNumber;
+  auto end_of_previous = PacketTools::createH264SingleNalPacket(sequence_number++, 0, false);
+  end_of_previous->data[1] |= 0x80;  // marker
+  assembler->addPacket(end_of_previous);
+
+  // Nothing tells where the first frame started, it's only emitted when it falls out of the window
+  uint32_t timestamp = kReorderWindow + 1;
+  assembler->addPacket(PacketTools::createH264FragmentedPacket(sequence_number++, timestamp,
+                                                               true, false, true));
+  auto end = PacketTools::createH264FragmentedPacket(sequence_number++, timestamp, false, true, true);
+  end->data[1] |= 0x80;
+  assembler->addPacket(end);
+
+  ASSERT_THAT(frames.size(), Eq(2u));
+  EXPECT_FALSE(frames[0].is_complete);
+  EXPECT_TRUE(frames[1].is_keyframe);
+  EXPECT_TRUE(frames[1].is_complete);
+  EXPECT_TRUE(frames[1].is_decodable);
+}
+
+TEST_F(FrameAssemblerTest, shouldReuseFrameBuffers) {
+  addPackets(createVP8Frame(kStartSequenceNumber, 0, true, 1));
+  frames.clear();
+  addPackets(createVP8Frame(kStartSequenceNumber + 1, kFrameDuration, false, 1));
+
+  EXPECT_THAT(pool->getStats().allocations, Eq(2u));
+  EXPECT_THAT(pool->getStats().pool_hits, Eq(1u));
+}
@@ -0,0 +1,55 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <media/TranscodingLadder.h>
+#include <media/codecs/VideoScaler.h>
+
+#include <algorithm>
+#include <vector>
+
+using testing::Eq;
+using erizo::TranscodingLadder;
+using erizo::TranscodingRendition;
+using erizo::VideoScaler;
+
+TEST(TranscodingLadderTest, shouldSelectTheHighestRenditionThatFits) {
+  std::vector<TranscodingRendition> renditions = TranscodingLadder::getDefaultRenditions();
+
+  EXPECT_THAT(TranscodingLadder::selectRendition(renditions, 5000000), Eq(0u));
+  EXPECT_THAT(TranscodingLadder::selectRendition(renditions, 1000000), Eq(1u));
+  // The margin leaves room for audio and overhead
+  EXPECT_THAT(TranscodingLadder::selectRendition(renditions, 600000), Eq(2u));
+  EXPECT_THAT(TranscodingLadder::selectRendition(renditions, 0), Eq(2u));
+}
+
+TEST(TranscodingLadderTest, shouldKeepTheAspectRatioWithoutUpscaling) {
+  int width = 0;
+  int height = 0;
+  TranscodingLadder::getOutputSize(1280, 720, 360, &width, &height);
+  EXPECT_THAT(width, Eq(640));
+  EXPECT_THAT(height, Eq(360));
+
+  TranscodingLadder::getOutputSize(640, 480, 720, &width, &height);
+  EXPECT_THAT(width, Eq(640));
+  EXPECT_THAT(height, Eq(480));
+
+  TranscodingLadder::getOutputSize(640, 480, 181, &width, &height);
+  EXPECT_THAT(width, Eq(240));
+  EXPECT_THAT(height, Eq(180));
+}
+
+TEST(TranscodingLadderTest, shouldAverageThePixelsWhenDownscaling) {
+  std::vector<unsigned char> src(VideoScaler::getI420Size(4, 4));
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      src[y * 4 + x] = x < 2 ? 10 : 20;
+    }
+  }
+  std::fill(src.begin() + 16, src.begin() + 20, 128);
+  std::fill(src.begin() + 20, src.end(), 64);
+  std::vector<unsigned char> dst(VideoScaler::getI420Size(2, 2));
+
+  VideoScaler::scaleI420(src.data(), 4, 4, dst.data(), 2, 2);
+
+  EXPECT_THAT(dst, Eq(std::vector<unsigned char>{10, 20, 10, 20, 128, 64}));
+}
@@ -0,0 +1,102 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/DelayBasedBandwidthEstimator.h>
+#include <rtp/TransportFeedbackGenerator.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+using testing::Eq;
+using testing::Gt;
+using testing::Lt;
+using erizo::DataPacket;
+using erizo::DelayBasedBandwidthEstimator;
+using erizo::SimulatedClock;
+using erizo::TransportFeedbackGenerator;
+using webrtc::rtcp::TransportFeedback;
+
+static constexpr size_t kPacketSize = 250;
+static constexpr int kPacketsPerFeedback = 10;
+
+class DelayBasedBandwidthEstimatorTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    send_clock = std::make_shared<SimulatedClock>();
+    receive_clock = std::make_shared<SimulatedClock>();
+    estimator = std::make_shared<DelayBasedBandwidthEstimator>(send_clock);
+    generator = std::make_shared<TransportFeedbackGenerator>(receive_clock);
+    sequence_number = 0;
+  }
+
+  bool sendFeedback() {
+    std::shared_ptr<DataPacket> packet = generator->generateFeedback();
+    std::unique_ptr<TransportFeedback> feedback =
+      TransportFeedback::ParseFrom(reinterpret_cast<uint8_t*>(packet->data), packet->length);
+    return estimator->onTransportFeedback(*feedback);
+  }
+
+  // Packets are sent every 10ms and they take receive_interval to go through the link
+  void sendPackets(int count, std::chrono::milliseconds receive_interval) {
+    for (int i = 0; i < count; i++) {
+      estimator->onPacketSent(sequence_number, kPacketSize);
+      generator->onPacketReceived(sequence_number, 1111, 2222);
+      sequence_number++;
+      send_clock->advanceTime(std::chrono::milliseconds(10));
+      receive_clock->advanceTime(receive_interval);
+      if (sequence_number % kPacketsPerFeedback == 0) {
+        sendFeedback();
+      }
+    }
+  }
+
+  std::shared_ptr<SimulatedClock> send_clock;
+  std::shared_ptr<SimulatedClock> receive_clock;
+  std::shared_ptr<DelayBasedBandwidthEstimator> estimator;
+  std::shared_ptr<TransportFeedbackGenerator> generator;
+  uint16_t sequence_number;
+};
+
+TEST_F(DelayBasedBandwidthEstimatorTest, shouldStartWithTheDefaultBitrate) {
+  EXPECT_THAT(estimator->getEstimate(), Eq(DelayBasedBandwidthEstimator::kStartBitrate));
+}
+
+TEST_F(DelayBasedBandwidthEstimatorTest, shouldCountLostPackets) {
+  for (uint16_t i = 0; i < 5; i++) {
+    estimator->onPacketSent(i, kPacketSize);
+  }
+  generator->onPacketReceived(0, 1111, 2222);
+  generator->onPacketReceived(1, 1111, 2222);
+  generator->onPacketReceived(4, 1111, 2222);
+
+  sendFeedback();
+
+  EXPECT_THAT(estimator->getLostPackets(), Eq(2u));
+}
+
+TEST_F(DelayBasedBandwidthEstimatorTest, shouldIgnorePacketsThatWereNotSent) {
+  generator->onPacketReceived(0, 1111, 2222);
+  generator->onPacketReceived(3, 1111, 2222);
+
+  sendFeedback();
+
+  EXPECT_THAT(estimator->getLostPackets(), Eq(0u));
+}
+
+TEST_F(DelayBasedBandwidthEstimatorTest, shouldIncreaseTheEstimate_WhenThereIsNoCongestion) {
+  sendPackets(1000, std::chrono::milliseconds(10));
+
+  EXPECT_THAT(estimator->getEstimate(), Gt(DelayBasedBandwidthEstimator::kStartBitrate));
+}
+
+TEST_F(DelayBasedBandwidthEstimatorTest, shouldDecreaseTheEstimate_WhenTheDelayGrows) {
+  sendPackets(500, std::chrono::milliseconds(10));
+  uint32_t estimate = estimator->getEstimate();
+
+  sendPackets(200, std::chrono::milliseconds(15));
+
+  EXPECT_THAT(estimator->getEstimate(), Lt(estimate));
+}
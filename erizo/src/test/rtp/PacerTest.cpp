@@ -0,0 +1,165 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/Pacer.h>
+#include <rtp/RtpHeaders.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <vector>
+
+using testing::Eq;
+using testing::Ge;
+using testing::Gt;
+using testing::Lt;
+using erizo::DataPacket;
+using erizo::Pacer;
+using erizo::RtpHeader;
+using erizo::SimulatedClock;
+
+static constexpr uint64_t kEstimatedBitrate = 800000;
+static constexpr int kPacketSize = 1000;
+
+static std::shared_ptr<DataPacket> createPacket(erizo::packetType type, int length = kPacketSize) {
+  char buffer[kPacketSize] = {0};
+  return std::make_shared<DataPacket>(0, buffer, length, type);
+}
+
+static std::shared_ptr<DataPacket> createVideoPacket(uint32_t timestamp, bool is_keyframe = false) {
+  auto packet = createPacket(erizo::VIDEO_PACKET);
+  reinterpret_cast<RtpHeader*>(packet->data)->setTimestamp(timestamp);
+  packet->is_keyframe = is_keyframe;
+  return packet;
+}
+
+class PacerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    pacer = std::make_shared<Pacer>([this] (std::shared_ptr<DataPacket> packet) {
+      sent_packets.push_back(packet);
+    }, [this] (uint32_t bytes) {
+      padding_requests.push_back(bytes);
+    }, clock);
+    pacer->setEstimatedBitrate(kEstimatedBitrate);
+  }
+
+  void processFor(std::chrono::milliseconds time) {
+    for (auto elapsed = std::chrono::milliseconds(0); elapsed < time; elapsed += std::chrono::milliseconds(5)) {
+      clock->advanceTime(std::chrono::milliseconds(5));
+      pacer->process();
+    }
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<Pacer> pacer;
+  std::vector<std::shared_ptr<DataPacket>> sent_packets;
+  std::vector<uint32_t> padding_requests;
+};
+
+TEST_F(PacerTest, shouldSendAudioWithoutBudget) {
+  pacer->enqueue(createPacket(erizo::AUDIO_PACKET));
+  pacer->process();
+
+  EXPECT_THAT(sent_packets.size(), Eq(1u));
+  EXPECT_FALSE(pacer->hasPendingWork());
+}
+
+TEST_F(PacerTest, shouldSpreadVideoBurstsOverTime) {
+  for (int i = 0; i < 20; i++) {
+    pacer->enqueue(createPacket(erizo::VIDEO_PACKET));
+  }
+
+  processFor(std::chrono::milliseconds(5));
+  EXPECT_THAT(sent_packets.size(), Gt(0u));
+  EXPECT_THAT(sent_packets.size(), Lt(20u));
+
+  processFor(std::chrono::milliseconds(100));
+  EXPECT_THAT(sent_packets.size(), Eq(20u));
+}
+
+TEST_F(PacerTest, shouldSendRetransmissionsBeforeVideo) {
+  pacer->enqueue(createPacket(erizo::VIDEO_PACKET));
+  auto retransmission = createPacket(erizo::VIDEO_PACKET);
+  retransmission->is_retransmission = true;
+  pacer->enqueue(retransmission);
+
+  processFor(std::chrono::milliseconds(5));
+
+  ASSERT_THAT(sent_packets.size(), Ge(1u));
+  EXPECT_TRUE(sent_packets[0]->is_retransmission);
+}
+
+TEST_F(PacerTest, shouldSendKeyframesQueuedForTooLong) {
+  pacer->setEstimatedBitrate(0);
+  pacer->enqueue(createVideoPacket(1000, true));
+  pacer->enqueue(createVideoPacket(1000));
+
+  processFor(std::chrono::milliseconds(100));
+  EXPECT_THAT(sent_packets.size(), Eq(0u));
+
+  clock->advanceTime(Pacer::kMaxQueueDelay);
+  pacer->process();
+  EXPECT_THAT(sent_packets.size(), Eq(2u));
+  EXPECT_THAT(pacer->getDroppedPackets(), Eq(0u));
+}
+
+TEST_F(PacerTest, shouldDropOtherVideoQueuedForTooLong) {
+  pacer->setEstimatedBitrate(0);
+  pacer->enqueue(createVideoPacket(1000));
+  auto retransmission = createVideoPacket(1000);
+  retransmission->is_retransmission = true;
+  pacer->enqueue(retransmission);
+  clock->advanceTime(Pacer::kMaxQueueDelay);
+  pacer->enqueue(createVideoPacket(2000));
+
+  pacer->process();
+
+  EXPECT_THAT(sent_packets.size(), Eq(0u));
+  EXPECT_THAT(pacer->getDroppedPackets(), Eq(2u));
+  EXPECT_THAT(pacer->getQueueSize(), Eq(1u));
+}
+
+TEST_F(PacerTest, shouldNotHoldAudioBackWhileVideoIsDelayed) {
+  pacer->setEstimatedBitrate(0);
+  pacer->enqueue(createVideoPacket(1000));
+  pacer->enqueue(createPacket(erizo::AUDIO_PACKET));
+
+  pacer->process();
+
+  ASSERT_THAT(sent_packets.size(), Eq(1u));
+  EXPECT_THAT(sent_packets[0]->type, Eq(erizo::AUDIO_PACKET));
+}
+
+TEST_F(PacerTest, shouldRequestPaddingWhenIdle) {
+  pacer->setPaddingBitrate(100000);
+
+  processFor(std::chrono::milliseconds(100));
+
+  ASSERT_THAT(padding_requests.size(), Ge(1u));
+  EXPECT_THAT(padding_requests[0], Ge(Pacer::kMinPaddingRequestBytes));
+}
+
+TEST_F(PacerTest, shouldNotRequestPaddingWhileVideoIsQueued) {
+  pacer->setEstimatedBitrate(0);
+  pacer->setPaddingBitrate(100000);
+  pacer->enqueue(createPacket(erizo::VIDEO_PACKET));
+
+  processFor(std::chrono::milliseconds(100));
+
+  EXPECT_THAT(padding_requests.size(), Eq(0u));
+}
+
+TEST_F(PacerTest, shouldSendPaddingAfterMedia) {
+  auto padding = createPacket(erizo::VIDEO_PACKET, 200);
+  padding->is_padding = true;
+  pacer->enqueue(padding);
+  pacer->enqueue(createPacket(erizo::VIDEO_PACKET));
+
+  processFor(std::chrono::milliseconds(20));
+
+  ASSERT_THAT(sent_packets.size(), Eq(2u));
+  EXPECT_FALSE(sent_packets[0]->is_padding);
+  EXPECT_TRUE(sent_packets[1]->is_padding);
+}
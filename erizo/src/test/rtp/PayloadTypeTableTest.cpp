@@ -0,0 +1,46 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/PayloadTypeTable.h>
+
+#include <string>
+#include <vector>
+
+using testing::Eq;
+using testing::StrEq;
+using erizo::PayloadTypeTable;
+using erizo::RtpCodec;
+using erizo::RtpMap;
+
+TEST(PayloadTypeTableTest, shouldIdentifyCodecsOfNegotiatedPayloadTypes) {
+  std::vector<RtpMap> rtp_maps;
+  rtp_maps.push_back({96, "VP8", 90000});
+  rtp_maps.push_back({98, "VP9", 90000});
+  rtp_maps.push_back({100, "H264", 90000});
+  rtp_maps.push_back({111, "opus", 48000});
+  PayloadTypeTable table{rtp_maps};
+
+  EXPECT_THAT(table.get(96).codec, Eq(RtpCodec::VP8));
+  EXPECT_THAT(table.get(98).codec, Eq(RtpCodec::VP9));
+  EXPECT_THAT(table.get(100).codec, Eq(RtpCodec::H264));
+  EXPECT_THAT(table.get(111).codec, Eq(RtpCodec::OPUS));
+  EXPECT_THAT(table.get(111).clock_rate, Eq(48000u));
+}
+
+TEST(PayloadTypeTableTest, shouldReturnUnknownForOtherPayloadTypes) {
+  std::vector<RtpMap> rtp_maps;
+  rtp_maps.push_back({96, "VP8", 90000});
+  rtp_maps.push_back({103, "ISAC", 16000});
+  PayloadTypeTable table{rtp_maps};
+
+  EXPECT_THAT(table.get(97).codec, Eq(RtpCodec::UNKNOWN));
+  EXPECT_THAT(table.get(97).clock_rate, Eq(0u));
+  EXPECT_THAT(table.get(103).codec, Eq(RtpCodec::UNKNOWN));
+  EXPECT_THAT(table.get(103).clock_rate, Eq(16000u));
+}
+
+TEST(PayloadTypeTableTest, shouldMatchEncodingNamesIgnoringCase) {
+  EXPECT_THAT(PayloadTypeTable::getCodec("rtx"), Eq(RtpCodec::RTX));
+  EXPECT_THAT(PayloadTypeTable::getCodec("RED"), Eq(RtpCodec::RED));
+  EXPECT_THAT(PayloadTypeTable::getCodecName(RtpCodec::VP8), StrEq("VP8"));
+}
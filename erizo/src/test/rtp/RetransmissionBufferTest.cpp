@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/RetransmissionBuffer.h>
+#include <rtp/PacketBufferService.h>
+#include <rtp/RtpHeaders.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+
+using testing::Eq;
+using testing::Ge;
+using testing::IsNull;
+using testing::NotNull;
+using erizo::DataPacket;
+using erizo::PacketBufferService;
+using erizo::PacketBufferStats;
+using erizo::RetransmissionBuffer;
+using erizo::RtpHeader;
+using erizo::SimulatedClock;
+
+static constexpr uint32_t kSsrc = 1111;
+static constexpr uint32_t kOtherSsrc = 2222;
+static constexpr std::chrono::milliseconds kRetentionTime{1000};
+
+static std::shared_ptr<DataPacket> createPacket(uint32_t ssrc, uint16_t seq_num) {
+  RtpHeader header;
+  header.setSSRC(ssrc);
+  header.setSeqNumber(seq_num);
+  return std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header), sizeof(RtpHeader), erizo::VIDEO_PACKET);
+}
+
+class RetransmissionBufferTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    buffer = std::make_shared<RetransmissionBuffer>(clock, kRetentionTime);
+  }
+
+  void insertPackets(uint16_t first_seq_num, int count, std::chrono::milliseconds interval) {
+    for (int i = 0; i < count; i++) {
+      buffer->insert(createPacket(kSsrc, first_seq_num + i));
+      clock->advanceTime(interval);
+    }
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<RetransmissionBuffer> buffer;
+};
+
+TEST_F(RetransmissionBufferTest, shouldReturnInsertedPackets) {
+  insertPackets(10, 2, std::chrono::milliseconds(10));
+
+  EXPECT_THAT(buffer->get(10), NotNull());
+  EXPECT_THAT(buffer->get(11), NotNull());
+  EXPECT_THAT(buffer->get(12), IsNull());
+  EXPECT_THAT(buffer->get(10 + erizo::kRetransmissionBufferMinCapacity), IsNull());
+}
+
+TEST_F(RetransmissionBufferTest, shouldGrow_whenPacketsAreStillRetained) {
+  insertPackets(65500, 100, std::chrono::milliseconds(1));
+
+  EXPECT_THAT(buffer->capacity(), Ge(100u));
+  for (uint16_t i = 0; i < 100; i++) {
+    EXPECT_THAT(buffer->get(65500 + i), NotNull());
+  }
+}
+
+TEST_F(RetransmissionBufferTest, shouldNotGrow_whenOverwrittenPacketsAreExpired) {
+  insertPackets(0, 100, std::chrono::milliseconds(100));
+
+  EXPECT_THAT(buffer->capacity(), Eq(erizo::kRetransmissionBufferMinCapacity));
+  EXPECT_THAT(buffer->get(99), NotNull());
+}
+
+TEST_F(RetransmissionBufferTest, shouldNotGrowOverTheMaxCapacity) {
+  insertPackets(0, erizo::kRetransmissionBufferMaxCapacity + 10, std::chrono::milliseconds(0));
+
+  EXPECT_THAT(buffer->capacity(), Eq(erizo::kRetransmissionBufferMaxCapacity));
+  EXPECT_THAT(buffer->get(erizo::kRetransmissionBufferMaxCapacity + 9), NotNull());
+}
+
+TEST_F(RetransmissionBufferTest, shouldReleasePacketsOlderThanTheRetentionTime) {
+  insertPackets(0, 5, std::chrono::milliseconds(10));
+  clock->advanceTime(kRetentionTime);
+
+  insertPackets(5, 1, std::chrono::milliseconds(10));
+
+  EXPECT_THAT(buffer->get(0), IsNull());
+  EXPECT_THAT(buffer->get(4), IsNull());
+  EXPECT_THAT(buffer->get(5), NotNull());
+  EXPECT_THAT(buffer->size(), Eq(1u));
+}
+
+TEST_F(RetransmissionBufferTest, getAge_shouldReturnTheTimeSinceInsertion) {
+  insertPackets(0, 1, std::chrono::milliseconds(30));
+
+  EXPECT_THAT(buffer->getAge(0), Eq(std::chrono::milliseconds(30)));
+}
+
+class PacketBufferServiceTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    service = std::make_shared<PacketBufferService>(clock);
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<PacketBufferService> service;
+};
+
+TEST_F(PacketBufferServiceTest, shouldKeepPacketsFromEachSsrcApart) {
+  service->insertPacket(createPacket(kSsrc, 10));
+  service->insertPacket(createPacket(kOtherSsrc, 10));
+
+  std::shared_ptr<DataPacket> packet = service->getPacket(kSsrc, 10);
+  std::shared_ptr<DataPacket> other_packet = service->getPacket(kOtherSsrc, 10);
+
+  ASSERT_THAT(packet, NotNull());
+  ASSERT_THAT(other_packet, NotNull());
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(packet->data)->getSSRC(), Eq(kSsrc));
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(other_packet->data)->getSSRC(), Eq(kOtherSsrc));
+}
+
+TEST_F(PacketBufferServiceTest, getPacketToRetransmit_shouldCountHitsMissesAndAge) {
+  service->insertPacket(createPacket(kSsrc, 10));
+  clock->advanceTime(std::chrono::milliseconds(40));
+
+  EXPECT_THAT(service->getPacketToRetransmit(kSsrc, 10), NotNull());
+  EXPECT_THAT(service->getPacketToRetransmit(kSsrc, 11), IsNull());
+  EXPECT_THAT(service->getPacketToRetransmit(kOtherSsrc, 10), IsNull());
+
+  PacketBufferStats stats = service->getStats();
+  EXPECT_THAT(stats.hits, Eq(1u));
+  EXPECT_THAT(stats.misses, Eq(2u));
+  EXPECT_THAT(stats.max_age_ms, Eq(40u));
+  EXPECT_THAT(stats.buffered_packets, Eq(1u));
+}
+
+TEST_F(PacketBufferServiceTest, setRtt_shouldKeepPacketsForSeveralRtts) {
+  service->setRtt(std::chrono::milliseconds(300));
+  EXPECT_THAT(service->getRetentionTime(), Eq(std::chrono::milliseconds(1200)));
+
+  service->setRtt(std::chrono::milliseconds(1));
+  EXPECT_THAT(service->getRetentionTime(), Eq(erizo::kMinPacketRetentionTime));
+
+  service->setRtt(std::chrono::seconds(5));
+  EXPECT_THAT(service->getRetentionTime(), Eq(erizo::kMaxPacketRetentionTime));
+}
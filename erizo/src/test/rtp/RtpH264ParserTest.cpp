@@ -0,0 +1,61 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/RtpH264Parser.h>
+#include <rtp/RtpHeaders.h>
+
+#include <memory>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+
+using testing::Eq;
+using erizo::DataPacket;
+using erizo::PacketTools;
+using erizo::RtpH264Parser;
+using erizo::RtpHeader;
+using erizo::RTPPayloadH264;
+
+static constexpr uint16_t kSeqNumber = 44444;
+static constexpr unsigned char kNalLength = 100;
+static constexpr int kStapAHeaderLength = 1;
+static constexpr int kNalSizeLength = 2;
+static constexpr unsigned char kIdrNalHeader = 0x65;
+
+class RtpH264ParserTest : public ::testing::Test {
+ protected:
+  RTPPayloadH264 parse(std::shared_ptr<DataPacket> packet) {
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+    return parser.parseH264(reinterpret_cast<unsigned char*>(packet->data) + head->getHeaderLength(),
+                            packet->length - head->getHeaderLength());
+  }
+
+  // Header of the nal_index NAL aggregated in a STAP-A packet created with NALs of kNalLength bytes
+  unsigned char* aggregatedNalHeader(std::shared_ptr<DataPacket> packet, int nal_index) {
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+    int offset = head->getHeaderLength() + kStapAHeaderLength + kNalSizeLength +
+        nal_index * (kNalLength + kNalSizeLength);
+    return reinterpret_cast<unsigned char*>(packet->data) + offset;
+  }
+
+  RtpH264Parser parser;
+};
+
+TEST_F(RtpH264ParserTest, shouldNotDetectKeyframesInAggregatedPacketsWithoutIdr) {
+  auto packet = PacketTools::createH264AggregatedPacket(kSeqNumber, 0, kNalLength, kNalLength);
+
+  RTPPayloadH264 payload = parse(packet);
+
+  EXPECT_THAT(payload.nal_type, Eq(erizo::aggregated));
+  EXPECT_THAT(payload.frameType, Eq(erizo::kH264PFrame));
+}
+
+TEST_F(RtpH264ParserTest, shouldDetectKeyframesInAggregatedPacketsWithIdr) {
+  auto packet = PacketTools::createH264AggregatedPacket(kSeqNumber, 0, kNalLength, kNalLength);
+  *aggregatedNalHeader(packet, 1) = kIdrNalHeader;
+
+  RTPPayloadH264 payload = parse(packet);
+
+  EXPECT_THAT(payload.nal_type, Eq(erizo::aggregated));
+  EXPECT_THAT(payload.frameType, Eq(erizo::kH264IFrame));
+}
@@ -28,6 +28,7 @@ using erizo::MovingIntervalRateStat;
 using erizo::IceConfig;
 using erizo::RtpMap;
 using erizo::RtpPaddingGeneratorHandler;
+using erizo::PaddingRequestEvent;
 using erizo::WebRtcConnection;
 using erizo::Pipeline;
 using erizo::InboundHandler;
@@ -80,13 +81,15 @@ TEST_F(RtpPaddingGeneratorHandlerTest, basicBehaviourShouldWritePackets) {
   pipeline->write(packet);
 }
 
-TEST_F(RtpPaddingGeneratorHandlerTest, shouldSendPaddingWhenEnabled) {
+TEST_F(RtpPaddingGeneratorHandlerTest, shouldSendPaddingWhenRequested) {
   EXPECT_CALL(*writer.get(), write(_, _)).Times(AtLeast(3));
 
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true));
 
   clock->advanceTime(std::chrono::milliseconds(200));
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true));
+
+  pipeline->notifyEvent(std::make_shared<PaddingRequestEvent>(500));
 }
 
 TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingWhenDisabled) {
@@ -98,15 +101,30 @@ TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingWhenDisabled) {
 
   clock->advanceTime(std::chrono::milliseconds(200));
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true));
+
+  pipeline->notifyEvent(std::make_shared<PaddingRequestEvent>(500));
 }
 
-TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingAfterNotMarkers) {
+TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingIfNotRequested) {
   EXPECT_CALL(*writer.get(), write(_, _)).Times(2);
 
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true));
 
   clock->advanceTime(std::chrono::milliseconds(200));
-  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, false));
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true));
+}
+
+TEST_F(RtpPaddingGeneratorHandlerTest, shouldMarkPaddingPacketsForThePacer) {
+  EXPECT_CALL(*writer.get(), write(_, _)).Times(AtLeast(2));
+  EXPECT_CALL(*writer.get(), write(_, _)).
+    With(Args<1>(erizo::PacketIsPadding())).Times(AtLeast(1));
+
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true));
+
+  clock->advanceTime(std::chrono::milliseconds(200));
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true));
+
+  pipeline->notifyEvent(std::make_shared<PaddingRequestEvent>(500));
 }
 
 TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingIfBitrateIsHigherThanBitrateEstimation) {
@@ -124,4 +142,6 @@ TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingIfBitrateIsHigherThan
   clock->advanceTime(std::chrono::milliseconds(1000));
 
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true));
+
+  pipeline->notifyEvent(std::make_shared<PaddingRequestEvent>(500));
 }
@@ -1,7 +1,6 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <thread/Scheduler.h>
 #include <rtp/RtpRetransmissionHandler.h>
 #include <rtp/RtpHeaders.h>
 #include <stats/StatNode.h>
@@ -18,6 +17,7 @@
 using ::testing::_;
 using ::testing::IsNull;
 using ::testing::Args;
+using ::testing::AllOf;
 using ::testing::Return;
 using erizo::DataPacket;
 using erizo::packetType;
@@ -26,6 +26,7 @@ using erizo::VIDEO_PACKET;
 using erizo::IceConfig;
 using erizo::RtpMap;
 using erizo::RtpRetransmissionHandler;
+using erizo::kRetransmissionBufferMinCapacity;
 using erizo::WebRtcConnection;
 using erizo::Pipeline;
 using erizo::InboundHandler;
@@ -126,14 +127,15 @@ TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingWithSe
 TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingWithSeqNumBeforeBufferRollover) {
     uint ssrc = media_stream->getVideoSourceSSRC();
     uint source_ssrc = media_stream->getVideoSinkSSRC();
-    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, kRetransmissionsBufferSize - 1, VIDEO_PACKET);
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, kRetransmissionBufferMinCapacity - 1,
+                                                      VIDEO_PACKET);
 
     EXPECT_CALL(*writer.get(), write(_, _)).
-        With(Args<1>(erizo::RtpHasSequenceNumber(kRetransmissionsBufferSize))).Times(1);
+        With(Args<1>(erizo::RtpHasSequenceNumber(kRetransmissionBufferMinCapacity))).Times(1);
     EXPECT_CALL(*writer.get(), write(_, _)).
-        With(Args<1>(erizo::RtpHasSequenceNumber(kRetransmissionsBufferSize - 1))).Times(2);
-    pipeline->write(erizo::PacketTools::createDataPacket(kRetransmissionsBufferSize - 1, VIDEO_PACKET));
-    pipeline->write(erizo::PacketTools::createDataPacket(kRetransmissionsBufferSize, VIDEO_PACKET));
+        With(Args<1>(erizo::RtpHasSequenceNumber(kRetransmissionBufferMinCapacity - 1))).Times(2);
+    pipeline->write(erizo::PacketTools::createDataPacket(kRetransmissionBufferMinCapacity - 1, VIDEO_PACKET));
+    pipeline->write(erizo::PacketTools::createDataPacket(kRetransmissionBufferMinCapacity, VIDEO_PACKET));
 
     EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
     pipeline->read(nack_packet);
@@ -154,3 +156,22 @@ TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingNackWi
     EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
     pipeline->read(nack_packet);
 }
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPacketsOverRtx_whenRtxIsNegotiated) {
+    const uint32_t kRtxSsrc = 4444;
+    const uint16_t kRtxSequenceNumber = 100;
+    packet_buffer_service->setVideoRtx(kRtxSsrc, {{0, 96}}, kRtxSequenceNumber);
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber))).Times(1);
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(AllOf(erizo::RtpHasSequenceNumber(kRtxSequenceNumber), erizo::RtpPacketHasSsrc(kRtxSsrc)))).
+      Times(1);
+    pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+
+    EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
+    pipeline->read(nack_packet);
+}
@@ -0,0 +1,102 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/RtxReceiverHandler.h>
+#include <rtp/RtpHeaders.h>
+#include <rtp/RtpUtils.h>
+#include <MediaDefinitions.h>
+#include <WebRtcConnection.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+#include "../utils/Matchers.h"
+
+using ::testing::_;
+using ::testing::AllOf;
+using ::testing::Args;
+using erizo::DataPacket;
+using erizo::RtpHeader;
+using erizo::RtpMap;
+using erizo::RtpUtils;
+using erizo::RtxReceiverHandler;
+using erizo::VIDEO_PACKET;
+using erizo::VIDEO_TYPE;
+
+static constexpr uint32_t kRtxSsrc = 4444;
+static constexpr uint8_t kRtxPayloadType = 96;
+static constexpr uint8_t kMediaPayloadType = 100;
+
+class RtxReceiverHandlerTest : public erizo::HandlerTest {
+ public:
+  RtxReceiverHandlerTest() {}
+
+ protected:
+  void setHandler() {
+    RtpMap rtx_map;
+    rtx_map.payload_type = kRtxPayloadType;
+    rtx_map.encoding_name = "rtx";
+    rtx_map.media_type = VIDEO_TYPE;
+    rtx_map.format_parameters["apt"] = std::to_string(kMediaPayloadType);
+    media_stream->getRemoteSdpInfo()->payloadVector.push_back(rtx_map);
+    media_stream->setVideoSourceRtxSSRCMap(std::map<uint32_t, uint32_t>{{kRtxSsrc, erizo::kVideoSsrc}});
+
+    rtx_handler = std::make_shared<RtxReceiverHandler>();
+    pipeline->addBack(rtx_handler);
+  }
+
+  std::shared_ptr<DataPacket> createRtxPacket(uint16_t original_sequence_number, uint16_t rtx_sequence_number) {
+    auto packet = erizo::PacketTools::createVP8Packet(original_sequence_number, true, true);
+    reinterpret_cast<RtpHeader*>(packet->data)->setPayloadType(kMediaPayloadType);
+    return RtpUtils::makeRtxPacket(packet, kRtxSsrc, kRtxPayloadType, rtx_sequence_number);
+  }
+
+  std::shared_ptr<RtxReceiverHandler> rtx_handler;
+};
+
+TEST_F(RtxReceiverHandlerTest, basicBehaviourShouldReadPackets) {
+  auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+  EXPECT_CALL(*reader.get(), read(_, _)).
+    With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber))).Times(1);
+  pipeline->read(packet);
+}
+
+TEST_F(RtxReceiverHandlerTest, shouldRestoreTheOriginalPacket) {
+  EXPECT_CALL(*reader.get(), read(_, _)).
+    With(Args<1>(AllOf(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber),
+                       erizo::RtpPacketHasSsrc(erizo::kVideoSsrc)))).Times(1);
+
+  pipeline->read(createRtxPacket(erizo::kArbitrarySeqNumber, 1000));
+}
+
+TEST_F(RtxReceiverHandlerTest, shouldDropPaddingOnlyRtxPackets) {
+  auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  header->setSSRC(kRtxSsrc);
+  header->setPayloadType(kRtxPayloadType);
+  auto padding_packet = RtpUtils::makePaddingPacket(packet, 200);
+
+  EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
+  pipeline->read(padding_packet);
+}
+
+TEST(RtxPacketTest, shouldRecoverTheSamePacketAfterEncapsulation) {
+  auto packet = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true);
+  reinterpret_cast<RtpHeader*>(packet->data)->setPayloadType(kMediaPayloadType);
+
+  auto rtx_packet = RtpUtils::makeRtxPacket(packet, kRtxSsrc, kRtxPayloadType, 1000);
+  ASSERT_TRUE(rtx_packet.get() != nullptr);
+  RtpHeader *rtx_header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  EXPECT_EQ(rtx_header->getSSRC(), kRtxSsrc);
+  EXPECT_EQ(rtx_header->getSeqNumber(), 1000);
+  EXPECT_EQ(rtx_packet->length, packet->length + 2);
+
+  auto recovered = RtpUtils::makePacketFromRtx(rtx_packet, erizo::kVideoSsrc, kMediaPayloadType);
+  ASSERT_TRUE(recovered.get() != nullptr);
+  ASSERT_EQ(recovered->length, packet->length);
+  EXPECT_EQ(memcmp(recovered->data, packet->data, packet->length), 0);
+}
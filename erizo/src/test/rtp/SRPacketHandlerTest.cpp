@@ -1,7 +1,6 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <thread/Scheduler.h>
 #include <rtp/SRPacketHandler.h>
 #include <rtp/RtpHeaders.h>
 #include <MediaDefinitions.h>
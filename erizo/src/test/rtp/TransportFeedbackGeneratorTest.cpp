@@ -0,0 +1,99 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/TransportFeedbackGenerator.h>
+#include <rtp/RtpHeaders.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+using testing::Eq;
+using testing::IsNull;
+using testing::NotNull;
+using erizo::DataPacket;
+using erizo::RtcpHeader;
+using erizo::SimulatedClock;
+using erizo::TransportFeedbackGenerator;
+using webrtc::rtcp::TransportFeedback;
+
+class TransportFeedbackGeneratorTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    generator = std::make_shared<TransportFeedbackGenerator>(clock);
+  }
+
+  std::unique_ptr<TransportFeedback> parse(std::shared_ptr<DataPacket> packet) {
+    return TransportFeedback::ParseFrom(reinterpret_cast<uint8_t*>(packet->data), packet->length);
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<TransportFeedbackGenerator> generator;
+};
+
+TEST_F(TransportFeedbackGeneratorTest, shouldNotGenerateFeedback_WhenNoPacketsAreReceived) {
+  EXPECT_THAT(generator->generateFeedback(), IsNull());
+}
+
+TEST_F(TransportFeedbackGeneratorTest, shouldReportReceivedPacketsInOrder) {
+  generator->onPacketReceived(11, 1111, 2222);
+  clock->advanceTime(std::chrono::milliseconds(5));
+  generator->onPacketReceived(10, 1111, 2222);
+  clock->advanceTime(std::chrono::milliseconds(5));
+  generator->onPacketReceived(12, 1111, 2222);
+
+  std::shared_ptr<DataPacket> packet = generator->generateFeedback();
+
+  ASSERT_THAT(packet, NotNull());
+  EXPECT_TRUE(reinterpret_cast<RtcpHeader*>(packet->data)->isTransportFeedback());
+  std::unique_ptr<TransportFeedback> feedback = parse(packet);
+  ASSERT_THAT(feedback.get(), NotNull());
+  EXPECT_THAT(feedback->GetBaseSequence(), Eq(10));
+  EXPECT_THAT(feedback->media_ssrc(), Eq(1111u));
+  EXPECT_THAT(feedback->GetReceiveDeltasUs().size(), Eq(3u));
+  EXPECT_FALSE(generator->hasPendingPackets());
+}
+
+TEST_F(TransportFeedbackGeneratorTest, shouldReportMissingPacketsAsNotReceived) {
+  generator->onPacketReceived(10, 1111, 2222);
+  generator->onPacketReceived(13, 1111, 2222);
+
+  std::unique_ptr<TransportFeedback> feedback = parse(generator->generateFeedback());
+
+  ASSERT_THAT(feedback.get(), NotNull());
+  std::vector<TransportFeedback::StatusSymbol> statuses = feedback->GetStatusVector();
+  ASSERT_THAT(statuses.size(), Eq(4u));
+  EXPECT_THAT(statuses[1], Eq(TransportFeedback::StatusSymbol::kNotReceived));
+  EXPECT_THAT(statuses[2], Eq(TransportFeedback::StatusSymbol::kNotReceived));
+  EXPECT_THAT(feedback->GetReceiveDeltasUs().size(), Eq(2u));
+}
+
+TEST_F(TransportFeedbackGeneratorTest, shouldIgnorePacketsAlreadyReported) {
+  generator->onPacketReceived(10, 1111, 2222);
+  generator->onPacketReceived(12, 1111, 2222);
+  generator->generateFeedback();
+
+  generator->onPacketReceived(11, 1111, 2222);
+
+  EXPECT_FALSE(generator->hasPendingPackets());
+  EXPECT_THAT(generator->generateFeedback(), IsNull());
+}
+
+TEST_F(TransportFeedbackGeneratorTest, shouldKeepPacketsThatDoNotFitForTheNextFeedback) {
+  for (uint16_t sequence_number = 0; sequence_number < TransportFeedbackGenerator::kMaxPacketsPerFeedback + 10;
+       sequence_number++) {
+    generator->onPacketReceived(sequence_number, 1111, 2222);
+  }
+
+  EXPECT_THAT(generator->generateFeedback(), NotNull());
+  EXPECT_TRUE(generator->hasPendingPackets());
+
+  std::unique_ptr<TransportFeedback> feedback = parse(generator->generateFeedback());
+  ASSERT_THAT(feedback.get(), NotNull());
+  EXPECT_THAT(feedback->GetBaseSequence(), Eq(TransportFeedbackGenerator::kMaxPacketsPerFeedback));
+  EXPECT_THAT(feedback->GetReceiveDeltasUs().size(), Eq(10u));
+}
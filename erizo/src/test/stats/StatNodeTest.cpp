@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include "../utils/Mocks.h"
 #include "../utils/Tools.h"
@@ -25,6 +26,7 @@ using erizo::RateStat;
 using erizo::MovingIntervalRateStat;
 using erizo::MovingAverageStat;
 using erizo::CumulativeStat;
+using erizo::GaugeStat;
 using erizo::SimulatedClock;
 
 class StatNodeTest : public ::testing::Test {
@@ -114,3 +116,63 @@ TEST_F(StatNodeTest, IntervalRateStatCanBeInserted) {
   EXPECT_THAT(root.toString(), Eq("{\"rate\":0}"));
 }
 
+
+TEST_F(StatNodeTest, GaugeStatKeepsTheLastValue) {
+  std::shared_ptr<GaugeStat> stat = root.insertStat("size", GaugeStat{10});
+  *stat = 3;
+
+  EXPECT_THAT(root.toString(), Eq("{\"size\":3}"));
+}
+
+TEST_F(StatNodeTest, insertedStatsCanBeUpdatedThroughTheirHandle) {
+  std::shared_ptr<CumulativeStat> stat = root["a"].insertStat("value", CumulativeStat{1});
+  *stat += 10;
+
+  EXPECT_THAT(root.toString(), Eq("{\"a\":{\"value\":11}}"));
+}
+
+TEST_F(StatNodeTest, getOrInsertStatShouldReturnTheExistingStat) {
+  std::shared_ptr<CumulativeStat> first = root.getOrInsertStat("value", CumulativeStat{1});
+  std::shared_ptr<CumulativeStat> second = root.getOrInsertStat("value", CumulativeStat{5});
+
+  EXPECT_THAT(second, Eq(first));
+  EXPECT_THAT(root.toString(), Eq("{\"value\":1}"));
+}
+
+TEST_F(StatNodeTest, getOrInsertStatShouldReplaceStatsOfADifferentType) {
+  root.insertStat("value", StringStat{"text"});
+
+  std::shared_ptr<CumulativeStat> stat = root.getOrInsertStat("value", CumulativeStat{3});
+
+  EXPECT_THAT(root.toString(), Eq("{\"value\":3}"));
+}
+
+TEST_F(StatNodeTest, getStatShouldReturnNullForMissingStats) {
+  EXPECT_THAT(root.getStat("value"), IsNull());
+
+  root.insertStat("value", CumulativeStat{3});
+
+  EXPECT_THAT(root.getStat("value")->value(), Eq(3u));
+}
+
+TEST_F(StatNodeTest, collectValuesShouldReportNumericStatsWithTheirPath) {
+  root["1234"].insertStat("packets", CumulativeStat{3});
+  root.insertStat("type", StringStat{"video"});
+  std::string path;
+  std::vector<erizo::StatValue> values;
+
+  root.collectValues(&path, &values);
+
+  ASSERT_THAT(values.size(), Eq(1u));
+  EXPECT_THAT(values[0].path, Eq("1234.packets"));
+  EXPECT_THAT(values[0].value, Eq(3u));
+  EXPECT_TRUE(path.empty());
+}
+
+TEST_F(StatNodeTest, insertStatShouldUpdateTheExistingStatInPlace) {
+  std::shared_ptr<CumulativeStat> first = root.insertStat("value", CumulativeStat{1});
+  std::shared_ptr<CumulativeStat> second = root.insertStat("value", CumulativeStat{5});
+
+  EXPECT_THAT(second, Eq(first));
+  EXPECT_THAT(first->value(), Eq(5u));
+}
@@ -0,0 +1,124 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <stats/StatsBatcher.h>
+#include <MediaStream.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+
+using ::testing::Eq;
+using erizo::StatsBatcher;
+using erizo::StatsConsumer;
+using erizo::StatsCounter;
+using erizo::StatsDelta;
+using erizo::StatsKey;
+using erizo::StatValue;
+
+class StatsBatcherTest : public erizo::HandlerTest {
+ public:
+  StatsBatcherTest() : batches{0} {}
+
+ protected:
+  void setHandler() {
+    batcher = std::make_shared<StatsBatcher>();
+  }
+
+  void collect() {
+    batcher->collect(std::make_shared<StatsConsumer>(), [this](std::vector<StatsDelta> deltas) {
+      batches++;
+      received = std::move(deltas);
+    });
+  }
+
+  std::shared_ptr<StatsBatcher> batcher;
+  int batches;
+  std::vector<StatsDelta> received;
+};
+
+TEST_F(StatsBatcherTest, collect_ShouldCallBackRightAway_WhenThereAreNoStreams) {
+  collect();
+
+  EXPECT_THAT(batches, Eq(1));
+  EXPECT_TRUE(received.empty());
+}
+
+TEST_F(StatsBatcherTest, collect_ShouldCallBackOnce_WhenEveryStreamAnswered) {
+  batcher->addStream(media_stream);
+  collect();
+  EXPECT_THAT(batches, Eq(0));
+
+  simulated_worker->executeTasks();
+
+  EXPECT_THAT(batches, Eq(1));
+  EXPECT_TRUE(received.empty());
+}
+
+TEST_F(StatsBatcherTest, collect_ShouldForgetClosedStreams) {
+  batcher->addStream(std::make_shared<erizo::MockMediaStream>(simulated_worker, connection, "", "", rtp_maps));
+
+  collect();
+
+  EXPECT_THAT(batches, Eq(1));
+  EXPECT_THAT(batcher->getStreamCount(), Eq(0u));
+}
+
+TEST_F(StatsBatcherTest, serialize_ShouldWriteLittleEndianRecords) {
+  StatsDelta delta;
+  delta.stream_id = "ab";
+  delta.new_keys.push_back(StatsKey{1, "x"});
+  delta.counters.push_back(StatsCounter{1, 0x0102});
+  std::string buffer;
+
+  StatsBatcher::serialize({delta}, &buffer);
+
+  const char expected[] = {
+    1, 0, 0, 0,
+    2, 0, 'a', 'b',
+    1, 0, 0, 0,
+    1, 0, 0, 0, 1, 0, 'x',
+    1, 0, 0, 0,
+    1, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0};
+  EXPECT_THAT(buffer, Eq(std::string(expected, sizeof(expected))));
+}
+
+TEST(StatsConsumerTest, update_ShouldSendPathsOnlyTheFirstTime) {
+  StatsConsumer consumer;
+
+  StatsDelta first = consumer.update("a", {StatValue{"packets", 3}, StatValue{"bytes", 100}});
+  StatsDelta second = consumer.update("a", {StatValue{"packets", 4}, StatValue{"bytes", 100}});
+
+  ASSERT_THAT(first.new_keys.size(), Eq(2u));
+  EXPECT_THAT(first.counters.size(), Eq(2u));
+  EXPECT_TRUE(second.new_keys.empty());
+  ASSERT_THAT(second.counters.size(), Eq(1u));
+  EXPECT_THAT(second.counters[0].id, Eq(first.new_keys[0].id));
+  EXPECT_THAT(second.counters[0].value, Eq(4u));
+}
+
+TEST(StatsConsumerTest, update_ShouldSendPathsToEveryConsumer) {
+  StatsConsumer consumer;
+  StatsConsumer other_consumer;
+  consumer.update("a", {StatValue{"packets", 3}});
+
+  StatsDelta delta = other_consumer.update("a", {StatValue{"packets", 3}});
+
+  ASSERT_THAT(delta.new_keys.size(), Eq(1u));
+  EXPECT_THAT(delta.new_keys[0].path, Eq("packets"));
+  EXPECT_THAT(delta.counters.size(), Eq(1u));
+}
+
+TEST(StatsConsumerTest, keepStreams_ShouldForgetTheKeysOfOtherStreams) {
+  StatsConsumer consumer;
+  consumer.update("a", {StatValue{"packets", 3}});
+  consumer.update("b", {StatValue{"packets", 3}});
+
+  consumer.keepStreams({"b"});
+
+  EXPECT_THAT(consumer.update("a", {StatValue{"packets", 3}}).new_keys.size(), Eq(1u));
+  EXPECT_TRUE(consumer.update("b", {StatValue{"packets", 3}}).new_keys.empty());
+}
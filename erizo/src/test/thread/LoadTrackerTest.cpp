@@ -0,0 +1,87 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/LoadTracker.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+
+using testing::Eq;
+using testing::DoubleEq;
+using erizo::LoadTracker;
+using erizo::SimulatedClock;
+using erizo::WorkerLoad;
+
+class LoadTrackerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    tracker = std::make_shared<LoadTracker>(clock);
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<LoadTracker> tracker;
+};
+
+TEST_F(LoadTrackerTest, shouldNotComputeRatesBeforeTheWindowElapses) {
+  tracker->addTasks(10);
+  clock->advanceTime(std::chrono::milliseconds(500));
+
+  tracker->update();
+
+  EXPECT_THAT(tracker->getLoad().tasks_per_second, DoubleEq(0.));
+}
+
+TEST_F(LoadTrackerTest, shouldComputeRatesAndBusyFraction) {
+  tracker->addTasks(100);
+  tracker->addPackets(400);
+  tracker->addBusyTime(std::chrono::milliseconds(500));
+  clock->advanceTime(std::chrono::seconds(2));
+
+  tracker->update();
+
+  WorkerLoad load = tracker->getLoad();
+  EXPECT_THAT(load.tasks_per_second, DoubleEq(50.));
+  EXPECT_THAT(load.packets_per_second, DoubleEq(200.));
+  EXPECT_THAT(load.busy_fraction, DoubleEq(0.25));
+}
+
+TEST_F(LoadTrackerTest, shouldStartANewWindowAfterUpdating) {
+  tracker->addTasks(100);
+  clock->advanceTime(std::chrono::seconds(1));
+  tracker->update();
+  clock->advanceTime(std::chrono::seconds(1));
+
+  tracker->update();
+
+  EXPECT_THAT(tracker->getLoad().tasks_per_second, DoubleEq(0.));
+}
+
+TEST(WorkerLoadTest, compare_ShouldPreferLessBusyWorkers) {
+  WorkerLoad idle, busy;
+  busy.busy_fraction = 0.5;
+
+  EXPECT_THAT(idle.compare(busy), Eq(-1));
+  EXPECT_THAT(busy.compare(idle), Eq(1));
+}
+
+TEST(WorkerLoadTest, compare_ShouldUsePacketRate_WhenBusyTimeIsSimilar) {
+  WorkerLoad light, heavy;
+  light.busy_fraction = 0.1;
+  light.packets_per_second = 1000;
+  heavy.busy_fraction = 0.12;
+  heavy.packets_per_second = 5000;
+
+  EXPECT_THAT(light.compare(heavy), Eq(-1));
+}
+
+TEST(WorkerLoadTest, compare_ShouldReturnZero_WhenLoadsAreSimilar) {
+  WorkerLoad first, second;
+  first.busy_fraction = 0.1;
+  first.packets_per_second = 1000;
+  second.busy_fraction = 0.11;
+  second.packets_per_second = 1050;
+
+  EXPECT_THAT(first.compare(second), Eq(0));
+}
@@ -0,0 +1,141 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/TimerWheel.h>
+#include <lib/Clock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <vector>
+
+using testing::Eq;
+using testing::ElementsAre;
+using erizo::TimerWheel;
+using erizo::TimerWheelStats;
+using erizo::SimulatedClock;
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    clock = std::make_shared<SimulatedClock>();
+    wheel = std::make_shared<TimerWheel>(clock->now());
+  }
+
+  TimerWheel::Timer* scheduleFromNow(int id, std::chrono::milliseconds delta) {
+    return wheel->schedule([this, id] { executed.push_back(id); }, clock->now() + delta);
+  }
+
+  void advance(std::chrono::milliseconds delta) {
+    clock->advanceTime(delta);
+    wheel->advance(clock->now());
+  }
+
+  std::shared_ptr<SimulatedClock> clock;
+  std::shared_ptr<TimerWheel> wheel;
+  std::vector<int> executed;
+};
+
+TEST_F(TimerWheelTest, shouldNotRunTimersBeforeTheirDeadline) {
+  scheduleFromNow(1, std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(9));
+
+  EXPECT_TRUE(executed.empty());
+}
+
+TEST_F(TimerWheelTest, shouldRunTimersInDeadlineOrder) {
+  scheduleFromNow(3, std::chrono::milliseconds(30));
+  scheduleFromNow(1, std::chrono::milliseconds(10));
+  scheduleFromNow(2, std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(30));
+
+  EXPECT_THAT(executed, ElementsAre(1, 2, 3));
+  EXPECT_TRUE(wheel->empty());
+}
+
+TEST_F(TimerWheelTest, shouldRunTimersInUpperLevels) {
+  scheduleFromNow(1, std::chrono::milliseconds(100));
+  scheduleFromNow(2, std::chrono::seconds(10));
+  scheduleFromNow(3, std::chrono::minutes(10));
+
+  advance(std::chrono::milliseconds(99));
+  EXPECT_TRUE(executed.empty());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_THAT(executed, ElementsAre(1));
+  advance(std::chrono::seconds(10));
+  EXPECT_THAT(executed, ElementsAre(1, 2));
+  advance(std::chrono::minutes(10));
+  EXPECT_THAT(executed, ElementsAre(1, 2, 3));
+}
+
+TEST_F(TimerWheelTest, shouldRunTimersOutOfTheWheelRange) {
+  scheduleFromNow(1, std::chrono::hours(10));
+
+  advance(std::chrono::hours(5));
+  EXPECT_TRUE(executed.empty());
+  advance(std::chrono::hours(5));
+
+  EXPECT_THAT(executed, ElementsAre(1));
+}
+
+TEST_F(TimerWheelTest, cancel_ShouldRemoveTheTimer) {
+  TimerWheel::Timer *timer = scheduleFromNow(1, std::chrono::milliseconds(10));
+  scheduleFromNow(2, std::chrono::milliseconds(10));
+
+  wheel->cancel(timer);
+  advance(std::chrono::milliseconds(10));
+
+  EXPECT_THAT(executed, ElementsAre(2));
+  EXPECT_THAT(wheel->getStats().cancelled_timers, Eq(1u));
+}
+
+TEST_F(TimerWheelTest, cancel_ShouldReleaseTheTask) {
+  auto resource = std::make_shared<int>(0);
+  TimerWheel::Timer *timer = wheel->schedule([resource] {}, clock->now() + std::chrono::seconds(1));
+
+  wheel->cancel(timer);
+
+  EXPECT_THAT(resource.use_count(), Eq(1));
+}
+
+TEST_F(TimerWheelTest, shouldDelayTimersAddedWhileRunningToTheNextTick) {
+  wheel->schedule([this] {
+    executed.push_back(1);
+    scheduleFromNow(2, std::chrono::milliseconds(0));
+  }, clock->now());
+
+  advance(std::chrono::milliseconds(0));
+  EXPECT_THAT(executed, ElementsAre(1));
+  advance(std::chrono::milliseconds(1));
+
+  EXPECT_THAT(executed, ElementsAre(1, 2));
+}
+
+TEST_F(TimerWheelTest, getNextWakeUp_ShouldReturnTheEarliestDeadline) {
+  EXPECT_THAT(wheel->getNextWakeUp(), Eq(erizo::time_point::max()));
+
+  scheduleFromNow(1, std::chrono::milliseconds(20));
+  scheduleFromNow(2, std::chrono::milliseconds(5));
+
+  EXPECT_THAT(wheel->getNextWakeUp(), Eq(clock->now() + std::chrono::milliseconds(5)));
+}
+
+TEST_F(TimerWheelTest, getNextWakeUp_ShouldNotBeLaterThanTheDeadline) {
+  scheduleFromNow(1, std::chrono::seconds(5));
+
+  EXPECT_LE(wheel->getNextWakeUp(), clock->now() + std::chrono::seconds(5));
+}
+
+TEST_F(TimerWheelTest, getStats_ShouldMeasureLateness) {
+  scheduleFromNow(1, std::chrono::milliseconds(10));
+  scheduleFromNow(2, std::chrono::milliseconds(20));
+
+  advance(std::chrono::milliseconds(30));
+
+  TimerWheelStats stats = wheel->getStats();
+  EXPECT_THAT(stats.fired_timers, Eq(2u));
+  EXPECT_THAT(stats.max_lateness_us, Eq(20000u));
+  EXPECT_THAT(stats.getAverageLatenessUs(), Eq(15000.));
+  EXPECT_THAT(stats.pending_timers, Eq(0u));
+}
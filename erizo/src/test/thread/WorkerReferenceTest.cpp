@@ -0,0 +1,102 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/Worker.h>
+#include <thread/WorkerReference.h>
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+using erizo::Worker;
+using erizo::WorkerReference;
+
+class WorkerReferenceTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    old_worker = std::make_shared<Worker>();
+    new_worker = std::make_shared<Worker>();
+    old_worker->start();
+    new_worker->start();
+    reference = std::make_shared<WorkerReference>(old_worker);
+  }
+
+  virtual void TearDown() {
+    old_worker->close();
+    new_worker->close();
+  }
+
+  // Keeps worker busy until the returned promise is set
+  std::shared_ptr<std::promise<void>> blockWorker(std::shared_ptr<Worker> worker) {
+    auto unblock = std::make_shared<std::promise<void>>();
+    std::shared_future<void> unblocked = unblock->get_future().share();
+    worker->task([unblocked] {
+      unblocked.wait();
+    });
+    return unblock;
+  }
+
+  bool runsTasks(std::shared_ptr<Worker> worker) {
+    auto done = std::make_shared<std::promise<void>>();
+    worker->task([done] {
+      done->set_value();
+    });
+    return done->get_future().wait_for(std::chrono::seconds(1)) == std::future_status::ready;
+  }
+
+  void addToOrder(int value) {
+    std::lock_guard<std::mutex> lock(order_mutex);
+    order.push_back(value);
+  }
+
+  std::shared_ptr<Worker> old_worker;
+  std::shared_ptr<Worker> new_worker;
+  std::shared_ptr<WorkerReference> reference;
+  std::mutex order_mutex;
+  std::vector<int> order;
+};
+
+TEST_F(WorkerReferenceTest, shouldHoldTasksUntilTheOldWorkerRunsItsQueuedOnes) {
+  auto unblock = blockWorker(old_worker);
+  reference->task([this] { addToOrder(1); });
+  reference->moveTo(new_worker);
+  auto done = std::make_shared<std::promise<void>>();
+  reference->task([this, done] {
+    addToOrder(2);
+    done->set_value();
+  });
+
+  // The new worker keeps running its other tasks meanwhile
+  EXPECT_TRUE(runsTasks(new_worker));
+  EXPECT_THAT(reference->get(), Eq(new_worker));
+
+  unblock->set_value();
+  ASSERT_THAT(done->get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+  std::lock_guard<std::mutex> lock(order_mutex);
+  EXPECT_THAT(order, ElementsAre(1, 2));
+}
+
+TEST_F(WorkerReferenceTest, shouldNotBlockWhenMovingInOppositeDirections) {
+  auto other_reference = std::make_shared<WorkerReference>(new_worker);
+  auto unblock_old = blockWorker(old_worker);
+  auto unblock_new = blockWorker(new_worker);
+  reference->moveTo(new_worker);
+  other_reference->moveTo(old_worker);
+  unblock_old->set_value();
+  unblock_new->set_value();
+
+  auto done = std::make_shared<std::promise<void>>();
+  reference->task([other_reference, done] {
+    other_reference->task([done] {
+      done->set_value();
+    });
+  });
+
+  EXPECT_THAT(done->get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+  EXPECT_TRUE(runsTasks(old_worker));
+  EXPECT_TRUE(runsTasks(new_worker));
+}
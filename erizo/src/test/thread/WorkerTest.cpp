@@ -0,0 +1,203 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/MpscQueue.h>
+#include <thread/Worker.h>
+
+#include <atomic>
+#include <future>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+using testing::Eq;
+using testing::Ge;
+using erizo::MpscQueue;
+using erizo::ScheduledTaskReference;
+using erizo::SimulatedClock;
+using erizo::SimulatedWorker;
+using erizo::Worker;
+using erizo::WorkerStats;
+
+struct TestNode {
+  std::atomic<TestNode*> next;
+  int value = 0;
+};
+
+TEST(MpscQueueTest, shouldPopNodesInOrder) {
+  MpscQueue<TestNode> queue;
+  TestNode nodes[3];
+  for (int i = 0; i < 3; i++) {
+    nodes[i].value = i;
+    queue.push(&nodes[i]);
+  }
+
+  for (int i = 0; i < 3; i++) {
+    TestNode *node = queue.pop();
+    ASSERT_THAT(node, testing::NotNull());
+    EXPECT_THAT(node->value, Eq(i));
+  }
+  EXPECT_THAT(queue.pop(), testing::IsNull());
+}
+
+TEST(MpscQueueTest, shouldReceiveNodesFromSeveralProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kNodesPerProducer = 1000;
+  MpscQueue<TestNode> queue;
+  std::vector<TestNode> nodes(kProducers * kNodesPerProducer);
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < kProducers; producer++) {
+    producers.emplace_back([&queue, &nodes, producer] {
+      for (int i = 0; i < kNodesPerProducer; i++) {
+        queue.push(&nodes[producer * kNodesPerProducer + i]);
+      }
+    });
+  }
+
+  int received = 0;
+  while (received < kProducers * kNodesPerProducer) {
+    if (queue.pop() != nullptr) {
+      received++;
+    }
+  }
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_THAT(received, Eq(kProducers * kNodesPerProducer));
+}
+
+class WorkerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    worker = std::make_shared<Worker>();
+    worker->start();
+  }
+
+  virtual void TearDown() {
+    worker->close();
+  }
+
+  void waitForTasks() {
+    auto done = std::make_shared<std::promise<void>>();
+    worker->task([done] { done->set_value(); });
+    done->get_future().wait();
+  }
+
+  std::shared_ptr<Worker> worker;
+};
+
+TEST_F(WorkerTest, shouldRunTasksInOrder) {
+  std::vector<int> executed;
+  for (int i = 0; i < 100; i++) {
+    worker->task([&executed, i] { executed.push_back(i); });
+  }
+  waitForTasks();
+
+  ASSERT_THAT(executed.size(), Eq(100u));
+  for (int i = 0; i < 100; i++) {
+    EXPECT_THAT(executed[i], Eq(i));
+  }
+}
+
+TEST_F(WorkerTest, shouldRunTasksQueuedFromTheWorkerItself) {
+  auto done = std::make_shared<std::promise<void>>();
+  std::shared_ptr<Worker> the_worker = worker;
+  worker->task([the_worker, done] {
+    the_worker->task([done] { done->set_value(); });
+  });
+
+  EXPECT_THAT(done->get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+}
+
+TEST_F(WorkerTest, shouldRunTasksFromSeveralThreads) {
+  constexpr int kThreads = 4;
+  constexpr int kTasksPerThread = 500;
+  std::atomic<int> counter{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([this, &counter] {
+      for (int j = 0; j < kTasksPerThread; j++) {
+        worker->task([&counter] { counter++; });
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  waitForTasks();
+
+  EXPECT_THAT(counter.load(), Eq(kThreads * kTasksPerThread));
+}
+
+TEST_F(WorkerTest, taskBatch_ShouldRunEveryItemInASingleTask) {
+  std::vector<int> executed;
+  worker->taskBatch<int>({1, 2, 3}, [&executed](int &item) { executed.push_back(item); });
+  waitForTasks();
+
+  EXPECT_THAT(executed, Eq(std::vector<int>{1, 2, 3}));
+  EXPECT_THAT(worker->getStats().executed_tasks, Eq(2u));
+}
+
+TEST_F(WorkerTest, getStats_ShouldCountExecutedAndQueuedTasks) {
+  auto blocker = std::make_shared<std::promise<void>>();
+  std::shared_future<void> unblocked = blocker->get_future().share();
+  worker->task([unblocked] { unblocked.wait(); });
+  worker->task([] {});
+  worker->task([] {});
+
+  WorkerStats stats = worker->getStats();
+  EXPECT_THAT(stats.max_queue_depth, Ge(2u));
+
+  blocker->set_value();
+  waitForTasks();
+
+  stats = worker->getStats();
+  EXPECT_THAT(stats.executed_tasks, Eq(4u));
+  EXPECT_THAT(stats.max_queue_depth, Ge(3u));
+}
+
+TEST_F(WorkerTest, scheduleFromNow_ShouldRunTasksInTheWorker) {
+  auto done = std::make_shared<std::promise<std::thread::id>>();
+  worker->scheduleFromNow([done] { done->set_value(std::this_thread::get_id()); }, std::chrono::milliseconds(5));
+
+  std::future<std::thread::id> future = done->get_future();
+  ASSERT_THAT(future.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+  EXPECT_THAT(future.get(), testing::Ne(std::this_thread::get_id()));
+  waitForTasks();
+  EXPECT_THAT(worker->getStats().fired_timers, Eq(1u));
+}
+
+TEST_F(WorkerTest, unschedule_ShouldReleaseTheTask) {
+  auto resource = std::make_shared<int>(0);
+  std::shared_ptr<ScheduledTaskReference> id = worker->scheduleFromNow([resource] {}, std::chrono::seconds(10));
+  waitForTasks();
+
+  worker->unschedule(id);
+  waitForTasks();
+
+  EXPECT_THAT(resource.use_count(), Eq(1));
+  EXPECT_THAT(worker->getStats().pending_timers, Eq(0u));
+}
+
+TEST_F(WorkerTest, close_ShouldNotWaitForPendingTimers) {
+  worker->scheduleFromNow([] {}, std::chrono::hours(1));
+  waitForTasks();
+
+  auto closed = std::async(std::launch::async, [this] { worker->close(); });
+
+  EXPECT_THAT(closed.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+}
+
+TEST(SimulatedWorkerTest, shouldRunScheduledTasksWithTheSameDeadline) {
+  auto clock = std::make_shared<SimulatedClock>();
+  auto worker = std::make_shared<SimulatedWorker>(clock);
+  int executed = 0;
+  worker->scheduleFromNow([&executed] { executed++; }, std::chrono::milliseconds(10));
+  worker->scheduleFromNow([&executed] { executed++; }, std::chrono::milliseconds(10));
+  clock->advanceTime(std::chrono::milliseconds(10));
+
+  worker->executePastScheduledTasks();
+
+  EXPECT_THAT(executed, Eq(2));
+}
@@ -22,6 +22,12 @@ MATCHER_P(RtpHasSequenceNumberFromBuffer, seq_num, "") {
 MATCHER_P(RtpHasSequenceNumber, seq_num, "") {
   return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getSeqNumber() == seq_num;
 }
+MATCHER_P(RtpPacketHasSsrc, ssrc, "") {
+  return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getSSRC() == ssrc;
+}
+MATCHER(PacketIsPadding, "") {
+  return std::get<0>(arg)->is_padding;
+}
 MATCHER_P(NackHasSequenceNumber, seq_num, "") {
   return (reinterpret_cast<erizo::RtcpHeader*>(std::get<0>(arg)->data))->getNackPid() == seq_num;
 }
@@ -77,7 +77,7 @@ class MockTransport: public Transport {
   }
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override {
   }
-  void write(char* data, int len) override {
+  void write(std::shared_ptr<DataPacket> packet) override {
   }
   void processLocalSdp(SdpInfo *localSdp_) override {
   }
@@ -70,6 +70,8 @@ NAN_MODULE_INIT(ConnectionDescription::Init) {
   Nan::SetPrototypeMethod(tpl, "getAudioSsrcMap", getAudioSsrcMap);
   Nan::SetPrototypeMethod(tpl, "setVideoSsrcList", setVideoSsrcList);
   Nan::SetPrototypeMethod(tpl, "getVideoSsrcMap", getVideoSsrcMap);
+  Nan::SetPrototypeMethod(tpl, "setVideoRtxSsrcMap", setVideoRtxSsrcMap);
+  Nan::SetPrototypeMethod(tpl, "getVideoRtxSsrcMap", getVideoRtxSsrcMap);
 
   Nan::SetPrototypeMethod(tpl, "setVideoDirection", setVideoDirection);
   Nan::SetPrototypeMethod(tpl, "setAudioDirection", setAudioDirection);
@@ -327,6 +329,35 @@ NAN_METHOD(ConnectionDescription::getVideoSsrcMap) {
   info.GetReturnValue().Set(video_ssrc_map);
 }
 
+NAN_METHOD(ConnectionDescription::setVideoRtxSsrcMap) {
+  GET_SDP();
+  std::string stream_id = getString(info[0]);
+  Local<v8::Object> rtx_ssrc_object = Nan::To<v8::Object>(info[1]).ToLocalChecked();
+  Local<v8::Array> media_ssrcs = Nan::GetOwnPropertyNames(rtx_ssrc_object).ToLocalChecked();
+  std::map<uint32_t, uint32_t> rtx_ssrc_map;
+
+  for (unsigned int i = 0; i < media_ssrcs->Length(); i++) {
+    Local<v8::Value> media_ssrc = Nan::Get(media_ssrcs, i).ToLocalChecked();
+    Local<v8::Value> rtx_ssrc = Nan::Get(rtx_ssrc_object, media_ssrc).ToLocalChecked();
+    rtx_ssrc_map[media_ssrc->Uint32Value()] = rtx_ssrc->Uint32Value();
+  }
+
+  sdp->video_rtx_ssrc_map[stream_id] = rtx_ssrc_map;
+}
+
+NAN_METHOD(ConnectionDescription::getVideoRtxSsrcMap) {
+  GET_SDP();
+  Local<v8::Object> video_rtx_ssrc_map = Nan::New<v8::Object>();
+  for (auto const& rtx_ssrcs : sdp->video_rtx_ssrc_map) {
+    Local<v8::Object> rtx_ssrc_object = Nan::New<v8::Object>();
+    for (auto const& rtx_ssrc : rtx_ssrcs.second) {
+      Nan::Set(rtx_ssrc_object, Nan::New(rtx_ssrc.first), Nan::New(rtx_ssrc.second));
+    }
+    video_rtx_ssrc_map->Set(Nan::New(rtx_ssrcs.first.c_str()).ToLocalChecked(), rtx_ssrc_object);
+  }
+  info.GetReturnValue().Set(video_rtx_ssrc_map);
+}
+
 NAN_METHOD(ConnectionDescription::setVideoDirection) {
   GET_SDP();
   std::string direction = getString(info[0]);
@@ -2,6 +2,9 @@
 #define BUILDING_NODE_EXTENSION
 #endif
 #include <node.h>
+#include <algorithm>
+#include <future>  // NOLINT
+#include <string>
 #include "lib/json.hpp"
 #include "ExternalOutput.h"
 #include "ThreadPool.h"
@@ -41,6 +44,32 @@ class AsyncCloser : public Nan::AsyncWorker {
     std::shared_ptr<erizo::ExternalOutput> external_output_;
 };
 
+class AsyncStatsGetter : public Nan::AsyncWorker {
+ public:
+    AsyncStatsGetter(std::shared_ptr<erizo::ExternalOutput> external_output, Nan::Callback *callback):
+      AsyncWorker(callback), external_output_(external_output) {
+      }
+    ~AsyncStatsGetter() {}
+    void Execute() {
+      std::promise<std::string> stats_promise;
+      std::future<std::string> stats_future = stats_promise.get_future();
+      external_output_->getJSONStats([&stats_promise] (std::string stats) {
+        stats_promise.set_value(stats);
+      });
+      stats_ = stats_future.get();
+    }
+    void HandleOKCallback() {
+      Nan::HandleScope scope;
+      Local<Value> argv[] = {
+        Nan::New(stats_.c_str()).ToLocalChecked()
+      };
+      callback->Call(1, argv);
+    }
+ private:
+    std::shared_ptr<erizo::ExternalOutput> external_output_;
+    std::string stats_;
+};
+
 ExternalOutput::ExternalOutput() {}
 ExternalOutput::~ExternalOutput() {}
 
@@ -52,6 +81,7 @@ NAN_MODULE_INIT(ExternalOutput::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "init", init);
+  Nan::SetPrototypeMethod(tpl, "getStats", getStats);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("ExternalOutput").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -132,6 +162,21 @@ NAN_METHOD(ExternalOutput::New) {
   ExternalOutput* obj = new ExternalOutput();
   obj->me = std::make_shared<erizo::ExternalOutput>(worker, url, rtp_mappings, ext_mappings);
 
+  if (info.Length() > 3 && info[3]->IsString()) {
+    v8::String::Utf8Value segmentation_param(Nan::To<v8::String>(info[3]).ToLocalChecked());
+    json segmentation_config = json::parse(std::string(*segmentation_param));
+    erizo::RecordingSegmentation segmentation;
+    if (segmentation_config["segmentDuration"].is_number()) {
+      int segment_duration = segmentation_config["segmentDuration"];
+      segmentation.max_duration = std::chrono::seconds(std::max(segment_duration, 0));
+    }
+    if (segmentation_config["segmentMaxBytes"].is_number()) {
+      double segment_max_bytes = segmentation_config["segmentMaxBytes"];
+      segmentation.max_bytes = static_cast<uint64_t>(std::max(segment_max_bytes, 0.));
+    }
+    obj->me->setSegmentation(segmentation);
+  }
+
   obj->Wrap(info.This());
   info.GetReturnValue().Set(info.This());
 }
@@ -157,3 +202,12 @@ NAN_METHOD(ExternalOutput::init) {
   int r = me->init();
   info.GetReturnValue().Set(Nan::New(r));
 }
+
+NAN_METHOD(ExternalOutput::getStats) {
+  ExternalOutput* obj = ObjectWrap::Unwrap<ExternalOutput>(info.Holder());
+  if (!obj->me || info.Length() != 1) {
+    return;
+  }
+  Nan::Callback *callback = new Nan::Callback(info[0].As<Function>());
+  Nan::AsyncQueueWorker(new AsyncStatsGetter(obj->me, callback));
+}
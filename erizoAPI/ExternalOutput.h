@@ -37,6 +37,11 @@ class ExternalOutput: public MediaSink {
      * Returns true ready
      */
     static NAN_METHOD(init);
+    /*
+     * Gets the recording stats as a JSON string
+     * Param: a callback with the stats
+     */
+    static NAN_METHOD(getStats);
 
     static Nan::Persistent<v8::Function> constructor;
 };
@@ -28,6 +28,8 @@ NAN_MODULE_INIT(IOThreadPool::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "start", start);
+  Nan::SetPrototypeMethod(tpl, "getPacketBufferPoolStats", getPacketBufferPoolStats);
+  Nan::SetPrototypeMethod(tpl, "getWorkerLoads", getWorkerLoads);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("IOThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -58,3 +60,41 @@ NAN_METHOD(IOThreadPool::start) {
 
   obj->me->start();
 }
+
+NAN_METHOD(IOThreadPool::getPacketBufferPoolStats) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  std::vector<erizo::PacketBufferPoolStats> pool_stats = obj->me->getPacketBufferPoolStats();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(pool_stats.size());
+  uint32_t index = 0;
+  for (const erizo::PacketBufferPoolStats &stats : pool_stats) {
+    v8::Local<v8::Object> worker_stats = Nan::New<v8::Object>();
+    Nan::Set(worker_stats, Nan::New("allocations").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.allocations)));
+    Nan::Set(worker_stats, Nan::New("poolHits").ToLocalChecked(), Nan::New(static_cast<double>(stats.pool_hits)));
+    Nan::Set(worker_stats, Nan::New("heapAllocations").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.heap_allocations)));
+    Nan::Set(worker_stats, Nan::New("inUse").ToLocalChecked(), Nan::New(static_cast<double>(stats.in_use)));
+    Nan::Set(worker_stats, Nan::New("cached").ToLocalChecked(), Nan::New(static_cast<double>(stats.cached)));
+    Nan::Set(worker_stats, Nan::New("hitRate").ToLocalChecked(), Nan::New(stats.getHitRate()));
+    Nan::Set(array, index++, worker_stats);
+  }
+  info.GetReturnValue().Set(array);
+}
+
+NAN_METHOD(IOThreadPool::getWorkerLoads) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  std::vector<erizo::WorkerLoad> loads = obj->me->getWorkerLoads();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(loads.size());
+  uint32_t index = 0;
+  for (const erizo::WorkerLoad &load : loads) {
+    v8::Local<v8::Object> worker_load = Nan::New<v8::Object>();
+    Nan::Set(worker_load, Nan::New("tasksPerSecond").ToLocalChecked(), Nan::New(load.tasks_per_second));
+    Nan::Set(worker_load, Nan::New("packetsPerSecond").ToLocalChecked(), Nan::New(load.packets_per_second));
+    Nan::Set(worker_load, Nan::New("busyFraction").ToLocalChecked(), Nan::New(load.busy_fraction));
+    Nan::Set(worker_load, Nan::New("queueDepth").ToLocalChecked(), Nan::New(static_cast<double>(load.queue_depth)));
+    Nan::Set(array, index++, worker_load);
+  }
+  info.GetReturnValue().Set(array);
+}
@@ -34,6 +34,14 @@ class IOThreadPool : public Nan::ObjectWrap {
      * Starts all workers in the IOThreadPool
      */
     static NAN_METHOD(start);
+    /*
+     * Returns packet buffer pool counters for every worker in the pool
+     */
+    static NAN_METHOD(getPacketBufferPoolStats);
+    /*
+     * Returns tasks and packets per second, busy time fraction and queue depth for every worker in the pool
+     */
+    static NAN_METHOD(getWorkerLoads);
 
     static Nan::Persistent<v8::Function> constructor;
 };
@@ -152,6 +152,7 @@ NAN_METHOD(MediaStream::New) {
 
     MediaStream* obj = new MediaStream();
     obj->me = std::make_shared<erizo::MediaStream>(worker, wrtc, wrtc_id, stream_label, is_publisher);
+    thread_pool->stats_batcher->addStream(obj->me);
     obj->msink = obj->me.get();
     obj->id_ = wrtc_id;
     obj->label_ = stream_label;
@@ -2,12 +2,17 @@
 #define BUILDING_NODE_EXTENSION
 #endif
 
+#include <string>
+#include <vector>
+
+#include "lib/json.hpp"
 #include "OneToManyTranscoder.h"
 
 using v8::Local;
 using v8::Value;
 using v8::Function;
 using v8::HandleScope;
+using json = nlohmann::json;
 
 Nan::Persistent<Function> OneToManyTranscoder::constructor;
 
@@ -81,7 +86,24 @@ NAN_MODULE_INIT(OneToManyTranscoder::Init) {
 
 NAN_METHOD(OneToManyTranscoder::New) {
   OneToManyTranscoder* obj = new OneToManyTranscoder();
-  obj->me = new erizo::OneToManyTranscoder();
+  std::vector<erizo::TranscodingRendition> renditions = erizo::TranscodingLadder::getDefaultRenditions();
+  // Optional ladder, [{id, height, bitrate, frameRate}]
+  if (info.Length() > 0 && info[0]->IsString()) {
+    v8::String::Utf8Value ladder_param(Nan::To<v8::String>(info[0]).ToLocalChecked());
+    json ladder_config = json::parse(std::string(*ladder_param));
+    if (ladder_config.is_array() && !ladder_config.empty()) {
+      renditions.clear();
+      for (const json& rendition_config : ladder_config) {
+        erizo::TranscodingRendition rendition;
+        rendition.id = rendition_config.value("id", std::string());
+        rendition.height = rendition_config.value("height", 360);
+        rendition.bitrate = rendition_config.value("bitrate", 600000u);
+        rendition.frame_rate = rendition_config.value("frameRate", 30);
+        renditions.push_back(rendition);
+      }
+    }
+  }
+  obj->me = new erizo::OneToManyTranscoder(renditions);
   obj->msink = obj->me;
 
   obj->Wrap(info.This());
@@ -13,10 +13,33 @@ using v8::Exception;
 
 Nan::Persistent<Function> ThreadPool::constructor;
 
-ThreadPool::ThreadPool() {
+static void destroyStatsHandle(uv_handle_t *handle) {
+  delete handle;
+}
+
+ThreadPool::ThreadPool() : stats_batcher{std::make_shared<erizo::StatsBatcher>()}, stats_timer_{nullptr},
+    stats_callback_{nullptr} {
 }
 
 ThreadPool::~ThreadPool() {
+  stopPeriodicStats();
+}
+
+void ThreadPool::stopPeriodicStats() {
+  if (stats_timer_) {
+    uv_timer_stop(stats_timer_);
+    uv_close(reinterpret_cast<uv_handle_t*>(stats_timer_), destroyStatsHandle);
+    stats_timer_ = nullptr;
+  }
+  if (stats_export_) {
+    boost::mutex::scoped_lock lock(stats_export_->mutex);
+    stats_export_->closed = true;
+    uv_close(reinterpret_cast<uv_handle_t*>(stats_export_->async), destroyStatsHandle);
+    stats_export_->async = nullptr;
+  }
+  stats_export_.reset();
+  delete stats_callback_;
+  stats_callback_ = nullptr;
 }
 
 NAN_MODULE_INIT(ThreadPool::Init) {
@@ -28,6 +51,10 @@ NAN_MODULE_INIT(ThreadPool::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "start", start);
+  Nan::SetPrototypeMethod(tpl, "getPacketBufferPoolStats", getPacketBufferPoolStats);
+  Nan::SetPrototypeMethod(tpl, "getWorkerLoads", getWorkerLoads);
+  Nan::SetPrototypeMethod(tpl, "getWorkerStats", getWorkerStats);
+  Nan::SetPrototypeMethod(tpl, "getPeriodicStats", getPeriodicStats);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("ThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -50,6 +77,7 @@ NAN_METHOD(ThreadPool::New) {
 NAN_METHOD(ThreadPool::close) {
   ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
 
+  obj->stopPeriodicStats();
   obj->me->close();
 }
 
@@ -58,3 +86,129 @@ NAN_METHOD(ThreadPool::start) {
 
   obj->me->start();
 }
+
+NAN_METHOD(ThreadPool::getPacketBufferPoolStats) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+
+  std::vector<erizo::PacketBufferPoolStats> pool_stats = obj->me->getPacketBufferPoolStats();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(pool_stats.size());
+  uint32_t index = 0;
+  for (const erizo::PacketBufferPoolStats &stats : pool_stats) {
+    v8::Local<v8::Object> worker_stats = Nan::New<v8::Object>();
+    Nan::Set(worker_stats, Nan::New("allocations").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.allocations)));
+    Nan::Set(worker_stats, Nan::New("poolHits").ToLocalChecked(), Nan::New(static_cast<double>(stats.pool_hits)));
+    Nan::Set(worker_stats, Nan::New("heapAllocations").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.heap_allocations)));
+    Nan::Set(worker_stats, Nan::New("inUse").ToLocalChecked(), Nan::New(static_cast<double>(stats.in_use)));
+    Nan::Set(worker_stats, Nan::New("cached").ToLocalChecked(), Nan::New(static_cast<double>(stats.cached)));
+    Nan::Set(worker_stats, Nan::New("hitRate").ToLocalChecked(), Nan::New(stats.getHitRate()));
+    Nan::Set(array, index++, worker_stats);
+  }
+  info.GetReturnValue().Set(array);
+}
+
+NAN_METHOD(ThreadPool::getWorkerStats) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+
+  std::vector<erizo::WorkerStats> all_stats = obj->me->getWorkerStats();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(all_stats.size());
+  uint32_t index = 0;
+  for (const erizo::WorkerStats &stats : all_stats) {
+    v8::Local<v8::Object> worker_stats = Nan::New<v8::Object>();
+    Nan::Set(worker_stats, Nan::New("queueDepth").ToLocalChecked(), Nan::New(static_cast<double>(stats.queue_depth)));
+    Nan::Set(worker_stats, Nan::New("maxQueueDepth").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.max_queue_depth)));
+    Nan::Set(worker_stats, Nan::New("executedTasks").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.executed_tasks)));
+    Nan::Set(worker_stats, Nan::New("maxTaskLatencyUs").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.max_task_latency_us)));
+    Nan::Set(worker_stats, Nan::New("averageTaskLatencyUs").ToLocalChecked(),
+             Nan::New(stats.getAverageTaskLatencyUs()));
+    Nan::Set(worker_stats, Nan::New("pendingTimers").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.pending_timers)));
+    Nan::Set(worker_stats, Nan::New("firedTimers").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.fired_timers)));
+    Nan::Set(worker_stats, Nan::New("maxTimerLatenessUs").ToLocalChecked(),
+             Nan::New(static_cast<double>(stats.max_timer_lateness_us)));
+    Nan::Set(worker_stats, Nan::New("averageTimerLatenessUs").ToLocalChecked(),
+             Nan::New(stats.getAverageTimerLatenessUs()));
+    Nan::Set(array, index++, worker_stats);
+  }
+  info.GetReturnValue().Set(array);
+}
+
+NAN_METHOD(ThreadPool::getWorkerLoads) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+
+  std::vector<erizo::WorkerLoad> loads = obj->me->getWorkerLoads();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(loads.size());
+  uint32_t index = 0;
+  for (const erizo::WorkerLoad &load : loads) {
+    v8::Local<v8::Object> worker_load = Nan::New<v8::Object>();
+    Nan::Set(worker_load, Nan::New("tasksPerSecond").ToLocalChecked(), Nan::New(load.tasks_per_second));
+    Nan::Set(worker_load, Nan::New("packetsPerSecond").ToLocalChecked(), Nan::New(load.packets_per_second));
+    Nan::Set(worker_load, Nan::New("busyFraction").ToLocalChecked(), Nan::New(load.busy_fraction));
+    Nan::Set(worker_load, Nan::New("queueDepth").ToLocalChecked(), Nan::New(static_cast<double>(load.queue_depth)));
+    Nan::Set(array, index++, worker_load);
+  }
+  info.GetReturnValue().Set(array);
+}
+
+NAN_METHOD(ThreadPool::getPeriodicStats) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+  if (info.Length() != 2) {
+    return;
+  }
+  uint64_t interval_ms = info[0]->IntegerValue();
+  obj->stopPeriodicStats();
+
+  obj->stats_callback_ = new Nan::Callback(info[1].As<Function>());
+  obj->stats_export_ = std::make_shared<StatsExport>();
+  obj->stats_export_->async = new uv_async_t;
+  uv_async_init(uv_default_loop(), obj->stats_export_->async, &ThreadPool::statsCallback);
+  obj->stats_export_->async->data = obj;
+
+  obj->stats_timer_ = new uv_timer_t;
+  uv_timer_init(uv_default_loop(), obj->stats_timer_);
+  obj->stats_timer_->data = obj;
+  uv_timer_start(obj->stats_timer_, &ThreadPool::onStatsTimer, interval_ms, interval_ms);
+}
+
+void ThreadPool::onStatsTimer(uv_timer_t *timer) {
+  ThreadPool* obj = reinterpret_cast<ThreadPool*>(timer->data);
+  std::weak_ptr<StatsExport> weak_export = obj->stats_export_;
+  obj->stats_batcher->collect(obj->stats_export_->consumer, [weak_export] (std::vector<erizo::StatsDelta> deltas) {
+    auto stats_export = weak_export.lock();
+    if (!stats_export || deltas.empty()) {
+      return;
+    }
+    std::string buffer;
+    erizo::StatsBatcher::serialize(deltas, &buffer);
+    boost::mutex::scoped_lock lock(stats_export->mutex);
+    if (stats_export->closed) {
+      return;
+    }
+    stats_export->batches.push(std::move(buffer));
+    uv_async_send(stats_export->async);
+  });
+}
+
+NAUV_WORK_CB(ThreadPool::statsCallback) {
+  Nan::HandleScope scope;
+  ThreadPool* obj = reinterpret_cast<ThreadPool*>(async->data);
+  if (!obj || !obj->stats_export_ || !obj->stats_callback_) {
+    return;
+  }
+  std::queue<std::string> batches;
+  {
+    boost::mutex::scoped_lock lock(obj->stats_export_->mutex);
+    std::swap(batches, obj->stats_export_->batches);
+  }
+  while (!batches.empty() && obj->stats_callback_) {
+    const std::string &batch = batches.front();
+    Local<Value> args[] = {Nan::CopyBuffer(batch.data(), batch.size()).ToLocalChecked()};
+    Nan::MakeCallback(Nan::GetCurrentContext()->Global(), obj->stats_callback_->GetFunction(), 1, args);
+    batches.pop();
+  }
+}
@@ -3,6 +3,21 @@
 
 #include <nan.h>
 #include <thread/ThreadPool.h>
+#include <stats/StatsBatcher.h>
+#include <boost/thread/mutex.hpp>
+
+#include <memory>
+#include <queue>
+#include <string>
+
+// Shared with the workers that complete a stats batch, it outlives the ThreadPool if a batch is in flight
+struct StatsExport {
+  std::shared_ptr<erizo::StatsConsumer> consumer = std::make_shared<erizo::StatsConsumer>();
+  boost::mutex mutex;
+  bool closed = false;
+  uv_async_t *async = nullptr;
+  std::queue<std::string> batches;
+};
 
 
 /*
@@ -15,6 +30,7 @@ class ThreadPool : public Nan::ObjectWrap {
  public:
     static NAN_MODULE_INIT(Init);
     std::unique_ptr<erizo::ThreadPool> me;
+    std::shared_ptr<erizo::StatsBatcher> stats_batcher;
 
  private:
     ThreadPool();
@@ -34,6 +50,32 @@ class ThreadPool : public Nan::ObjectWrap {
      * Starts all workers in the ThreadPool
      */
     static NAN_METHOD(start);
+    /*
+     * Returns packet buffer pool counters for every worker in the pool
+     */
+    static NAN_METHOD(getPacketBufferPoolStats);
+    /*
+     * Returns tasks and packets per second, busy time fraction and queue depth for every worker in the pool
+     */
+    static NAN_METHOD(getWorkerLoads);
+    /*
+     * Returns task queue depth and latency counters for every worker in the pool
+     */
+    static NAN_METHOD(getWorkerStats);
+    /*
+     * Calls back every interval with a Buffer holding the stats that changed in all the streams of the pool
+     * Param: interval in milliseconds
+     * Param: callback
+     */
+    static NAN_METHOD(getPeriodicStats);
+
+    void stopPeriodicStats();
+    static void onStatsTimer(uv_timer_t *timer);
+    static NAUV_WORK_CB(statsCallback);
+
+    uv_timer_t *stats_timer_;
+    std::shared_ptr<StatsExport> stats_export_;
+    Nan::Callback *stats_callback_;
 
     static Nan::Persistent<v8::Function> constructor;
 };
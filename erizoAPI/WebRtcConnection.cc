@@ -43,6 +43,22 @@ class MediaStreamAdder : public AsyncPromiseWorker {
     std::shared_ptr<erizo::MediaStream> stream_;
 };
 
+class WorkerMigrator : public AsyncPromiseWorker {
+ public:
+    WorkerMigrator(Nan::Persistent<v8::Promise::Resolver> *persistent,
+      std::shared_ptr<erizo::WebRtcConnection> wr,
+      std::shared_ptr<erizo::Worker> worker) :
+        AsyncPromiseWorker(persistent), connection_(wr), worker_(worker) {
+    }
+    ~WorkerMigrator() {}
+    void Execute() {
+      connection_->migrateTo(worker_)->get_future().wait();
+    }
+ private:
+    std::shared_ptr<erizo::WebRtcConnection> connection_;
+    std::shared_ptr<erizo::Worker> worker_;
+};
+
 class MediaStreamDeleter : public AsyncPromiseWorker {
  public:
     MediaStreamDeleter(Nan::Persistent<v8::Promise::Resolver> *persistent,
@@ -143,6 +159,7 @@ NAN_MODULE_INIT(WebRtcConnection::Init) {
   Nan::SetPrototypeMethod(tpl, "addMediaStream", addMediaStream);
   Nan::SetPrototypeMethod(tpl, "removeMediaStream", removeMediaStream);
   Nan::SetPrototypeMethod(tpl, "copySdpToLocalDescription", copySdpToLocalDescription);
+  Nan::SetPrototypeMethod(tpl, "migrateToLessUsedWorker", migrateToLessUsedWorker);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("WebRtcConnection").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -490,6 +507,25 @@ NAN_METHOD(WebRtcConnection::addMediaStream) {
   info.GetReturnValue().Set(resolver->GetPromise());
 }
 
+NAN_METHOD(WebRtcConnection::migrateToLessUsedWorker) {
+  WebRtcConnection* obj = Nan::ObjectWrap::Unwrap<WebRtcConnection>(info.Holder());
+  std::shared_ptr<erizo::WebRtcConnection> me = obj->me;
+  if (!me) {
+    return;
+  }
+
+  ThreadPool* thread_pool = Nan::ObjectWrap::Unwrap<ThreadPool>(Nan::To<v8::Object>(info[0]).ToLocalChecked());
+  std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedWorker();
+
+  v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(info.GetIsolate());
+  Nan::Persistent<v8::Promise::Resolver> *persistent = new Nan::Persistent<v8::Promise::Resolver>(resolver);
+
+  WorkerMigrator *migrator = new WorkerMigrator(persistent, me, worker);
+  Nan::AsyncQueueWorker(migrator);
+
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
 NAN_METHOD(WebRtcConnection::removeMediaStream) {
   WebRtcConnection* obj = Nan::ObjectWrap::Unwrap<WebRtcConnection>(info.Holder());
   std::shared_ptr<erizo::WebRtcConnection> me = obj->me;
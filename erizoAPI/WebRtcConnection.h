@@ -106,6 +106,11 @@ class WebRtcConnection : public erizo::WebRtcConnectionEventListener,
     static NAN_METHOD(removeMediaStream);
 
     static NAN_METHOD(copySdpToLocalDescription);
+    /*
+     * Moves the connection and its streams to the less used worker of the given ThreadPool
+     * Param: the ThreadPool
+     */
+    static NAN_METHOD(migrateToLessUsedWorker);
 
     static Nan::Persistent<v8::Function> constructor;
 
@@ -26,6 +26,8 @@ global.config.erizo.networkinterface = global.config.erizo.networkinterface || '
 global.config.erizo.activeUptimeLimit = global.config.erizo.activeUptimeLimit || 7;
 global.config.erizo.maxTimeSinceLastOperation = global.config.erizo.maxTimeSinceLastOperation || 3;
 global.config.erizo.checkUptimeInterval = global.config.erizo.checkUptimeInterval || 1800;
+global.config.erizo.recordingSegmentDuration = global.config.erizo.recordingSegmentDuration || 0;
+global.config.erizo.recordingSegmentMaxBytes = global.config.erizo.recordingSegmentMaxBytes || 0;
 global.mediaConfig = mediaConfig || {};
 // Parse command line arguments
 const getopt = new Getopt([
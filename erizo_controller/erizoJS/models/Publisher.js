@@ -101,7 +101,11 @@ class Source extends NodeClass {
     const eoId = `${url}_${this.streamId}`;
     log.info(`message: Adding ExternalOutput, id: ${eoId}, url: ${url}`);
     const externalOutput = new addon.ExternalOutput(this.threadPool, url,
-      Helpers.getMediaConfiguration(options.mediaConfiguration));
+      Helpers.getMediaConfiguration(options.mediaConfiguration),
+      JSON.stringify({
+        segmentDuration: global.config.erizo.recordingSegmentDuration,
+        segmentMaxBytes: global.config.erizo.recordingSegmentMaxBytes,
+      }));
     externalOutput.id = eoId;
     externalOutput.init();
     this.muxer.addExternalOutput(externalOutput, url);
@@ -137,6 +141,21 @@ class Source extends NodeClass {
     return this.externalOutputs[url];
   }
 
+  getStats(label, stats) {
+    const promises = [super.getStats(label, stats)];
+    Object.keys(this.externalOutputs).forEach((url) => {
+      const externalOutput = this.externalOutputs[url];
+      promises.push(new Promise((resolve) => {
+        externalOutput.getStats((statsString) => {
+          // eslint-disable-next-line no-param-reassign
+          stats[externalOutput.id] = JSON.parse(statsString);
+          resolve();
+        });
+      }));
+    });
+    return Promise.all(promises);
+  }
+
   disableDefaultHandlers() {
     const disabledHandlers = global.config.erizo.disabledHandlers;
     if (!disabledHandlers || !this.mediaStream) {
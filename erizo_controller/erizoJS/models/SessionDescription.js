@@ -9,6 +9,7 @@ const ICEInfo = require('./../../common/semanticSdp/ICEInfo');
 const DTLSInfo = require('./../../common/semanticSdp/DTLSInfo');
 const CodecInfo = require('./../../common/semanticSdp/CodecInfo');
 const SourceInfo = require('./../../common/semanticSdp/SourceInfo');
+const SourceGroupInfo = require('./../../common/semanticSdp/SourceGroupInfo');
 const StreamInfo = require('./../../common/semanticSdp/StreamInfo');
 const TrackInfo = require('./../../common/semanticSdp/TrackInfo');
 const RIDInfo = require('./../../common/semanticSdp/RIDInfo');
@@ -130,9 +131,17 @@ function getMediaInfoFromDescription(info, sdp, mediaType) {
 
     if (info.getDirection('video') !== 'recvonly') {
       const videoSsrcMap = info.getVideoSsrcMap();
+      const videoRtxSsrcMap = info.getVideoRtxSsrcMap();
       Object.keys(videoSsrcMap).forEach((streamLabel) => {
+        const rtxSsrcs = videoRtxSsrcMap[streamLabel] || {};
         videoSsrcMap[streamLabel].forEach((ssrc) => {
           addSsrc(sources, ssrc, sdp, media, streamLabel);
+          const rtxSsrc = rtxSsrcs[ssrc];
+          if (rtxSsrc) {
+            addSsrc(sources, rtxSsrc, sdp, media, streamLabel);
+            sdp.getStream(streamLabel).getTrack(media.getId())
+              .addSourceGroup(new SourceGroupInfo('FID', [ssrc, rtxSsrc]));
+          }
         });
       });
     }
@@ -234,13 +243,24 @@ class SessionDescription {
     const streamId = stream.getId();
     let videoSsrcList = [];
     let simulcastVideoSsrcList;
+    const videoRtxSsrcMap = {};
 
     stream.getTracks().forEach((track) => {
+      // RTX streams (RFC 4588) are announced as FID groups: [media ssrc, rtx ssrc]
+      track.getSourceGroups().forEach((group) => {
+        if (group.getSemantics().toUpperCase() === 'FID' && group.getSSRCs().length === 2) {
+          videoRtxSsrcMap[group.getSSRCs()[0]] = group.getSSRCs()[1];
+        }
+      });
+      const rtxSsrcs = Object.keys(videoRtxSsrcMap).map((ssrc) => videoRtxSsrcMap[ssrc]);
+
       if (track.getMedia() === 'audio') {
         info.setAudioSsrc(streamId, track.getSSRCs()[0].getSSRC());
       } else if (track.getMedia() === 'video') {
         track.getSSRCs().forEach((ssrc) => {
-          videoSsrcList.push(ssrc.getSSRC());
+          if (rtxSsrcs.indexOf(ssrc.getSSRC()) === -1) {
+            videoSsrcList.push(ssrc.getSSRC());
+          }
         });
       }
 
@@ -254,6 +274,7 @@ class SessionDescription {
 
     videoSsrcList = simulcastVideoSsrcList || videoSsrcList;
     info.setVideoSsrcList(streamId, videoSsrcList);
+    info.setVideoRtxSsrcMap(streamId, videoRtxSsrcMap);
   }
 
   processSdp() {
@@ -324,6 +345,11 @@ class SessionDescription {
           info.addParameter(codec.getType(), option, params[option]);
         });
 
+        if (codec.hasRTX()) {
+          info.addPt(codec.getRTX(), 'rtx', codec.getRate(), media.getType());
+          info.addParameter(codec.getRTX(), 'apt', `${codec.getType()}`);
+        }
+
         codec.getFeedback().forEach((rtcpFb) => {
           const feedback = rtcpFb.subtype ? `${rtcpFb.type} ${rtcpFb.subtype}` : rtcpFb.type;
           info.addFeedback(codec.getType(), feedback);
@@ -193,6 +193,7 @@ module.exports.reset = () => {
   module.exports.ExternalOutput = {
     init: sinon.stub(),
     close: sinon.stub(),
+    getStats: sinon.stub(),
   };
 
   module.exports.erizoAPI = createMock('../../erizoAPI/build/Release/addon', {
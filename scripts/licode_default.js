@@ -191,6 +191,11 @@ config.erizo.useNicer = false;  // default value: false
 
 config.erizo.disabledHandlers = []; // there are no handlers disabled by default
 
+// Recordings are split in files of this length in seconds or size in bytes, each one starting with a keyframe.
+// Finished files are listed in <recording>.index so they can be uploaded while recording. 0 writes a single file
+config.erizo.recordingSegmentDuration = 0; // default value: 0
+config.erizo.recordingSegmentMaxBytes = 0; // default value: 0
+
 config.rov = {};
 // The stats gathering period in ms
 config.rov.statsPeriod = 20000;
@@ -5,7 +5,7 @@ const extMappings = [
   'http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time',
   'urn:ietf:params:rtp-hdrext:toffset',
   'urn:3gpp:video-orientation',
-  // 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
+  'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
   'http://www.webrtc.org/experiments/rtp-hdrext/playout-delay',
   'urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id',
 ];
@@ -21,7 +21,7 @@ const vp8 = {
     'nack',
     'nack pli',
     'goog-remb',
-    // 'transport-cc',
+    'transport-cc',
   ],
 };
 
@@ -36,7 +36,7 @@ const vp9 = {
     'nack',
     'nack pli',
     'goog-remb',
-    // 'transport-cc',
+    'transport-cc',
   ],
 };
 
@@ -56,7 +56,7 @@ const h264 = {
     'nack',
     'nack pli',
     'goog-remb',
-    // 'transport-cc',
+    'transport-cc',
   ],
 };
 
@@ -79,6 +79,17 @@ const rtx = {
   },
 };
 
+const rtxH264 = {
+  payloadType: 97,
+  encodingName: 'rtx',
+  clockRate: 90000,
+  channels: 1,
+  mediaType: 'video',
+  formatParameters: {
+    apt: '101',
+  },
+};
+
 const ulpfec = {
   payloadType: 117,
   encodingName: 'ulpfec',
@@ -168,10 +179,10 @@ const telephoneevent = {
 };
 
 mediaConfig.codecConfigurations = {
-  default: { rtpMappings: { vp8, opus }, extMappings },
-  VP8_AND_OPUS: { rtpMappings: { vp8, opus }, extMappings },
-  VP9_AND_OPUS: { rtpMappings: { vp9, opus }, extMappings },
-  H264_AND_OPUS: { rtpMappings: { h264, opus }, extMappings },
+  default: { rtpMappings: { vp8, rtx, opus }, extMappings },
+  VP8_AND_OPUS: { rtpMappings: { vp8, rtx, opus }, extMappings },
+  VP9_AND_OPUS: { rtpMappings: { vp9, rtx, opus }, extMappings },
+  H264_AND_OPUS: { rtpMappings: { h264, rtxH264, opus }, extMappings },
 };
 
 var module = module || {};